@@ -64,6 +64,21 @@ static std::unordered_map<std::string, OptionTypeInfo>
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
 };
+
+static std::unordered_map<std::string, OptionTypeInfo>
+    file_sec_cache_options_type_info = {
+        {"path",
+         {offsetof(struct FileSecondaryCacheOptions, path), OptionType::kString,
+          OptionVerificationType::kNormal, OptionTypeFlags::kNone}},
+        {"capacity",
+         {offsetof(struct FileSecondaryCacheOptions, capacity),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"segment_size",
+         {offsetof(struct FileSecondaryCacheOptions, segment_size),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+};
 #endif  // ROCKSDB_LITE
 
 Status SecondaryCache::CreateFromString(
@@ -90,6 +105,30 @@ Status SecondaryCache::CreateFromString(
         "Cannot load compressed secondary cache in LITE mode ", args);
 #endif  //! ROCKSDB_LITE
 
+    if (status.ok()) {
+      result->swap(sec_cache);
+    }
+    return status;
+  } else if (value.find("file_secondary_cache://") == 0) {
+    std::string args = value;
+    args.erase(0, std::strlen("file_secondary_cache://"));
+    Status status;
+    std::shared_ptr<SecondaryCache> sec_cache;
+
+#ifndef ROCKSDB_LITE
+    FileSecondaryCacheOptions sec_cache_opts;
+    status = OptionTypeInfo::ParseStruct(config_options, "",
+                                         &file_sec_cache_options_type_info, "",
+                                         args, &sec_cache_opts);
+    if (status.ok()) {
+      status = NewFileSecondaryCache(sec_cache_opts, &sec_cache);
+    }
+#else
+    (void)config_options;
+    status = Status::NotSupported(
+        "Cannot load file secondary cache in LITE mode ", args);
+#endif  //! ROCKSDB_LITE
+
     if (status.ok()) {
       result->swap(sec_cache);
     }
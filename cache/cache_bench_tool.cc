@@ -13,6 +13,9 @@
 #include <set>
 #include <sstream>
 
+#include "cache/cache_entry_roles.h"
+#include "cache/file_secondary_cache.h"
+#include "cache/sharded_cache.h"
 #include "db/db_impl/db_impl.h"
 #include "monitoring/histogram.h"
 #include "port/port.h"
@@ -83,8 +86,30 @@ DEFINE_string(secondary_cache_uri, "",
 static class std::shared_ptr<ROCKSDB_NAMESPACE::SecondaryCache> secondary_cache;
 #endif  // ROCKSDB_LITE
 
+DEFINE_string(file_secondary_cache_path, "",
+              "If not empty, use a FileSecondaryCache in this file as the "
+              "secondary cache of the LRU cache.");
+DEFINE_uint64(file_secondary_cache_size, 4 * GiB,
+              "Capacity of the FileSecondaryCache.");
+DEFINE_uint64(file_secondary_cache_segment_size, 16 * MiB,
+              "Segment size of the FileSecondaryCache.");
+DEFINE_uint32(lookup_batch, 1,
+              "Number of keys looked up together by lookup operations, "
+              "completing secondary cache lookups with a single WaitAll.");
+
 DEFINE_string(cache_type, "lru_cache", "Type of block cache.");
 
+DEFINE_string(admission_policy, "",
+              "Admission policy of the cache for data blocks, empty to admit "
+              "everything, or \"tinylfu\".");
+DEFINE_uint32(scan_percent, 0,
+              "Percentage of lookup+insert operations which are one-shot "
+              "scans instead of point lookups, to simulate a mixed scan + "
+              "point lookup workload. Lookup+insert values are inserted as "
+              "data blocks, subject to -admission_policy.");
+DEFINE_uint32(scan_length, 64,
+              "Number of never repeated keys accessed by each scan operation.");
+
 // ## BEGIN stress_cache_key sub-tool options ##
 // See class StressCacheKey below.
 DEFINE_bool(stress_cache_key, false,
@@ -190,6 +215,11 @@ struct ThreadState {
   SharedState* shared;
   HistogramImpl latency_ns_hist;
   uint64_t duration_us = 0;
+  // Lookups and hits of the lookup+insert operations
+  uint64_t point_lookups = 0;
+  uint64_t point_hits = 0;
+  uint64_t scan_lookups = 0;
+  uint64_t scan_hits = 0;
 
   ThreadState(uint32_t index, SharedState* _shared)
       : tid(index), rnd(1000 + index), shared(_shared) {}
@@ -213,6 +243,10 @@ struct KeyGen {
         key -= max_key;
       }
     }
+    return Get(key);
+  }
+
+  Slice Get(uint64_t key) {
     // Variable size and alignment
     size_t off = key % 8;
     key_data[0] = char{42};
@@ -258,6 +292,10 @@ void deleter3(const Slice& /*key*/, void* value) {
 Cache::CacheItemHelper helper1(SizeFn, SaveToFn, deleter1);
 Cache::CacheItemHelper helper2(SizeFn, SaveToFn, deleter2);
 Cache::CacheItemHelper helper3(SizeFn, SaveToFn, deleter3);
+// For entries subject to the admission policy
+Cache::CacheItemHelper helper_data_block(
+    SizeFn, SaveToFn,
+    GetCacheEntryDeleterForRole<char[], CacheEntryRole::kDataBlock>());
 }  // namespace
 
 class CacheBench {
@@ -276,6 +314,11 @@ class CacheBench {
                           kHundredthUint64 * FLAGS_lookup_percent),
         erase_threshold_(lookup_threshold_ +
                          kHundredthUint64 * FLAGS_erase_percent),
+        scan_threshold_(kHundredthUint64 * FLAGS_scan_percent),
+        lookup_insert_helper_(
+            FLAGS_admission_policy.empty() && FLAGS_scan_percent == 0
+                ? &helper2
+                : &helper_data_block),
         skewed_(FLAGS_skewed) {
     if (erase_threshold_ != 100U * kHundredthUint64) {
       fprintf(stderr, "Percentages must add to 100.\n");
@@ -289,17 +332,30 @@ class CacheBench {
       if (max_key > (static_cast<uint64_t>(1) << max_log_)) max_log_++;
     }
 
+    std::shared_ptr<CacheAdmissionPolicy> admission_policy;
+    if (FLAGS_admission_policy == "tinylfu") {
+      TinyLFUAdmissionOptions admission_opts;
+      admission_opts.expected_entries =
+          static_cast<size_t>(FLAGS_cache_size / FLAGS_value_bytes);
+      admission_policy = NewTinyLFUAdmissionPolicy(admission_opts);
+    } else if (!FLAGS_admission_policy.empty()) {
+      fprintf(stderr, "Admission policy not supported.\n");
+      exit(1);
+    }
+
     if (FLAGS_cache_type == "clock_cache") {
       fprintf(stderr, "Old clock cache implementation has been removed.\n");
       exit(1);
     } else if (FLAGS_cache_type == "hyper_clock_cache") {
-      cache_ = HyperClockCacheOptions(FLAGS_cache_size, FLAGS_value_bytes,
-                                      FLAGS_num_shard_bits)
-                   .MakeSharedCache();
+      HyperClockCacheOptions opts(FLAGS_cache_size, FLAGS_value_bytes,
+                                  FLAGS_num_shard_bits);
+      opts.admission_policy = admission_policy;
+      cache_ = opts.MakeSharedCache();
     } else if (FLAGS_cache_type == "lru_cache") {
       LRUCacheOptions opts(FLAGS_cache_size, FLAGS_num_shard_bits,
                            false /* strict_capacity_limit */,
                            0.5 /* high_pri_pool_ratio */);
+      opts.admission_policy = admission_policy;
 #ifndef ROCKSDB_LITE
       if (!FLAGS_secondary_cache_uri.empty()) {
         Status s = SecondaryCache::CreateFromString(
@@ -314,6 +370,21 @@ class CacheBench {
         opts.secondary_cache = secondary_cache;
       }
 #endif  // ROCKSDB_LITE
+      if (!FLAGS_file_secondary_cache_path.empty()) {
+        FileSecondaryCacheOptions file_opts;
+        file_opts.path = FLAGS_file_secondary_cache_path;
+        file_opts.capacity =
+            static_cast<size_t>(FLAGS_file_secondary_cache_size);
+        file_opts.segment_size =
+            static_cast<size_t>(FLAGS_file_secondary_cache_segment_size);
+        Status s = NewFileSecondaryCache(file_opts, &file_secondary_cache_);
+        if (!s.ok()) {
+          fprintf(stderr, "Failed to create file secondary cache: %s\n",
+                  s.ToString().c_str());
+          exit(1);
+        }
+        opts.secondary_cache = file_secondary_cache_;
+      }
 
       cache_ = NewLRUCache(opts);
     } else {
@@ -397,6 +468,49 @@ class CacheBench {
     }
     printf("%s", combined.ToString().c_str());
 
+    uint64_t point_lookups = 0;
+    uint64_t point_hits = 0;
+    uint64_t scan_lookups = 0;
+    uint64_t scan_hits = 0;
+    for (uint32_t i = 0; i < FLAGS_threads; i++) {
+      point_lookups += threads[i]->point_lookups;
+      point_hits += threads[i]->point_hits;
+      scan_lookups += threads[i]->scan_lookups;
+      scan_hits += threads[i]->scan_hits;
+    }
+    printf("\nPoint lookup+insert hit ratio: %.4f\n",
+           point_lookups ? 1.0 * point_hits / point_lookups : 0.0);
+    if (FLAGS_scan_percent > 0) {
+      printf("Scan lookup+insert hit ratio: %.4f\n",
+             scan_lookups ? 1.0 * scan_hits / scan_lookups : 0.0);
+    }
+    auto sharded = dynamic_cast<ShardedCacheBase*>(cache_.get());
+    if (sharded && sharded->GetAdmissionPolicy()) {
+      auto role_stats = sharded->GetRoleStats();
+      for (uint32_t r = 0; r < kNumCacheEntryRoles; r++) {
+        const auto& rs = role_stats[r];
+        if (rs.hits + rs.inserts + rs.rejects == 0) {
+          continue;
+        }
+        printf("Role %s: hits %" PRIu64 ", inserts %" PRIu64
+               ", rejects %" PRIu64 ", hit ratio %.4f\n",
+               kCacheEntryRoleToCamelString[r].c_str(), rs.hits, rs.inserts,
+               rs.rejects, rs.HitRatio());
+      }
+    }
+
+    auto file_cache =
+        dynamic_cast<FileSecondaryCache*>(file_secondary_cache_.get());
+    if (file_cache) {
+      FileSecondaryCache::Stats fs = file_cache->GetStats();
+      printf("File secondary cache: lookups %" PRIu64 ", hits %" PRIu64
+             ", read failures %" PRIu64 ", inserts %" PRIu64
+             ", insert drops %" PRIu64 ", segment writes %" PRIu64
+             ", evictions %" PRIu64 "\n",
+             fs.lookups, fs.hits, fs.read_failures, fs.inserts,
+             fs.insert_drops, fs.segment_writes, fs.evictions);
+    }
+
     if (FLAGS_gather_stats) {
       printf("\nGather stats latency (us):\n");
       printf("%s", stats_hist.ToString().c_str());
@@ -409,12 +523,16 @@ class CacheBench {
 
  private:
   std::shared_ptr<Cache> cache_;
+  std::shared_ptr<SecondaryCache> file_secondary_cache_;
   const uint64_t max_key_;
   // Cumulative thresholds in the space of a random uint64_t
   const uint64_t lookup_insert_threshold_;
   const uint64_t insert_threshold_;
   const uint64_t lookup_threshold_;
   const uint64_t erase_threshold_;
+  // Threshold of scans within lookup+insert operations
+  const uint64_t scan_threshold_;
+  const Cache::CacheItemHelper* const lookup_insert_helper_;
   const bool skewed_;
   int max_log_;
 
@@ -526,6 +644,7 @@ class CacheBench {
     // To hold handles for a non-trivial amount of time
     Cache::Handle* handle = nullptr;
     KeyGen gen;
+    uint64_t scan_pos = 0;
     const auto clock = SystemClock::Default().get();
     uint64_t start_time = clock->NowMicros();
     StopWatchNano timer(clock);
@@ -544,15 +663,49 @@ class CacheBench {
 
       timer.Start();
 
-      if (random_op < lookup_insert_threshold_) {
+      if (random_op < lookup_insert_threshold_ &&
+          thread->rnd.Next() < scan_threshold_) {
+        if (handle) {
+          cache_->Release(handle);
+          handle = nullptr;
+        }
+        // do a scan of keys never accessed again, beyond the range of
+        // point lookups
+        for (uint32_t j = 0; j < FLAGS_scan_length; j++) {
+          Slice scan_key = gen.Get(max_key_ + (uint64_t{thread->tid} << 40) +
+                                   scan_pos++);
+          Cache::Handle* h =
+              cache_->Lookup(scan_key, lookup_insert_helper_, create_cb,
+                             Cache::Priority::LOW, true);
+          thread->scan_lookups++;
+          if (h) {
+            thread->scan_hits++;
+          } else {
+            char* value = createValue(thread->rnd);
+            Status s = cache_->Insert(scan_key, value, lookup_insert_helper_,
+                                      FLAGS_value_bytes, &h);
+            if (s.IsIncomplete()) {
+              // Rejected by the admission policy
+              delete[] value;
+            } else {
+              assert(s.ok());
+            }
+          }
+          if (h) {
+            cache_->Release(h);
+          }
+        }
+      } else if (random_op < lookup_insert_threshold_) {
         if (handle) {
           cache_->Release(handle);
           handle = nullptr;
         }
         // do lookup
-        handle = cache_->Lookup(key, &helper2, create_cb, Cache::Priority::LOW,
-                                true);
+        handle = cache_->Lookup(key, lookup_insert_helper_, create_cb,
+                                Cache::Priority::LOW, true);
+        thread->point_lookups++;
         if (handle) {
+          thread->point_hits++;
           if (!FLAGS_lean) {
             // do something with the data
             result += NPHash64(static_cast<char*>(cache_->Value(handle)),
@@ -560,9 +713,15 @@ class CacheBench {
           }
         } else {
           // do insert
-          Status s = cache_->Insert(key, createValue(thread->rnd), &helper2,
+          char* value = createValue(thread->rnd);
+          Status s = cache_->Insert(key, value, lookup_insert_helper_,
                                     FLAGS_value_bytes, &handle);
-          assert(s.ok());
+          if (s.IsIncomplete()) {
+            // Rejected by the admission policy
+            delete[] value;
+          } else {
+            assert(s.ok());
+          }
         }
       } else if (random_op < insert_threshold_) {
         if (handle) {
@@ -578,6 +737,33 @@ class CacheBench {
           cache_->Release(handle);
           handle = nullptr;
         }
+        if (FLAGS_lookup_batch > 1) {
+          // do a batch of lookups, waiting for all of them together
+          std::vector<std::string> keys;
+          keys.emplace_back(key.ToString());
+          while (keys.size() < FLAGS_lookup_batch) {
+            keys.emplace_back(
+                gen.GetRand(thread->rnd, max_key_, max_log_).ToString());
+          }
+          std::vector<Cache::Handle*> handles;
+          for (const std::string& k : keys) {
+            handles.push_back(cache_->Lookup(k, &helper2, create_cb,
+                                             Cache::Priority::LOW, false));
+          }
+          cache_->WaitAll(handles);
+          for (Cache::Handle* h : handles) {
+            if (h) {
+              void* value = cache_->Value(h);
+              if (value && !FLAGS_lean) {
+                result += NPHash64(static_cast<char*>(value),
+                                   FLAGS_value_bytes);
+              }
+              cache_->Release(h);
+            }
+          }
+          thread->latency_ns_hist.Add(timer.ElapsedNanos());
+          continue;
+        }
         // do lookup
         handle = cache_->Lookup(key, &helper2, create_cb, Cache::Priority::LOW,
                                 true);
@@ -632,6 +818,12 @@ class CacheBench {
     printf("Insert percentage   : %u%%\n", FLAGS_insert_percent);
     printf("Lookup percentage   : %u%%\n", FLAGS_lookup_percent);
     printf("Erase percentage    : %u%%\n", FLAGS_erase_percent);
+    printf("Scan percentage     : %u%% (length %u)\n", FLAGS_scan_percent,
+           FLAGS_scan_length);
+    printf("Lookup batch        : %u\n", FLAGS_lookup_batch);
+    printf("Admission policy    : %s\n", FLAGS_admission_policy.empty()
+                                              ? "none"
+                                              : FLAGS_admission_policy.c_str());
     std::ostringstream stats;
     if (FLAGS_gather_stats) {
       stats << "enabled (" << FLAGS_gather_stats_sleep_ms << "ms, "
@@ -5,6 +5,7 @@
 
 #include "cache/cache_entry_roles.h"
 
+#include <atomic>
 #include <mutex>
 
 #include "port/lang.h"
@@ -106,14 +107,47 @@ namespace {
 struct Registry {
   std::mutex mutex;
   UnorderedMap<Cache::DeleterFn, CacheEntryRole> role_map;
+  // Lock-free copy of the first kMaxFastEntries registrations, published by
+  // the release store to fast_count.
+  static constexpr size_t kMaxFastEntries = 64;
+  std::array<std::atomic<Cache::DeleterFn>, kMaxFastEntries> fast_fns{};
+  std::array<std::atomic<CacheEntryRole>, kMaxFastEntries> fast_roles{};
+  std::atomic<size_t> fast_count{0};
+
   void Register(Cache::DeleterFn fn, CacheEntryRole role) {
     std::lock_guard<std::mutex> lock(mutex);
     role_map[fn] = role;
+    size_t n = fast_count.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < n; ++i) {
+      if (fast_fns[i].load(std::memory_order_relaxed) == fn) {
+        fast_roles[i].store(role, std::memory_order_relaxed);
+        return;
+      }
+    }
+    if (n < kMaxFastEntries) {
+      fast_fns[n].store(fn, std::memory_order_relaxed);
+      fast_roles[n].store(role, std::memory_order_relaxed);
+      fast_count.store(n + 1, std::memory_order_release);
+    }
   }
   UnorderedMap<Cache::DeleterFn, CacheEntryRole> Copy() {
     std::lock_guard<std::mutex> lock(mutex);
     return role_map;
   }
+  CacheEntryRole Get(Cache::DeleterFn fn) {
+    size_t n = fast_count.load(std::memory_order_acquire);
+    for (size_t i = 0; i < n; ++i) {
+      if (fast_fns[i].load(std::memory_order_relaxed) == fn) {
+        return fast_roles[i].load(std::memory_order_relaxed);
+      }
+    }
+    if (n < kMaxFastEntries) {
+      return CacheEntryRole::kMisc;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    auto iter = role_map.find(fn);
+    return iter == role_map.end() ? CacheEntryRole::kMisc : iter->second;
+  }
 };
 
 Registry& GetRegistry() {
@@ -131,4 +165,8 @@ UnorderedMap<Cache::DeleterFn, CacheEntryRole> CopyCacheDeleterRoleMap() {
   return GetRegistry().Copy();
 }
 
+CacheEntryRole GetCacheEntryRoleOfDeleter(Cache::DeleterFn fn) {
+  return GetRegistry().Get(fn);
+}
+
 }  // namespace ROCKSDB_NAMESPACE
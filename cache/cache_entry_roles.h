@@ -46,6 +46,12 @@ void RegisterCacheDeleterRole(Cache::DeleterFn fn, CacheEntryRole role);
 // * The number of mappings should be sufficiently small (dozens).
 UnorderedMap<Cache::DeleterFn, CacheEntryRole> CopyCacheDeleterRoleMap();
 
+// Returns the role registered for a deleter, or kMisc if the deleter is not
+// registered. Unlike CopyCacheDeleterRoleMap, this is lock-free for the
+// first few dozen registrations, so it is usable on Cache hot paths, such as
+// by the admission policy of ShardedCache.
+CacheEntryRole GetCacheEntryRoleOfDeleter(Cache::DeleterFn fn);
+
 // ************************************************************** //
 // An automatic registration infrastructure. This enables code
 // to simply ask for a deleter associated with a particular type
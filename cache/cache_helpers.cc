@@ -0,0 +1,62 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "cache/cache_helpers.h"
+
+#include <vector>
+
+#include "port/lang.h"
+#include "port/likely.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+thread_local ROCKSDB_STATIC_TLS CacheWaitYieldFn tls_cache_wait_yield =
+    nullptr;
+}  // namespace
+
+CacheWaitYieldScope::CacheWaitYieldScope(CacheWaitYieldFn yield)
+    : saved_(tls_cache_wait_yield) {
+  tls_cache_wait_yield = yield;
+}
+
+CacheWaitYieldScope::~CacheWaitYieldScope() { tls_cache_wait_yield = saved_; }
+
+CacheWaitYieldFn CacheWaitYieldScope::Current() { return tls_cache_wait_yield; }
+
+Cache::Handle* LookupWithYield(Cache* cache, const Slice& key,
+                               const Cache::CacheItemHelper* helper,
+                               const Cache::CreateCallback& create_cb,
+                               Cache::Priority priority, Statistics* stats) {
+  CacheWaitYieldFn yield = tls_cache_wait_yield;
+  if (LIKELY(yield == nullptr)) {
+    return cache->Lookup(key, helper, create_cb, priority, /*wait=*/true,
+                         stats);
+  }
+  Cache::Handle* handle =
+      cache->Lookup(key, helper, create_cb, priority, /*wait=*/false, stats);
+  if (handle == nullptr || cache->Value(handle) != nullptr) {
+    // A miss, or a hit in the primary cache
+    return handle;
+  }
+  if (!cache->IsReady(handle)) {
+    // Completions of async reads are reaped by whoever waits first, so a
+    // single yield is enough to overlap the reads of all the fibers: the
+    // lookup may be complete when this fiber is resumed, otherwise waiting
+    // for it also completes the reads of the others.
+    yield();
+  }
+  // Also publishes a ready handle to the primary cache
+  std::vector<Cache::Handle*> handles{handle};
+  cache->WaitAll(handles);
+  if (cache->Value(handle) == nullptr) {
+    // The secondary cache lookup failed
+    cache->Release(handle);
+    return nullptr;
+  }
+  return handle;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cassert>
+#include <memory>
 
 #include "rocksdb/cache.h"
 #include "rocksdb/rocksdb_namespace.h"
@@ -142,4 +143,38 @@ std::shared_ptr<T> MakeSharedCacheHandleGuard(Cache* cache,
   return std::shared_ptr<T>(wrapper, static_cast<T*>(cache->Value(handle)));
 }
 
+// Lets a thread run other work while one of its secondary cache lookups is
+// pending, see CacheWaitYieldScope.
+using CacheWaitYieldFn = void (*)();
+
+// Install `yield` for the current thread during the lifetime of the scope,
+// restoring the previous one on destruction. While it is installed,
+// LookupWithYield() issues secondary cache lookups without waiting and
+// calls `yield` before waiting for them, e.g. the fiber MultiGet switches
+// to the other fibers of the thread, which issue their own IO and cache
+// lookups while the lookup is in flight.
+class CacheWaitYieldScope {
+ public:
+  explicit CacheWaitYieldScope(CacheWaitYieldFn yield);
+  ~CacheWaitYieldScope();
+
+  CacheWaitYieldScope(const CacheWaitYieldScope&) = delete;
+  CacheWaitYieldScope& operator=(const CacheWaitYieldScope&) = delete;
+
+  // The yield function of the current thread, or nullptr
+  static CacheWaitYieldFn Current();
+
+ private:
+  CacheWaitYieldFn saved_;
+};
+
+// Equivalent to cache->Lookup(key, helper, create_cb, priority, wait=true,
+// stats), but when a CacheWaitYieldScope is active on this thread, a
+// pending secondary cache lookup is waited for only after yielding once.
+// Returns nullptr on a miss, including a failed secondary cache lookup.
+Cache::Handle* LookupWithYield(Cache* cache, const Slice& key,
+                               const Cache::CacheItemHelper* helper,
+                               const Cache::CreateCallback& create_cb,
+                               Cache::Priority priority, Statistics* stats);
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -15,7 +15,9 @@
 #include <string>
 #include <vector>
 
+#include "cache/cache_entry_roles.h"
 #include "cache/lru_cache.h"
+#include "cache/tiny_lfu.h"
 #include "port/stack_trace.h"
 #include "test_util/testharness.h"
 #include "util/coding.h"
@@ -1024,6 +1026,110 @@ TEST_P(CacheTest, GetChargeAndDeleter) {
   cache_->Release(h1);
 }
 
+TEST_P(CacheTest, AdmissionPolicy) {
+  const size_t kCapacity = 100;
+  std::shared_ptr<Cache> cache;
+  if (GetParam() == kLRU) {
+    LRUCacheOptions co(kCapacity, 0 /*num_shard_bits*/,
+                       false /*strict_capacity_limit*/,
+                       0.0 /*high_pri_pool_ratio*/, nullptr /*allocator*/,
+                       kDefaultToAdaptiveMutex, kDontChargeCacheMetadata);
+    co.admission_policy = NewTinyLFUAdmissionPolicy();
+    cache = NewLRUCache(co);
+  } else {
+    HyperClockCacheOptions co(kCapacity, 1 /*estimated_value_size*/,
+                              0 /*num_shard_bits*/,
+                              false /*strict_capacity_limit*/,
+                              nullptr /*allocator*/, kDontChargeCacheMetadata);
+    co.admission_policy = NewTinyLFUAdmissionPolicy();
+    cache = co.MakeSharedCache();
+  }
+  Cache::DeleterFn data_deleter =
+      GetNoopDeleterForRole<CacheEntryRole::kDataBlock>();
+
+  // Everything is admitted while there is room
+  for (int i = 0; i < static_cast<int>(kCapacity); i++) {
+    ASSERT_EQ(nullptr, cache->Lookup(EncodeKey(i)));
+    ASSERT_OK(cache->Insert(EncodeKey(i), EncodeValue(i), 1, data_deleter));
+  }
+  ASSERT_EQ(kCapacity, cache->GetUsage());
+
+  // A data block missed once is not admitted into the full cache
+  Cache::Handle* handle = nullptr;
+  ASSERT_EQ(nullptr, cache->Lookup(EncodeKey(1000)));
+  Status s = cache->Insert(EncodeKey(1000), EncodeValue(1000), 1,
+                           data_deleter, &handle);
+  ASSERT_TRUE(s.IsIncomplete());
+  ASSERT_EQ(nullptr, handle);
+  ASSERT_EQ(nullptr, cache->Lookup(EncodeKey(1001)));
+  ASSERT_OK(cache->Insert(EncodeKey(1001), EncodeValue(1001), 1, data_deleter));
+  ASSERT_EQ(kCapacity, cache->GetUsage());
+
+  // But it is on the second miss
+  ASSERT_EQ(nullptr, cache->Lookup(EncodeKey(1000)));
+  ASSERT_OK(cache->Insert(EncodeKey(1000), EncodeValue(1000), 1,
+                          data_deleter, &handle));
+  ASSERT_NE(nullptr, handle);
+  ASSERT_EQ(1000, DecodeValue(cache->Value(handle)));
+  cache->Release(handle);
+
+  // Other roles are always admitted
+  ASSERT_OK(cache->Insert(EncodeKey(2000), EncodeValue(2000), 1,
+                          &CacheTest::Deleter, &handle));
+  ASSERT_NE(nullptr, handle);
+  cache->Release(handle);
+
+  auto stats = static_cast<ShardedCacheBase*>(cache.get())->GetRoleStats();
+  const auto& data_stats =
+      stats[static_cast<size_t>(CacheEntryRole::kDataBlock)];
+  ASSERT_EQ(kCapacity + 1, data_stats.inserts);
+  ASSERT_EQ(2U, data_stats.rejects);
+  ASSERT_EQ(0U, data_stats.hits);
+}
+
+TEST(FrequencySketchTest, EstimateAndAging) {
+  FrequencySketch sketch(1024, 1 /*aging_factor*/);
+  ASSERT_EQ(8192U, sketch.NumCounters());
+  ASSERT_EQ(1024U, sketch.AgingPeriod());
+
+  for (int i = 0; i < 8; i++) {
+    sketch.Increment(42);
+  }
+  ASSERT_EQ(8U, sketch.Estimate(42));
+  int non_zero = 0;
+  for (uint64_t key = 1000; key < 2000; key++) {
+    non_zero += sketch.Estimate(key) > 0;
+  }
+  ASSERT_LT(non_zero, 10);
+
+  // Counters saturate
+  for (int i = 0; i < 20; i++) {
+    sketch.Increment(7);
+  }
+  ASSERT_EQ(FrequencySketch::kMaxFrequency, sketch.Estimate(7));
+
+  // Reaching the aging period halves all counters. The saturated increments
+  // of key 7 are not counted in the period.
+  for (uint64_t key = 10000; key < 10000 + 1024 - 8 - 15; key++) {
+    sketch.Increment(key);
+  }
+  // Count-min never underestimates, and the halving happened
+  ASSERT_GE(sketch.Estimate(42), 4U);
+  ASSERT_LT(sketch.Estimate(42), 8U);
+  ASSERT_GE(sketch.Estimate(7), 7U);
+  ASSERT_LT(sketch.Estimate(7), FrequencySketch::kMaxFrequency);
+}
+
+TEST(FrequencySketchTest, AgingEveryIncrement) {
+  // aging_factor 0 ages after every increment, not only after the first
+  FrequencySketch sketch(1024, 0 /*aging_factor*/);
+  ASSERT_EQ(1U, sketch.AgingPeriod());
+  for (int i = 0; i < 10; i++) {
+    sketch.Increment(42);
+    ASSERT_EQ(0U, sketch.Estimate(42));
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(CacheTestInstance, CacheTest,
                         testing::Values(kLRU, kHyperClock));
 INSTANTIATE_TEST_CASE_P(CacheTestInstance, LRUCacheTest, testing::Values(kLRU));
@@ -1396,9 +1396,13 @@ std::shared_ptr<Cache> HyperClockCacheOptions::MakeSharedCache() const {
     constexpr size_t min_shard_size = 32U * 1024U * 1024U;
     my_num_shard_bits = GetDefaultCacheShardBits(capacity, min_shard_size);
   }
-  return std::make_shared<clock_cache::HyperClockCache>(
+  auto cache = std::make_shared<clock_cache::HyperClockCache>(
       capacity, estimated_entry_charge, my_num_shard_bits,
       strict_capacity_limit, metadata_charge_policy, memory_allocator);
+  if (admission_policy) {
+    cache->SetAdmissionPolicy(admission_policy);
+  }
+  return cache;
 }
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -573,6 +573,9 @@ class ALIGN_AS(CACHE_LINE_SIZE) ClockCacheShard final : public CacheShardBase {
   static inline uint32_t HashPieceForSharding(HashCref hash) {
     return Upper32of64(hash[0]);
   }
+  static inline uint64_t HashPieceForAdmission(HashCref hash) {
+    return hash[1];
+  }
   static inline HashVal ComputeHash(const Slice& key) {
     assert(key.size() == kCacheKeySize);
     HashVal in;
@@ -0,0 +1,387 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "cache/file_secondary_cache.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+#include "util/coding.h"
+#include "util/crc32c.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+FileSecondaryCacheResultHandle::FileSecondaryCacheResultHandle(
+    FileSecondaryCache* cache, const Location& loc,
+    const Cache::CreateCallback& create_cb)
+    : cache_(cache), loc_(loc), create_cb_(create_cb) {}
+
+FileSecondaryCacheResultHandle::~FileSecondaryCacheResultHandle() {
+  if (io_handle_ != nullptr && !ready_) {
+    std::vector<void*> io_handles{io_handle_};
+    cache_->fs_->AbortIO(io_handles).PermitUncheckedError();
+  }
+  ReleaseIOHandle();
+}
+
+void FileSecondaryCacheResultHandle::Wait() {
+  if (!ready_) {
+    cache_->WaitAll({this});
+  }
+}
+
+void FileSecondaryCacheResultHandle::Complete(const Slice& data) {
+  ready_ = true;
+  value_ = nullptr;
+  size_ = 0;
+  if (data.size() == loc_.size &&
+      cache_->Generation(loc_.segment) == loc_.generation) {
+    uint32_t expected = crc32c::Unmask(DecodeFixed32(data.data()));
+    const char* value = data.data() + FileSecondaryCache::kChecksumSize;
+    size_t value_size = data.size() - FileSecondaryCache::kChecksumSize;
+    if (crc32c::Value(value, value_size) == expected) {
+      Status s = create_cb_(value, value_size, &value_, &size_);
+      if (s.ok()) {
+        cache_->hits_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      value_ = nullptr;
+      size_ = 0;
+    }
+  }
+  cache_->read_failures_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FileSecondaryCacheResultHandle::OnReadDone(const FSReadRequest& req,
+                                                void* arg) {
+  auto handle = static_cast<FileSecondaryCacheResultHandle*>(arg);
+  handle->Complete(req.status.ok() ? req.result : Slice());
+}
+
+void FileSecondaryCacheResultHandle::ReleaseIOHandle() {
+  if (io_handle_ != nullptr && del_fn_ != nullptr) {
+    del_fn_(io_handle_);
+  }
+  io_handle_ = nullptr;
+  del_fn_ = nullptr;
+}
+
+FileSecondaryCache::FileSecondaryCache(const FileSecondaryCacheOptions& opts)
+    : opts_(opts),
+      num_segments_(opts.segment_size == 0
+                        ? 0
+                        : static_cast<uint32_t>(std::min<size_t>(
+                              opts.capacity / opts.segment_size,
+                              kNoSegment - 1))),
+      fs_(opts.file_system ? opts.file_system : FileSystem::Default()),
+      cv_(&mutex_) {}
+
+FileSecondaryCache::~FileSecondaryCache() {
+  if (writer_thread_.joinable()) {
+    {
+      MutexLock l(&mutex_);
+      shutdown_ = true;
+      cv_.SignalAll();
+    }
+    writer_thread_.join();
+  }
+  if (writer_) {
+    writer_->Close(IOOptions(), nullptr).PermitUncheckedError();
+  }
+  if (reader_) {
+    reader_.reset();
+    fs_->DeleteFile(opts_.path, IOOptions(), nullptr).PermitUncheckedError();
+  }
+}
+
+Status FileSecondaryCache::Open() {
+  if (opts_.path.empty()) {
+    return Status::InvalidArgument("File secondary cache path is empty");
+  }
+  if (opts_.segment_size <= kChecksumSize ||
+      opts_.segment_size > std::numeric_limits<uint32_t>::max()) {
+    return Status::InvalidArgument("Invalid file secondary cache segment_size");
+  }
+  if (num_segments_ < 2) {
+    return Status::InvalidArgument(
+        "File secondary cache capacity must be at least two segments");
+  }
+  // The index is not persisted, so anything left by a previous instance is
+  // garbage
+  fs_->DeleteFile(opts_.path, IOOptions(), nullptr).PermitUncheckedError();
+  FileOptions file_opts;
+  std::unique_ptr<FSWritableFile> file;
+  IOStatus s = fs_->NewWritableFile(opts_.path, file_opts, &file, nullptr);
+  if (s.ok()) {
+    s = file->Close(IOOptions(), nullptr);
+  }
+  if (s.ok()) {
+    s = fs_->NewRandomRWFile(opts_.path, file_opts, &writer_, nullptr);
+  }
+  if (s.ok()) {
+    s = fs_->NewRandomAccessFile(opts_.path, file_opts, &reader_, nullptr);
+  }
+  if (!s.ok()) {
+    return s;
+  }
+
+  segment_keys_.resize(num_segments_);
+  generations_.reset(new std::atomic<uint32_t>[num_segments_]);
+  for (uint32_t i = 0; i < num_segments_; ++i) {
+    generations_[i].store(0, std::memory_order_relaxed);
+  }
+  active_.data.reset(new char[opts_.segment_size]);
+  active_.segment = 0;
+  flushing_.data.reset(new char[opts_.segment_size]);
+  writer_thread_ = port::Thread([this] { WriterThread(); });
+  return Status::OK();
+}
+
+const FileSecondaryCache::SegmentBuffer* FileSecondaryCache::BufferOf(
+    uint32_t segment) const {
+  if (segment == active_.segment) {
+    return &active_;
+  }
+  if (segment == flushing_.segment) {
+    return &flushing_;
+  }
+  return nullptr;
+}
+
+void FileSecondaryCache::RotateSegment() {
+  assert(flushing_.segment == kNoSegment);
+  std::swap(active_, flushing_);
+  uint32_t next = flushing_.segment + 1;
+  if (next == num_segments_) {
+    next = 0;
+  }
+  // Invalidate the reads still in flight on the old content first
+  generations_[next].fetch_add(1, std::memory_order_release);
+  for (const std::string& key : segment_keys_[next]) {
+    auto it = index_.find(key);
+    // The key may have been erased, or inserted again after its eviction
+    if (it != index_.end() && it->second.segment == next) {
+      index_.erase(it);
+      evictions_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  segment_keys_[next].clear();
+  active_.segment = next;
+  active_.used = 0;
+  cv_.SignalAll();
+}
+
+void FileSecondaryCache::WriterThread() {
+  MutexLock l(&mutex_);
+  for (;;) {
+    while (!shutdown_ && flushing_.segment == kNoSegment) {
+      cv_.Wait();
+    }
+    if (flushing_.segment == kNoSegment) {
+      return;
+    }
+    const uint32_t segment = flushing_.segment;
+    Slice data(flushing_.data.get(), flushing_.used);
+    // The buffer is immutable until released below, only lookups read it
+    mutex_.Unlock();
+    IOStatus s = writer_->Write(uint64_t{segment} * opts_.segment_size, data,
+                                IOOptions(), nullptr);
+    mutex_.Lock();
+    if (s.ok()) {
+      segment_writes_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      // Entries of the segment would fail their checksum, drop them now
+      generations_[segment].fetch_add(1, std::memory_order_release);
+      for (const std::string& key : segment_keys_[segment]) {
+        auto it = index_.find(key);
+        if (it != index_.end() && it->second.segment == segment) {
+          index_.erase(it);
+        }
+      }
+      segment_keys_[segment].clear();
+    }
+    flushing_.segment = kNoSegment;
+    flushing_.used = 0;
+  }
+}
+
+Status FileSecondaryCache::Insert(const Slice& key, void* value,
+                                  const Cache::CacheItemHelper* helper) {
+  if (value == nullptr || helper == nullptr || helper->size_cb == nullptr ||
+      helper->saveto_cb == nullptr) {
+    return Status::InvalidArgument();
+  }
+  const size_t size = (*helper->size_cb)(value);
+  const size_t record_size = kChecksumSize + size;
+  if (record_size > opts_.segment_size || size == 0) {
+    return Status::OK();
+  }
+  std::string key_str = key.ToString();
+
+  MutexLock l(&mutex_);
+  if (active_.segment == kNoSegment || index_.count(key_str) > 0) {
+    return Status::OK();
+  }
+  if (active_.used + record_size > opts_.segment_size) {
+    if (flushing_.segment != kNoSegment) {
+      insert_drops_.fetch_add(1, std::memory_order_relaxed);
+      return Status::OK();
+    }
+    RotateSegment();
+  }
+  char* dst = active_.data.get() + active_.used;
+  Status s = (*helper->saveto_cb)(value, 0, size, dst + kChecksumSize);
+  if (!s.ok()) {
+    return s;
+  }
+  EncodeFixed32(dst, crc32c::Mask(crc32c::Value(dst + kChecksumSize, size)));
+  Location loc{active_.segment, Generation(active_.segment),
+               static_cast<uint32_t>(active_.used),
+               static_cast<uint32_t>(record_size)};
+  index_.emplace(key_str, loc);
+  segment_keys_[active_.segment].push_back(std::move(key_str));
+  active_.used += record_size;
+  inserts_.fetch_add(1, std::memory_order_relaxed);
+  return Status::OK();
+}
+
+std::unique_ptr<SecondaryCacheResultHandle> FileSecondaryCache::Lookup(
+    const Slice& key, const Cache::CreateCallback& create_cb, bool wait,
+    bool /*advise_erase*/, bool& is_in_sec_cache) {
+  is_in_sec_cache = false;
+  lookups_.fetch_add(1, std::memory_order_relaxed);
+  std::unique_ptr<FileSecondaryCacheResultHandle> handle;
+  bool in_memory = false;
+  {
+    MutexLock l(&mutex_);
+    auto it = index_.find(key.ToString());
+    if (it == index_.end()) {
+      return nullptr;
+    }
+    const Location& loc = it->second;
+    handle.reset(new FileSecondaryCacheResultHandle(this, loc, create_cb));
+    handle->scratch_.reset(new char[loc.size]);
+    const SegmentBuffer* buf = BufferOf(loc.segment);
+    if (buf != nullptr) {
+      memcpy(handle->scratch_.get(), buf->data.get() + loc.offset, loc.size);
+      in_memory = true;
+    }
+  }
+  is_in_sec_cache = true;
+
+  if (in_memory) {
+    handle->Complete(Slice(handle->scratch_.get(), handle->loc_.size));
+  } else {
+    StartRead(handle.get());
+    if (wait) {
+      handle->Wait();
+    }
+  }
+  if (handle->IsReady() && handle->Value() == nullptr) {
+    return nullptr;
+  }
+  return handle;
+}
+
+void FileSecondaryCache::StartRead(FileSecondaryCacheResultHandle* handle) {
+  FSReadRequest& req = handle->req_;
+  req.offset =
+      uint64_t{handle->loc_.segment} * opts_.segment_size + handle->loc_.offset;
+  req.len = handle->loc_.size;
+  req.scratch = handle->scratch_.get();
+  IOStatus s = reader_->ReadAsync(req, IOOptions(),
+                                  FileSecondaryCacheResultHandle::OnReadDone,
+                                  handle, &handle->io_handle_,
+                                  &handle->del_fn_, nullptr);
+  if (s.IsNotSupported()) {
+    // No async IO in this FileSystem (or io_uring is unavailable)
+    handle->ReleaseIOHandle();
+    s = reader_->Read(req.offset, req.len, IOOptions(), &req.result,
+                      req.scratch, nullptr);
+    handle->Complete(s.ok() ? req.result : Slice());
+  } else if (!s.ok()) {
+    handle->ReleaseIOHandle();
+    if (!handle->ready_) {
+      handle->Complete(Slice());
+    }
+  }
+}
+
+void FileSecondaryCache::Erase(const Slice& key) {
+  MutexLock l(&mutex_);
+  // The record stays in its segment until the segment is reused
+  index_.erase(key.ToString());
+}
+
+void FileSecondaryCache::WaitAll(
+    std::vector<SecondaryCacheResultHandle*> handles) {
+  std::vector<void*> io_handles;
+  io_handles.reserve(handles.size());
+  for (SecondaryCacheResultHandle* h : handles) {
+    auto handle = static_cast<FileSecondaryCacheResultHandle*>(h);
+    if (!handle->ready_ && handle->io_handle_ != nullptr) {
+      io_handles.push_back(handle->io_handle_);
+    }
+  }
+  if (!io_handles.empty()) {
+    // Completion callbacks run inside Poll
+    fs_->Poll(io_handles, io_handles.size()).PermitUncheckedError();
+  }
+  for (SecondaryCacheResultHandle* h : handles) {
+    auto handle = static_cast<FileSecondaryCacheResultHandle*>(h);
+    handle->ReleaseIOHandle();
+    if (!handle->ready_) {
+      handle->Complete(Slice());
+    }
+  }
+}
+
+Status FileSecondaryCache::GetCapacity(size_t& capacity) {
+  capacity = size_t{num_segments_} * opts_.segment_size;
+  return Status::OK();
+}
+
+std::string FileSecondaryCache::GetPrintableOptions() const {
+  std::string ret;
+  ret.reserve(1000);
+  const int kBufferSize = 200;
+  char buffer[kBufferSize];
+  snprintf(buffer, kBufferSize, "    path : %s\n", opts_.path.c_str());
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "    capacity : %" ROCKSDB_PRIszt "\n",
+           size_t{num_segments_} * opts_.segment_size);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "    segment_size : %" ROCKSDB_PRIszt "\n",
+           opts_.segment_size);
+  ret.append(buffer);
+  return ret;
+}
+
+FileSecondaryCache::Stats FileSecondaryCache::GetStats() const {
+  Stats stats;
+  stats.lookups = lookups_.load(std::memory_order_relaxed);
+  stats.hits = hits_.load(std::memory_order_relaxed);
+  stats.read_failures = read_failures_.load(std::memory_order_relaxed);
+  stats.inserts = inserts_.load(std::memory_order_relaxed);
+  stats.insert_drops = insert_drops_.load(std::memory_order_relaxed);
+  stats.segment_writes = segment_writes_.load(std::memory_order_relaxed);
+  stats.evictions = evictions_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+Status NewFileSecondaryCache(const FileSecondaryCacheOptions& opts,
+                             std::shared_ptr<SecondaryCache>* result) {
+  auto cache = std::make_shared<FileSecondaryCache>(opts);
+  Status s = cache->Open();
+  if (s.ok()) {
+    *result = std::move(cache);
+  }
+  return s;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
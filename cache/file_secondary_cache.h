@@ -0,0 +1,185 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/file_system.h"
+#include "rocksdb/secondary_cache.h"
+#include "rocksdb/slice.h"
+#include "rocksdb/status.h"
+#include "util/hash_containers.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class FileSecondaryCache;
+
+// The result of a FileSecondaryCache::Lookup. A lookup served from a segment
+// buffer in memory is ready immediately, otherwise the handle owns an
+// asynchronous read of the file, completed by Wait() or by WaitAll() on the
+// cache.
+class FileSecondaryCacheResultHandle : public SecondaryCacheResultHandle {
+ public:
+  ~FileSecondaryCacheResultHandle() override;
+
+  FileSecondaryCacheResultHandle(const FileSecondaryCacheResultHandle&) =
+      delete;
+  FileSecondaryCacheResultHandle& operator=(
+      const FileSecondaryCacheResultHandle&) = delete;
+
+  bool IsReady() override { return ready_; }
+
+  void Wait() override;
+
+  void* Value() override { return value_; }
+
+  size_t Size() override { return size_; }
+
+ private:
+  friend class FileSecondaryCache;
+
+  struct Location {
+    uint32_t segment;
+    uint32_t generation;
+    uint32_t offset;
+    // Size of the record, including its checksum
+    uint32_t size;
+  };
+
+  FileSecondaryCacheResultHandle(FileSecondaryCache* cache,
+                                 const Location& loc,
+                                 const Cache::CreateCallback& create_cb);
+
+  // Verify the record in `data` and create the value from it
+  void Complete(const Slice& data);
+  static void OnReadDone(const FSReadRequest& req, void* arg);
+  void ReleaseIOHandle();
+
+  FileSecondaryCache* cache_;
+  Location loc_;
+  Cache::CreateCallback create_cb_;
+  bool ready_ = false;
+  void* value_ = nullptr;
+  size_t size_ = 0;
+  std::unique_ptr<char[]> scratch_;
+  FSReadRequest req_;
+  void* io_handle_ = nullptr;
+  IOHandleDeleter del_fn_;
+};
+
+// See FileSecondaryCacheOptions. Entries are stored as:
+//
+//   RECORD: [CHECKSUM VALUE]
+//
+// CHECKSUM: masked crc32c of VALUE, fixed32
+// VALUE: the persistable data from CacheItemHelper::saveto_cb
+//
+// Each reuse of a segment bumps its generation, which is part of the
+// location of each entry: a read which raced with the reuse of its segment
+// is detected by a generation mismatch on completion, and is a miss.
+class FileSecondaryCache : public SecondaryCache {
+ public:
+  explicit FileSecondaryCache(const FileSecondaryCacheOptions& opts);
+  ~FileSecondaryCache() override;
+
+  // Create the cache file and start the writer thread
+  Status Open();
+
+  const char* Name() const override { return "FileSecondaryCache"; }
+
+  Status Insert(const Slice& key, void* value,
+                const Cache::CacheItemHelper* helper) override;
+
+  std::unique_ptr<SecondaryCacheResultHandle> Lookup(
+      const Slice& key, const Cache::CreateCallback& create_cb, bool wait,
+      bool advise_erase, bool& is_in_sec_cache) override;
+
+  // Space is only reclaimed by reusing whole segments
+  bool SupportForceErase() const override { return false; }
+
+  void Erase(const Slice& key) override;
+
+  void WaitAll(std::vector<SecondaryCacheResultHandle*> handles) override;
+
+  Status GetCapacity(size_t& capacity) override;
+
+  std::string GetPrintableOptions() const override;
+
+  struct Stats {
+    uint64_t lookups = 0;
+    uint64_t hits = 0;
+    // Lookups found in the index which failed on read, checksum or a
+    // concurrent reuse of their segment
+    uint64_t read_failures = 0;
+    uint64_t inserts = 0;
+    // Inserts dropped because the previous segment was still being written
+    uint64_t insert_drops = 0;
+    uint64_t segment_writes = 0;
+    uint64_t evictions = 0;
+  };
+  Stats GetStats() const;
+
+ private:
+  friend class FileSecondaryCacheResultHandle;
+  using Location = FileSecondaryCacheResultHandle::Location;
+
+  static constexpr uint32_t kNoSegment = UINT32_MAX;
+  static constexpr size_t kChecksumSize = sizeof(uint32_t);
+
+  struct SegmentBuffer {
+    std::unique_ptr<char[]> data;
+    uint32_t segment = kNoSegment;
+    size_t used = 0;
+  };
+
+  uint32_t Generation(uint32_t segment) const {
+    return generations_[segment].load(std::memory_order_acquire);
+  }
+  // REQUIRES: mutex_ held. The buffer holding `segment`, or nullptr if it is
+  // only in the file.
+  const SegmentBuffer* BufferOf(uint32_t segment) const;
+  // REQUIRES: mutex_ held. Hand over the full active buffer to the writer
+  // thread and start the next segment, evicting its old entries.
+  void RotateSegment();
+  void WriterThread();
+  void StartRead(FileSecondaryCacheResultHandle* handle);
+
+  const FileSecondaryCacheOptions opts_;
+  const uint32_t num_segments_;
+  std::shared_ptr<FileSystem> fs_;
+  std::unique_ptr<FSRandomRWFile> writer_;
+  std::unique_ptr<FSRandomAccessFile> reader_;
+
+  // Guards the index, the segment bookkeeping and the buffers metadata
+  mutable port::Mutex mutex_;
+  port::CondVar cv_;
+  UnorderedMap<std::string, Location> index_;
+  // Keys appended to each segment, for eviction when it is reused
+  std::vector<std::vector<std::string>> segment_keys_;
+  std::unique_ptr<std::atomic<uint32_t>[]> generations_;
+  SegmentBuffer active_;
+  // The full buffer being written by the writer thread, if segment is not
+  // kNoSegment
+  SegmentBuffer flushing_;
+  bool shutdown_ = false;
+  port::Thread writer_thread_;
+
+  std::atomic<uint64_t> lookups_{0};
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> read_failures_{0};
+  std::atomic<uint64_t> inserts_{0};
+  std::atomic<uint64_t> insert_drops_{0};
+  std::atomic<uint64_t> segment_writes_{0};
+  std::atomic<uint64_t> evictions_{0};
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,323 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "cache/file_secondary_cache.h"
+
+#include <memory>
+#include <string>
+
+#include "rocksdb/convenience.h"
+#include "rocksdb/env.h"
+#include "test_util/testharness.h"
+#include "test_util/testutil.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class FileSecondaryCacheTest : public testing::Test {
+ public:
+  FileSecondaryCacheTest() : env_(Env::Default()) {
+    path_ = test::PerThreadDBPath(env_, "file_secondary_cache");
+  }
+
+ protected:
+  static constexpr size_t kSegmentSize = 4096;
+  // 4 values per segment with their checksums
+  static constexpr size_t kValueSize = 1000;
+
+  class TestItem {
+   public:
+    explicit TestItem(const std::string& data) : data_(data) {}
+    const std::string& Data() const { return data_; }
+
+   private:
+    std::string data_;
+  };
+
+  static size_t SizeCallback(void* obj) {
+    return reinterpret_cast<TestItem*>(obj)->Data().size();
+  }
+
+  static Status SaveToCallback(void* from_obj, size_t from_offset,
+                               size_t length, void* out) {
+    auto item = reinterpret_cast<TestItem*>(from_obj);
+    memcpy(out, item->Data().data() + from_offset, length);
+    return Status::OK();
+  }
+
+  static void DeletionCallback(const Slice& /*key*/, void* obj) {
+    delete reinterpret_cast<TestItem*>(obj);
+  }
+
+  static Cache::CacheItemHelper helper_;
+
+  Cache::CreateCallback test_item_creator = [](const void* buf, size_t size,
+                                               void** out_obj,
+                                               size_t* charge) -> Status {
+    *out_obj = new TestItem(std::string(static_cast<const char*>(buf), size));
+    *charge = size;
+    return Status::OK();
+  };
+
+  std::shared_ptr<FileSecondaryCache> NewCache(size_t num_segments) {
+    FileSecondaryCacheOptions opts;
+    opts.path = path_;
+    opts.capacity = num_segments * kSegmentSize;
+    opts.segment_size = kSegmentSize;
+    auto cache = std::make_shared<FileSecondaryCache>(opts);
+    EXPECT_OK(cache->Open());
+    return cache;
+  }
+
+  std::string Value(int i) {
+    Random rnd(i);
+    return rnd.RandomString(static_cast<int>(kValueSize));
+  }
+
+  void Insert(FileSecondaryCache* cache, int i) {
+    TestItem item(Value(i));
+    ASSERT_OK(cache->Insert(std::to_string(i), &item, &helper_));
+  }
+
+  // Lookup `i` and check its value, returns false on a miss
+  bool Check(FileSecondaryCache* cache, int i, bool wait = true) {
+    bool is_in_sec_cache = false;
+    std::unique_ptr<SecondaryCacheResultHandle> handle = cache->Lookup(
+        std::to_string(i), test_item_creator, wait, true, is_in_sec_cache);
+    if (handle == nullptr) {
+      return false;
+    }
+    EXPECT_TRUE(is_in_sec_cache);
+    if (!wait) {
+      cache->WaitAll({handle.get()});
+    }
+    EXPECT_TRUE(handle->IsReady());
+    std::unique_ptr<TestItem> item(static_cast<TestItem*>(handle->Value()));
+    if (item == nullptr) {
+      return false;
+    }
+    EXPECT_EQ(item->Data(), Value(i));
+    EXPECT_EQ(handle->Size(), kValueSize);
+    return true;
+  }
+
+  // Wait for the writer thread to complete `n` segment writes
+  void WaitForSegmentWrites(FileSecondaryCache* cache, uint64_t n) {
+    for (int i = 0; i < 10000 && cache->GetStats().segment_writes < n; ++i) {
+      env_->SleepForMicroseconds(1000);
+    }
+    ASSERT_EQ(cache->GetStats().segment_writes, n);
+  }
+
+  Env* env_;
+  std::string path_;
+};
+
+Cache::CacheItemHelper FileSecondaryCacheTest::helper_(
+    FileSecondaryCacheTest::SizeCallback,
+    FileSecondaryCacheTest::SaveToCallback,
+    FileSecondaryCacheTest::DeletionCallback);
+
+TEST_F(FileSecondaryCacheTest, InvalidOptions) {
+  FileSecondaryCacheOptions opts;
+  std::shared_ptr<SecondaryCache> cache;
+  ASSERT_TRUE(NewFileSecondaryCache(opts, &cache).IsInvalidArgument());
+  opts.path = path_;
+  opts.segment_size = kSegmentSize;
+  opts.capacity = kSegmentSize + 1;
+  ASSERT_TRUE(NewFileSecondaryCache(opts, &cache).IsInvalidArgument());
+  opts.capacity = 2 * kSegmentSize + 1;
+  ASSERT_OK(NewFileSecondaryCache(opts, &cache));
+  size_t capacity = 0;
+  ASSERT_OK(cache->GetCapacity(capacity));
+  ASSERT_EQ(capacity, 2 * kSegmentSize);
+}
+
+TEST_F(FileSecondaryCacheTest, InsertAndLookup) {
+  auto cache = NewCache(4);
+  ASSERT_FALSE(Check(cache.get(), 0));
+
+  // Served from the active segment buffer
+  for (int i = 0; i < 4; ++i) {
+    Insert(cache.get(), i);
+  }
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(Check(cache.get(), i));
+  }
+
+  // Rotate the first segment to the file, and read it back with both
+  // synchronous and batched lookups
+  Insert(cache.get(), 4);
+  WaitForSegmentWrites(cache.get(), 1);
+  ASSERT_TRUE(Check(cache.get(), 0));
+  ASSERT_TRUE(Check(cache.get(), 1, /*wait=*/false));
+
+  std::vector<std::unique_ptr<SecondaryCacheResultHandle>> handles;
+  std::vector<SecondaryCacheResultHandle*> to_wait;
+  for (int i = 0; i < 5; ++i) {
+    bool is_in_sec_cache = false;
+    handles.emplace_back(cache->Lookup(std::to_string(i), test_item_creator,
+                                       /*wait=*/false, true, is_in_sec_cache));
+    ASSERT_NE(handles.back(), nullptr);
+    to_wait.push_back(handles.back().get());
+  }
+  cache->WaitAll(to_wait);
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(handles[i]->IsReady());
+    std::unique_ptr<TestItem> item(static_cast<TestItem*>(handles[i]->Value()));
+    ASSERT_NE(item, nullptr);
+    ASSERT_EQ(item->Data(), Value(i));
+  }
+
+  // Duplicate keys are ignored
+  Insert(cache.get(), 0);
+  FileSecondaryCache::Stats stats = cache->GetStats();
+  ASSERT_EQ(stats.inserts, 5U);
+  ASSERT_EQ(stats.read_failures, 0U);
+
+  cache->Erase(std::to_string(0));
+  ASSERT_FALSE(Check(cache.get(), 0));
+  ASSERT_TRUE(Check(cache.get(), 1));
+}
+
+TEST_F(FileSecondaryCacheTest, SegmentReuse) {
+  auto cache = NewCache(3);
+  // Fill segments 0, 1 and 2, waiting for each write so nothing is dropped
+  for (int i = 0; i < 12; ++i) {
+    if (i > 0 && i % 4 == 0) {
+      Insert(cache.get(), i);
+      WaitForSegmentWrites(cache.get(), i / 4);
+    } else {
+      Insert(cache.get(), i);
+    }
+  }
+  for (int i = 0; i < 12; ++i) {
+    ASSERT_TRUE(Check(cache.get(), i));
+  }
+  ASSERT_EQ(cache->GetStats().evictions, 0U);
+
+  // Wrapping around reuses segment 0, evicting its entries in FIFO order
+  Insert(cache.get(), 12);
+  WaitForSegmentWrites(cache.get(), 3);
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_FALSE(Check(cache.get(), i));
+  }
+  for (int i = 4; i < 13; ++i) {
+    ASSERT_TRUE(Check(cache.get(), i));
+  }
+  FileSecondaryCache::Stats stats = cache->GetStats();
+  ASSERT_EQ(stats.evictions, 4U);
+  ASSERT_EQ(stats.read_failures, 0U);
+
+  // An evicted key can be inserted again
+  Insert(cache.get(), 0);
+  ASSERT_TRUE(Check(cache.get(), 0));
+}
+
+TEST_F(FileSecondaryCacheTest, PendingLookupOfReusedSegment) {
+  auto cache = NewCache(2);
+  for (int i = 0; i < 5; ++i) {
+    Insert(cache.get(), i);
+  }
+  WaitForSegmentWrites(cache.get(), 1);
+
+  bool is_in_sec_cache = false;
+  std::unique_ptr<SecondaryCacheResultHandle> handle = cache->Lookup(
+      std::to_string(0), test_item_creator, /*wait=*/false, true,
+      is_in_sec_cache);
+  ASSERT_NE(handle, nullptr);
+  if (!handle->IsReady()) {
+    // Reuse segment 0 before the read is completed: the read must be
+    // detected as stale
+    for (int i = 5; i < 9; ++i) {
+      Insert(cache.get(), i);
+    }
+    handle->Wait();
+    ASSERT_TRUE(handle->IsReady());
+    ASSERT_EQ(handle->Value(), nullptr);
+    ASSERT_EQ(cache->GetStats().read_failures, 1U);
+  } else {
+    // Without async IO, the lookup completes synchronously
+    std::unique_ptr<TestItem> item(static_cast<TestItem*>(handle->Value()));
+    ASSERT_NE(item, nullptr);
+    ASSERT_EQ(item->Data(), Value(0));
+  }
+}
+
+TEST_F(FileSecondaryCacheTest, EntryLargerThanSegment) {
+  auto cache = NewCache(2);
+  TestItem item(std::string(kSegmentSize, 'x'));
+  ASSERT_OK(cache->Insert("big", &item, &helper_));
+  bool is_in_sec_cache = true;
+  ASSERT_EQ(cache->Lookup("big", test_item_creator, true, true,
+                          is_in_sec_cache),
+            nullptr);
+  ASSERT_FALSE(is_in_sec_cache);
+  ASSERT_EQ(cache->GetStats().inserts, 0U);
+}
+
+#ifndef ROCKSDB_LITE
+TEST_F(FileSecondaryCacheTest, CreateFromString) {
+  ConfigOptions config_options;
+  std::shared_ptr<SecondaryCache> sec_cache;
+  std::string str = "file_secondary_cache://path=" + path_ +
+                    ";capacity=16384;segment_size=4096";
+  ASSERT_OK(SecondaryCache::CreateFromString(config_options, str, &sec_cache));
+  ASSERT_NE(sec_cache, nullptr);
+  ASSERT_STREQ(sec_cache->Name(), "FileSecondaryCache");
+  size_t capacity = 0;
+  ASSERT_OK(sec_cache->GetCapacity(capacity));
+  ASSERT_EQ(capacity, 16384U);
+}
+#endif  // ROCKSDB_LITE
+
+TEST_F(FileSecondaryCacheTest, WithLRUCache) {
+  FileSecondaryCacheOptions sec_opts;
+  sec_opts.path = path_;
+  sec_opts.capacity = 8 * kSegmentSize;
+  sec_opts.segment_size = kSegmentSize;
+  std::shared_ptr<SecondaryCache> sec_cache;
+  ASSERT_OK(NewFileSecondaryCache(sec_opts, &sec_cache));
+  auto file_cache = static_cast<FileSecondaryCache*>(sec_cache.get());
+
+  LRUCacheOptions lru_opts(2 * kValueSize, 0, false, 0.0);
+  lru_opts.secondary_cache = sec_cache;
+  std::shared_ptr<Cache> cache = NewLRUCache(lru_opts);
+
+  // Each insert evicts the previous entry to the secondary cache
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_OK(cache->Insert(std::to_string(i), new TestItem(Value(i)),
+                            &helper_, kValueSize));
+    if (i > 0 && i % 5 == 0) {
+      WaitForSegmentWrites(file_cache, i / 5);
+    }
+  }
+  ASSERT_GT(file_cache->GetStats().inserts, 0U);
+
+  std::vector<Cache::Handle*> handles;
+  for (int i = 0; i < 6; ++i) {
+    handles.push_back(cache->Lookup(std::to_string(i), &helper_,
+                                    test_item_creator, Cache::Priority::LOW,
+                                    /*wait=*/false));
+  }
+  cache->WaitAll(handles);
+  for (int i = 0; i < 6; ++i) {
+    ASSERT_NE(handles[i], nullptr);
+    auto item = static_cast<TestItem*>(cache->Value(handles[i]));
+    ASSERT_NE(item, nullptr);
+    ASSERT_EQ(item->Data(), Value(i));
+    cache->Release(handles[i]);
+  }
+  ASSERT_EQ(file_cache->GetStats().read_failures, 0U);
+  cache.reset();
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 
+#include "cache/cache_helpers.h"
 #include "cache/cache_key.h"
 #include "cache/clock_cache.h"
 #include "db/db_test_util.h"
@@ -1858,6 +1859,84 @@ TEST_F(LRUCacheSecondaryCacheTest, BasicWaitAllTest) {
   secondary_cache.reset();
 }
 
+namespace {
+int num_cache_wait_yields = 0;
+void CountCacheWaitYield() { num_cache_wait_yields++; }
+}  // namespace
+
+TEST_F(LRUCacheSecondaryCacheTest, LookupWithYieldTest) {
+  LRUCacheOptions opts(1024 /* capacity */, 2 /* num_shard_bits */,
+                       false /* strict_capacity_limit */,
+                       0.5 /* high_pri_pool_ratio */,
+                       nullptr /* memory_allocator */, kDefaultToAdaptiveMutex,
+                       kDontChargeCacheMetadata);
+  std::shared_ptr<TestSecondaryCache> secondary_cache =
+      std::make_shared<TestSecondaryCache>(32 * 1024);
+  opts.secondary_cache = secondary_cache;
+  std::shared_ptr<Cache> cache = NewLRUCache(opts);
+  const int num_keys = 8;
+  OffsetableCacheKey ock{"foo", "bar", 1};
+
+  Random rnd(301);
+  std::vector<std::string> values;
+  for (int i = 0; i < num_keys; ++i) {
+    std::string str = rnd.RandomString(1020);
+    values.emplace_back(str);
+    TestItem* item = new TestItem(str.data(), str.length());
+    ASSERT_OK(cache->Insert(ock.WithOffset(i).AsSlice(), item,
+                            &LRUCacheSecondaryCacheTest::helper_,
+                            str.length()));
+  }
+  // Force all entries to be evicted to the secondary cache
+  cache->SetCapacity(0);
+  cache->SetCapacity(32 * 1024);
+
+  secondary_cache->SetResultMap(
+      {{ock.WithOffset(1).AsSlice().ToString(),
+        TestSecondaryCache::ResultType::DEFER},
+       {ock.WithOffset(2).AsSlice().ToString(),
+        TestSecondaryCache::ResultType::DEFER_AND_FAIL},
+       {ock.WithOffset(3).AsSlice().ToString(),
+        TestSecondaryCache::ResultType::FAIL}});
+  auto lookup = [&](int i) {
+    return LookupWithYield(cache.get(), ock.WithOffset(i).AsSlice(),
+                           &LRUCacheSecondaryCacheTest::helper_,
+                           test_item_creator, Cache::Priority::LOW,
+                           /*stats=*/nullptr);
+  };
+  auto check_and_release = [&](Cache::Handle* handle, int i) {
+    ASSERT_NE(handle, nullptr);
+    TestItem* item = static_cast<TestItem*>(cache->Value(handle));
+    ASSERT_EQ(item->ToString(), values[i]);
+    cache->Release(handle);
+  };
+
+  // Without a yield function, the same as a Lookup with wait=true. Keys with
+  // a DEFER result cannot be used here, TestSecondaryCache ignores wait.
+  ASSERT_EQ(CacheWaitYieldScope::Current(), nullptr);
+  check_and_release(lookup(4), 4);
+  {
+    CacheWaitYieldScope scope(&CountCacheWaitYield);
+    ASSERT_EQ(CacheWaitYieldScope::Current(), &CountCacheWaitYield);
+    // Only pending lookups which are not ready yield
+    check_and_release(lookup(0), 0);
+    ASSERT_EQ(num_cache_wait_yields, 0);
+    check_and_release(lookup(1), 1);
+    ASSERT_EQ(num_cache_wait_yields, 1);
+    ASSERT_EQ(lookup(2), nullptr);
+    ASSERT_EQ(num_cache_wait_yields, 2);
+    ASSERT_EQ(lookup(3), nullptr);
+    // Hits in the primary cache do not yield
+    check_and_release(lookup(1), 1);
+    ASSERT_EQ(lookup(num_keys), nullptr);
+    ASSERT_EQ(num_cache_wait_yields, 2);
+  }
+  ASSERT_EQ(CacheWaitYieldScope::Current(), nullptr);
+
+  cache.reset();
+  secondary_cache.reset();
+}
+
 // In this test, we have one KV pair per data block. We indirectly determine
 // the cache key associated with each data block (and thus each KV) by using
 // a sync point callback in TestSecondaryCache::Lookup. We then control the
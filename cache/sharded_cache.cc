@@ -26,7 +26,8 @@ ShardedCacheBase::ShardedCacheBase(size_t capacity, int num_shard_bits,
       last_id_(1),
       shard_mask_((uint32_t{1} << num_shard_bits) - 1),
       strict_capacity_limit_(strict_capacity_limit),
-      capacity_(capacity) {}
+      capacity_(capacity),
+      admission_shard_capacity_(ComputePerShardCapacity(capacity)) {}
 
 size_t ShardedCacheBase::ComputePerShardCapacity(size_t capacity) const {
   uint32_t num_shards = GetNumShards();
@@ -75,10 +76,92 @@ std::string ShardedCacheBase::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "    memory_allocator : %s\n",
            memory_allocator() ? memory_allocator()->Name() : "None");
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "    admission_policy : %s\n",
+           admission_policy_ ? admission_policy_->Name() : "None");
+  ret.append(buffer);
+  if (admission_policy_) {
+    ret.append(admission_policy_->GetPrintableOptions());
+  }
   AppendPrintableOptions(ret);
   return ret;
 }
 
+void ShardedCacheBase::SetAdmissionPolicy(
+    std::shared_ptr<CacheAdmissionPolicy> policy) {
+  if (policy && !role_counters_) {
+    uint32_t num_shards = GetNumShards();
+    role_counters_.reset(new RoleCounters[num_shards]);
+    for (uint32_t i = 0; i < num_shards; i++) {
+      for (uint32_t r = 0; r < kNumCacheEntryRoles; r++) {
+        role_counters_[i].hits[r].store(0, std::memory_order_relaxed);
+        role_counters_[i].inserts[r].store(0, std::memory_order_relaxed);
+        role_counters_[i].rejects[r].store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+  admission_policy_ = std::move(policy);
+}
+
+std::array<ShardedCacheBase::RoleStats, kNumCacheEntryRoles>
+ShardedCacheBase::GetRoleStats() const {
+  std::array<RoleStats, kNumCacheEntryRoles> stats;
+  if (!role_counters_) {
+    return stats;
+  }
+  uint32_t num_shards = GetNumShards();
+  for (uint32_t i = 0; i < num_shards; i++) {
+    for (uint32_t r = 0; r < kNumCacheEntryRoles; r++) {
+      const RoleCounters& c = role_counters_[i];
+      stats[r].hits += c.hits[r].load(std::memory_order_relaxed);
+      stats[r].inserts += c.inserts[r].load(std::memory_order_relaxed);
+      stats[r].rejects += c.rejects[r].load(std::memory_order_relaxed);
+    }
+  }
+  return stats;
+}
+
+void ShardedCacheBase::RecordLookup(uint64_t admission_hash, bool hit,
+                                    DeleterFn deleter, uint32_t shard) {
+  if (hit) {
+    auto role = static_cast<uint32_t>(GetCacheEntryRoleOfDeleter(deleter));
+    role_counters_[shard].hits[role].fetch_add(1, std::memory_order_relaxed);
+  } else {
+    admission_policy_->RecordMiss(admission_hash);
+  }
+}
+
+bool ShardedCacheBase::AdmitInsert(uint64_t admission_hash, DeleterFn deleter,
+                                   size_t charge, size_t shard_usage,
+                                   uint32_t shard) {
+  CacheEntryRole role = GetCacheEntryRoleOfDeleter(deleter);
+  // Like the window of W-TinyLFU, a shard with room admits everything, so the
+  // sketch only arbitrates between a new entry and existing ones. Lacking
+  // access to the eviction victim of the shard, the policy compares the
+  // frequency of the new entry with a threshold rather than with the victim.
+  bool admit = role != CacheEntryRole::kDataBlock ||
+               shard_usage + charge <=
+                   admission_shard_capacity_.load(std::memory_order_relaxed) ||
+               admission_policy_->Admit(admission_hash, charge);
+  auto& counters = admit ? role_counters_[shard].inserts
+                         : role_counters_[shard].rejects;
+  counters[static_cast<uint32_t>(role)].fetch_add(1,
+                                                  std::memory_order_relaxed);
+  return admit;
+}
+
+Status ShardedCacheBase::RejectInsert(const Slice& key, void* value,
+                                      DeleterFn deleter, Handle** handle) {
+  if (handle == nullptr) {
+    // As if the entry was inserted and immediately evicted
+    if (deleter != nullptr) {
+      (*deleter)(key, value);
+    }
+    return Status::OK();
+  }
+  *handle = nullptr;
+  return Status::Incomplete("Insert rejected by cache admission policy");
+}
+
 int GetDefaultCacheShardBits(size_t capacity, size_t min_shard_size) {
   int num_shard_bits = 0;
   size_t num_shards = capacity / min_shard_size;
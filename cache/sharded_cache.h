@@ -9,11 +9,15 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <cstdint>
+#include <memory>
 #include <string>
 
+#include "cache/cache_entry_roles.h"
 #include "port/lang.h"
+#include "port/likely.h"
 #include "port/port.h"
 #include "rocksdb/cache.h"
 #include "util/hash.h"
@@ -40,6 +44,7 @@ class CacheShardBase {
   static inline uint32_t HashPieceForSharding(HashCref hash) {
     return Lower32of64(hash);
   }
+  static inline uint64_t HashPieceForAdmission(HashCref hash) { return hash; }
   void AppendPrintableOptions(std::string& /*str*/) const {}
 
   // Must be provided for concept CacheShard (TODO with C++20 support)
@@ -107,11 +112,44 @@ class ShardedCacheBase : public Cache {
   size_t GetUsage(Handle* handle) const override;
   std::string GetPrintableOptions() const override;
 
+  // Set the admission policy, see ShardedCacheOptions::admission_policy.
+  // Not thread-safe, must be called before the cache is used.
+  void SetAdmissionPolicy(std::shared_ptr<CacheAdmissionPolicy> policy);
+  const std::shared_ptr<CacheAdmissionPolicy>& GetAdmissionPolicy() const {
+    return admission_policy_;
+  }
+
+  // Lookup hits, admitted inserts and rejected inserts of a CacheEntryRole.
+  // Since a Lookup miss is usually followed by an Insert, the hit ratio of a
+  // role is approximately hits / (hits + inserts + rejects).
+  struct RoleStats {
+    uint64_t hits = 0;
+    uint64_t inserts = 0;
+    uint64_t rejects = 0;
+    double HitRatio() const {
+      uint64_t total = hits + inserts + rejects;
+      return total == 0 ? 0.0 : 1.0 * hits / total;
+    }
+  };
+  // The per role stats are only maintained with an admission policy.
+  std::array<RoleStats, kNumCacheEntryRoles> GetRoleStats() const;
+
  protected:  // fns
   virtual void AppendPrintableOptions(std::string& str) const = 0;
   size_t GetPerShardCapacity() const;
   size_t ComputePerShardCapacity(size_t capacity) const;
 
+  // Bookkeeping of a Lookup with an admission policy: a miss is reported to
+  // the policy, a hit is counted for the role of `deleter`.
+  void RecordLookup(uint64_t admission_hash, bool hit, DeleterFn deleter,
+                    uint32_t shard);
+  // Whether a new entry is admitted into a shard with usage `shard_usage`.
+  bool AdmitInsert(uint64_t admission_hash, DeleterFn deleter, size_t charge,
+                   size_t shard_usage, uint32_t shard);
+  // Complete an Insert which was not admitted
+  static Status RejectInsert(const Slice& key, void* value, DeleterFn deleter,
+                             Handle** handle);
+
  protected:                        // data
   std::atomic<uint64_t> last_id_;  // For NewId
   const uint32_t shard_mask_;
@@ -120,6 +158,17 @@ class ShardedCacheBase : public Cache {
   bool strict_capacity_limit_;
   size_t capacity_;
   mutable port::Mutex config_mutex_;
+
+  // Admission policy, and the per shard state it needs. Counters are per
+  // shard to avoid making all shards contend on the same cache lines.
+  std::shared_ptr<CacheAdmissionPolicy> admission_policy_;
+  std::atomic<size_t> admission_shard_capacity_;
+  struct ALIGN_AS(CACHE_LINE_SIZE) RoleCounters {
+    std::atomic<uint64_t> hits[kNumCacheEntryRoles];
+    std::atomic<uint64_t> inserts[kNumCacheEntryRoles];
+    std::atomic<uint64_t> rejects[kNumCacheEntryRoles];
+  };
+  std::unique_ptr<RoleCounters[]> role_counters_;
 };
 
 // Generic cache interface that shards cache by hash of keys. 2^num_shard_bits
@@ -162,6 +211,7 @@ class ShardedCache : public ShardedCacheBase {
     MutexLock l(&config_mutex_);
     capacity_ = capacity;
     auto per_shard = ComputePerShardCapacity(capacity);
+    admission_shard_capacity_.store(per_shard, std::memory_order_relaxed);
     ForEachShard([=](CacheShard* cs) { cs->SetCapacity(per_shard); });
   }
 
@@ -175,6 +225,10 @@ class ShardedCache : public ShardedCacheBase {
   Status Insert(const Slice& key, void* value, size_t charge, DeleterFn deleter,
                 Handle** handle, Priority priority) override {
     HashVal hash = CacheShard::ComputeHash(key);
+    if (UNLIKELY(admission_policy_ != nullptr) &&
+        !AdmitInsert(hash, deleter, charge)) {
+      return RejectInsert(key, value, deleter, handle);
+    }
     auto h_out = reinterpret_cast<HandleImpl**>(handle);
     return GetShard(hash).Insert(key, hash, value, charge, deleter, h_out,
                                  priority);
@@ -186,6 +240,10 @@ class ShardedCache : public ShardedCacheBase {
       return Status::InvalidArgument();
     }
     HashVal hash = CacheShard::ComputeHash(key);
+    if (UNLIKELY(admission_policy_ != nullptr) &&
+        !AdmitInsert(hash, helper->del_cb, charge)) {
+      return RejectInsert(key, value, helper->del_cb, handle);
+    }
     auto h_out = reinterpret_cast<HandleImpl**>(handle);
     return GetShard(hash).Insert(key, hash, value, helper, charge, h_out,
                                  priority);
@@ -194,6 +252,12 @@ class ShardedCache : public ShardedCacheBase {
   Handle* Lookup(const Slice& key, Statistics* /*stats*/) override {
     HashVal hash = CacheShard::ComputeHash(key);
     HandleImpl* result = GetShard(hash).Lookup(key, hash);
+    if (UNLIKELY(admission_policy_ != nullptr)) {
+      RecordLookup(CacheShard::HashPieceForAdmission(hash), result != nullptr,
+                   result ? GetDeleter(reinterpret_cast<Handle*>(result))
+                          : nullptr,
+                   ShardIndex(hash));
+    }
     return reinterpret_cast<Handle*>(result);
   }
   Handle* Lookup(const Slice& key, const CacheItemHelper* helper,
@@ -202,6 +266,10 @@ class ShardedCache : public ShardedCacheBase {
     HashVal hash = CacheShard::ComputeHash(key);
     HandleImpl* result = GetShard(hash).Lookup(key, hash, helper, create_cb,
                                                priority, wait, stats);
+    if (UNLIKELY(admission_policy_ != nullptr)) {
+      RecordLookup(CacheShard::HashPieceForAdmission(hash), result != nullptr,
+                   helper ? helper->del_cb : nullptr, ShardIndex(hash));
+    }
     return reinterpret_cast<Handle*>(result);
   }
 
@@ -279,6 +347,17 @@ class ShardedCache : public ShardedCacheBase {
   }
 
  protected:
+  inline uint32_t ShardIndex(HashCref hash) const {
+    return CacheShard::HashPieceForSharding(hash) & shard_mask_;
+  }
+
+  inline bool AdmitInsert(HashCref hash, DeleterFn deleter, size_t charge) {
+    uint32_t shard = ShardIndex(hash);
+    return ShardedCacheBase::AdmitInsert(
+        CacheShard::HashPieceForAdmission(hash), deleter, charge,
+        shards_[shard].GetUsage(), shard);
+  }
+
   inline void ForEachShard(const std::function<void(CacheShard*)>& fn) {
     uint32_t num_shards = GetNumShards();
     for (uint32_t i = 0; i < num_shards; i++) {
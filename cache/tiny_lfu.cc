@@ -0,0 +1,130 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "cache/tiny_lfu.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+#include "port/port.h"
+#include "util/math.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+// Odd constants from CityHash, to derive independent row hashes
+constexpr uint64_t kRowSeeds[4] = {0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL,
+                                   0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL};
+constexpr uint64_t kMultiplier = 0x9e3779b97f4a7c15ULL;
+constexpr uint64_t kHalfMask = 0x7777777777777777ULL;
+}  // namespace
+
+FrequencySketch::FrequencySketch(size_t expected_entries,
+                                 uint32_t aging_factor) {
+  // 8 counters per expected entry, half a word
+  size_t min_words = std::max(expected_entries / 2, size_t{2});
+  int bits = FloorLog2(min_words);
+  if ((size_t{1} << bits) < min_words) {
+    ++bits;
+  }
+  num_words_ = size_t{1} << bits;
+  word_shift_ = 64 - bits;
+  aging_period_ =
+      std::max(uint64_t{aging_factor} * expected_entries, uint64_t{1});
+  table_.reset(new std::atomic<uint64_t>[num_words_]);
+  for (size_t i = 0; i < num_words_; ++i) {
+    table_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+inline void FrequencySketch::Locate(uint64_t key_hash, int i, size_t* word,
+                                    int* shift) const {
+  uint64_t h = (key_hash + kRowSeeds[i]) * kMultiplier;
+  // The upper bits of the product depend on all bits of the key hash: use
+  // them for the word, and the 4 bits below for the counter in the word.
+  *word = static_cast<size_t>(h >> word_shift_);
+  *shift = static_cast<int>((h >> (word_shift_ - 4)) & 15) * 4;
+}
+
+void FrequencySketch::Increment(uint64_t key_hash) {
+  bool added = false;
+  for (int i = 0; i < kDepth; ++i) {
+    size_t word;
+    int shift;
+    Locate(key_hash, i, &word, &shift);
+    std::atomic<uint64_t>& w = table_[word];
+    uint64_t old = w.load(std::memory_order_relaxed);
+    while (((old >> shift) & kMaxFrequency) != kMaxFrequency) {
+      if (w.compare_exchange_weak(old, old + (uint64_t{1} << shift),
+                                  std::memory_order_relaxed)) {
+        added = true;
+        break;
+      }
+    }
+  }
+  if (!added) {
+    return;
+  }
+  uint64_t additions = additions_.fetch_add(1, std::memory_order_relaxed) + 1;
+  // Only the thread resetting the count ages the counters. If the CAS loses
+  // to a concurrent increment, the next increment retries.
+  if (additions >= aging_period_ &&
+      additions_.compare_exchange_strong(additions, additions / 2,
+                                         std::memory_order_relaxed)) {
+    Age();
+  }
+}
+
+uint32_t FrequencySketch::Estimate(uint64_t key_hash) const {
+  uint32_t freq = kMaxFrequency;
+  for (int i = 0; i < kDepth; ++i) {
+    size_t word;
+    int shift;
+    Locate(key_hash, i, &word, &shift);
+    uint64_t w = table_[word].load(std::memory_order_relaxed);
+    freq = std::min(freq, static_cast<uint32_t>((w >> shift) & kMaxFrequency));
+  }
+  return freq;
+}
+
+void FrequencySketch::Age() {
+  for (size_t i = 0; i < num_words_; ++i) {
+    uint64_t old = table_[i].load(std::memory_order_relaxed);
+    while (!table_[i].compare_exchange_weak(old, (old >> 1) & kHalfMask,
+                                            std::memory_order_relaxed)) {
+    }
+  }
+}
+
+TinyLFUAdmissionPolicy::TinyLFUAdmissionPolicy(
+    const TinyLFUAdmissionOptions& opts)
+    : sketch_(opts.expected_entries, opts.aging_factor),
+      admission_frequency_(std::min(std::max(opts.admission_frequency, 1U),
+                                    FrequencySketch::kMaxFrequency)) {}
+
+std::string TinyLFUAdmissionPolicy::GetPrintableOptions() const {
+  std::string ret;
+  ret.reserve(200);
+  const int kBufferSize = 200;
+  char buffer[kBufferSize];
+  snprintf(buffer, kBufferSize, "    admission_counters : %" ROCKSDB_PRIszt "\n",
+           sketch_.NumCounters());
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "    admission_frequency : %u\n",
+           admission_frequency_);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "    admission_aging_period : %" PRIu64 "\n",
+           sketch_.AgingPeriod());
+  ret.append(buffer);
+  return ret;
+}
+
+std::shared_ptr<CacheAdmissionPolicy> NewTinyLFUAdmissionPolicy(
+    const TinyLFUAdmissionOptions& opts) {
+  return std::make_shared<TinyLFUAdmissionPolicy>(opts);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
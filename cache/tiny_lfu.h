@@ -0,0 +1,82 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "rocksdb/cache.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A count-min sketch estimating the access frequency of keys, as used by
+// TinyLFU. The counters are 4 bits, packed 16 to a 64-bit word, and each key
+// is counted in 4 of them, chosen by independent hashes of the key; the
+// estimated frequency is the minimum of the 4 counters, saturated at 15.
+//
+// After a sample of `aging_period` increments, every counter is halved, so
+// the sketch keeps adapting to the recent workload, and the influence of an
+// access decays exponentially with the number of periods since it happened.
+//
+// All operations are thread-safe and lock-free. Concurrent aging may lose a
+// few increments, which is acceptable for an estimate.
+class FrequencySketch {
+ public:
+  // `expected_entries` is the number of distinct keys the sketch is expected
+  // to distinguish, it is given 8 counters per expected entry, rounded up to
+  // a power of 2.
+  FrequencySketch(size_t expected_entries, uint32_t aging_factor);
+
+  // Increment the frequency of `key_hash`
+  void Increment(uint64_t key_hash);
+
+  // Return the estimated frequency of `key_hash`, between 0 and 15
+  uint32_t Estimate(uint64_t key_hash) const;
+
+  size_t NumCounters() const { return num_words_ * kCountersPerWord; }
+  uint64_t AgingPeriod() const { return aging_period_; }
+
+  static constexpr uint32_t kMaxFrequency = 15;
+
+ private:
+  static constexpr int kDepth = 4;
+  static constexpr size_t kCountersPerWord = 16;
+
+  // The word and the bit offset within the word of the counter of
+  // `key_hash` in row `i`
+  inline void Locate(uint64_t key_hash, int i, size_t* word,
+                     int* shift) const;
+  void Age();
+
+  size_t num_words_;
+  int word_shift_;
+  uint64_t aging_period_;
+  std::unique_ptr<std::atomic<uint64_t>[]> table_;
+  std::atomic<uint64_t> additions_{0};
+};
+
+class TinyLFUAdmissionPolicy : public CacheAdmissionPolicy {
+ public:
+  explicit TinyLFUAdmissionPolicy(const TinyLFUAdmissionOptions& opts);
+
+  const char* Name() const override { return "TinyLFUAdmissionPolicy"; }
+
+  void RecordMiss(uint64_t key_hash) override { sketch_.Increment(key_hash); }
+
+  bool Admit(uint64_t key_hash, size_t /*charge*/) override {
+    return sketch_.Estimate(key_hash) >= admission_frequency_;
+  }
+
+  std::string GetPrintableOptions() const override;
+
+ private:
+  FrequencySketch sketch_;
+  const uint32_t admission_frequency_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
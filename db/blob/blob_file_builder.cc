@@ -21,6 +21,7 @@
 #include "logging/logging.h"
 #include "options/cf_options.h"
 #include "options/options_helper.h"
+#include "rocksdb/blob_separation_policy.h"
 #include "rocksdb/slice.h"
 #include "rocksdb/status.h"
 #include "test_util/sync_point.h"
@@ -64,6 +65,7 @@ BlobFileBuilder::BlobFileBuilder(
       fs_(fs),
       immutable_options_(immutable_options),
       min_blob_size_(mutable_cf_options->min_blob_size),
+      separation_policy_(immutable_options->blob_separation_policy.get()),
       blob_file_size_(mutable_cf_options->blob_file_size),
       blob_compression_type_(mutable_cf_options->blob_compression_type),
       prepopulate_blob_cache_(mutable_cf_options->prepopulate_blob_cache),
@@ -99,7 +101,14 @@ Status BlobFileBuilder::Add(const Slice& key, const Slice& value,
   assert(blob_index);
   assert(blob_index->empty());
 
-  if (value.size() < min_blob_size_) {
+  if (separation_policy_) {
+    BlobSeparationContext ctx;
+    ctx.min_blob_size = min_blob_size_;
+    ctx.reason = creation_reason_;
+    if (!separation_policy_->ShouldSeparate(key, value, ctx)) {
+      return Status::OK();
+    }
+  } else if (value.size() < min_blob_size_) {
     return Status::OK();
   }
 
@@ -154,6 +163,12 @@ Status BlobFileBuilder::Add(const Slice& key, const Slice& value,
   return Status::OK();
 }
 
+void BlobFileBuilder::OnOverwritten(const Slice& key) {
+  if (separation_policy_) {
+    separation_policy_->OnOverwritten(key);
+  }
+}
+
 Status BlobFileBuilder::Finish() {
   if (!IsBlobFileOpen()) {
     return Status::OK();
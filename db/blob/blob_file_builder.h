@@ -30,6 +30,7 @@ class Slice;
 class BlobLogWriter;
 class IOTracer;
 class BlobFileCompletionCallback;
+class BlobSeparationPolicy;
 
 class BlobFileBuilder {
  public:
@@ -69,6 +70,8 @@ class BlobFileBuilder {
   ~BlobFileBuilder();
 
   Status Add(const Slice& key, const Slice& value, std::string* blob_index);
+  // A value of key was dropped because a newer value hides it
+  void OnOverwritten(const Slice& key);
   Status Finish();
   void Abandon(const Status& s);
 
@@ -88,6 +91,7 @@ class BlobFileBuilder {
   FileSystem* fs_;
   const ImmutableOptions* immutable_options_;
   uint64_t min_blob_size_;
+  BlobSeparationPolicy* separation_policy_;
   uint64_t blob_file_size_;
   CompressionType blob_compression_type_;
   PrepopulateBlobCache prepopulate_blob_cache_;
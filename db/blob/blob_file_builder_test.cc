@@ -341,6 +341,73 @@ TEST_F(BlobFileBuilderTest, InlinedValues) {
   ASSERT_TRUE(blob_file_additions.empty());
 }
 
+TEST_F(BlobFileBuilderTest, AdaptiveSeparationPolicy) {
+  // Values of the frequently overwritten prefix "hot" are kept inline once
+  // its statistics are learned, values of "cold" always go to blob files
+  constexpr size_t value_size = 100;
+
+  Options options;
+  options.cf_paths.emplace_back(
+      test::PerThreadDBPath(mock_env_.get(),
+                            "BlobFileBuilderTest_AdaptiveSeparationPolicy"),
+      0);
+  options.enable_blob_files = true;
+  options.min_blob_size = 10;
+  options.env = mock_env_.get();
+
+  AdaptiveBlobSeparationOptions policy_opts;
+  policy_opts.prefix_length = 3;
+  policy_opts.min_samples = 8;
+  options.blob_separation_policy =
+      NewAdaptiveBlobSeparationPolicy(policy_opts);
+
+  ImmutableOptions immutable_options(options);
+  MutableCFOptions mutable_cf_options(options);
+
+  constexpr int job_id = 1;
+  constexpr uint32_t column_family_id = 123;
+  constexpr char column_family_name[] = "foobar";
+  constexpr Env::IOPriority io_priority = Env::IO_HIGH;
+  constexpr Env::WriteLifeTimeHint write_hint = Env::WLTH_MEDIUM;
+
+  std::vector<std::string> blob_file_paths;
+  std::vector<BlobFileAddition> blob_file_additions;
+
+  BlobFileBuilder builder(
+      TestFileNumberGenerator(), fs_, &immutable_options, &mutable_cf_options,
+      &file_options_, "" /*db_id*/, "" /*db_session_id*/, job_id,
+      column_family_id, column_family_name, io_priority, write_hint,
+      nullptr /*IOTracer*/, nullptr /*BlobFileCompletionCallback*/,
+      BlobFileCreationReason::kFlush, &blob_file_paths, &blob_file_additions);
+
+  const std::string value(value_size, 'v');
+  size_t hot_separated = 0;
+  for (size_t i = 0; i < 32; ++i) {
+    const std::string hot_key = "hot" + std::to_string(i % 4);
+    builder.OnOverwritten(hot_key);
+    builder.OnOverwritten(hot_key);
+
+    std::string blob_index;
+    ASSERT_OK(builder.Add(hot_key, value, &blob_index));
+    if (!blob_index.empty()) {
+      ++hot_separated;
+      ASSERT_LT(i, policy_opts.min_samples);
+    }
+
+    blob_index.clear();
+    ASSERT_OK(builder.Add("cold" + std::to_string(i), value, &blob_index));
+    ASSERT_FALSE(blob_index.empty());
+  }
+  ASSERT_EQ(hot_separated, policy_opts.min_samples - 1);
+
+  ASSERT_OK(builder.Finish());
+
+  ASSERT_EQ(blob_file_paths.size(), 1);
+  ASSERT_EQ(blob_file_additions.size(), 1);
+  ASSERT_EQ(blob_file_additions[0].GetTotalBlobCount(),
+            32 + hot_separated);
+}
+
 TEST_F(BlobFileBuilderTest, Compression) {
   // Build a blob file with a compressed blob
   if (!Snappy_Supported()) {
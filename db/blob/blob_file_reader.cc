@@ -324,10 +324,18 @@ Status BlobFileReader::GetBlob(
     Status s;
     constexpr bool for_compaction = true;
 
-    prefetched = prefetch_buffer->TryReadFromCache(
-        IOOptions(), file_reader_.get(), record_offset,
-        static_cast<size_t>(record_size), &record_slice, &s,
-        read_options.rate_limiter_priority, for_compaction);
+    if (read_options.async_io) {
+      // the buffer reads the rest of its readahead in the background
+      prefetched = prefetch_buffer->TryReadFromCacheAsync(
+          IOOptions(), file_reader_.get(), record_offset,
+          static_cast<size_t>(record_size), &record_slice, &s,
+          read_options.rate_limiter_priority);
+    } else {
+      prefetched = prefetch_buffer->TryReadFromCache(
+          IOOptions(), file_reader_.get(), record_offset,
+          static_cast<size_t>(record_size), &record_slice, &s,
+          read_options.rate_limiter_priority, for_compaction);
+    }
     if (!s.ok()) {
       return s;
     }
@@ -374,11 +382,73 @@ Status BlobFileReader::GetBlob(
   return Status::OK();
 }
 
+BlobFileReader::MultiGetBlobReads::~MultiGetBlobReads() {
+  for (size_t i = 0; i < io_handles.size(); ++i) {
+    if (io_handles[i] != nullptr && del_fns[i]) {
+      del_fns[i](io_handles[i]);
+    }
+  }
+}
+
 void BlobFileReader::MultiGetBlob(
     const ReadOptions& read_options, MemoryAllocator* allocator,
     autovector<std::pair<BlobReadRequest*, std::unique_ptr<BlobContents>>>&
         blob_reqs,
     uint64_t* bytes_read) const {
+  MultiGetBlobReads reads;
+  PrepareMultiGetBlob(read_options, blob_reqs, &reads);
+  TEST_SYNC_POINT("BlobFileReader::MultiGetBlob:ReadFromFile");
+  reads.status = file_reader_->MultiRead(
+      IOOptions(), reads.read_reqs.data(), reads.read_reqs.size(),
+      file_reader_->use_direct_io() ? &reads.aligned_buf : nullptr,
+      read_options.rate_limiter_priority);
+  FinishMultiGetBlob(read_options, allocator, blob_reqs, &reads, bytes_read);
+}
+
+void BlobFileReader::SubmitMultiGetBlob(
+    const ReadOptions& read_options,
+    autovector<std::pair<BlobReadRequest*, std::unique_ptr<BlobContents>>>&
+        blob_reqs,
+    MultiGetBlobReads* reads) const {
+  PrepareMultiGetBlob(read_options, blob_reqs, reads);
+  TEST_SYNC_POINT("BlobFileReader::MultiGetBlob:ReadFromFile");
+  if (file_reader_->use_direct_io()) {
+    // ReadAsync needs caller provided scratch, which direct IO does not have
+    reads->status = file_reader_->MultiRead(
+        IOOptions(), reads->read_reqs.data(), reads->read_reqs.size(),
+        &reads->aligned_buf, read_options.rate_limiter_priority);
+    return;
+  }
+  IOOptions opts;
+  opts.rate_limiter_priority = read_options.rate_limiter_priority;
+  const size_t num_reads = reads->read_reqs.size();
+  reads->io_handles.resize(num_reads, nullptr);
+  reads->del_fns.resize(num_reads);
+  auto on_done = [](const FSReadRequest& done, void* cb_arg) {
+    auto* read_req = static_cast<FSReadRequest*>(cb_arg);
+    read_req->result = done.result;
+    read_req->status = done.status;
+  };
+  for (size_t i = 0; i < num_reads; ++i) {
+    FSReadRequest& read_req = reads->read_reqs[i];
+    IOStatus s = file_reader_->ReadAsync(read_req, opts, on_done, &read_req,
+                                         &reads->io_handles[i],
+                                         &reads->del_fns[i], nullptr);
+    if (!s.ok()) {
+      // The file system can not read this one asynchronously
+      reads->io_handles[i] = nullptr;
+      read_req.status = file_reader_->Read(
+          opts, read_req.offset, read_req.len, &read_req.result,
+          read_req.scratch, nullptr, read_options.rate_limiter_priority);
+    }
+  }
+}
+
+void BlobFileReader::PrepareMultiGetBlob(
+    const ReadOptions& read_options,
+    autovector<std::pair<BlobReadRequest*, std::unique_ptr<BlobContents>>>&
+        blob_reqs,
+    MultiGetBlobReads* reads) const {
   const size_t num_blobs = blob_reqs.size();
   assert(num_blobs > 0);
   assert(num_blobs <= MultiGetContext::MAX_BATCH_SIZE);
@@ -389,8 +459,7 @@ void BlobFileReader::MultiGetBlob(
   }
 #endif  // !NDEBUG
 
-  std::vector<FSReadRequest> read_reqs;
-  autovector<uint64_t> adjustments;
+  auto& read_reqs = reads->read_reqs;
   uint64_t total_len = 0;
   read_reqs.reserve(num_blobs);
   for (size_t i = 0; i < num_blobs; ++i) {
@@ -418,7 +487,7 @@ void BlobFileReader::MultiGetBlob(
             ? BlobLogRecord::CalculateAdjustmentForRecordHeader(key_size)
             : 0;
     assert(req->offset >= adjustment);
-    adjustments.push_back(adjustment);
+    reads->adjustments.push_back(adjustment);
 
     FSReadRequest read_req = {};
     read_req.offset = req->offset - adjustment;
@@ -429,29 +498,30 @@ void BlobFileReader::MultiGetBlob(
 
   RecordTick(statistics_, BLOB_DB_BLOB_FILE_BYTES_READ, total_len);
 
-  Buffer buf;
-  AlignedBuf aligned_buf;
-
-  Status s;
-  bool direct_io = file_reader_->use_direct_io();
-  if (direct_io) {
+  if (file_reader_->use_direct_io()) {
     for (size_t i = 0; i < read_reqs.size(); ++i) {
       read_reqs[i].scratch = nullptr;
     }
   } else {
-    buf.reset(new char[total_len]);
+    reads->buf.reset(new char[total_len]);
     std::ptrdiff_t pos = 0;
     for (size_t i = 0; i < read_reqs.size(); ++i) {
-      read_reqs[i].scratch = buf.get() + pos;
+      read_reqs[i].scratch = reads->buf.get() + pos;
       pos += read_reqs[i].len;
     }
   }
-  TEST_SYNC_POINT("BlobFileReader::MultiGetBlob:ReadFromFile");
   PERF_COUNTER_ADD(blob_read_count, num_blobs);
   PERF_COUNTER_ADD(blob_read_byte, total_len);
-  s = file_reader_->MultiRead(IOOptions(), read_reqs.data(), read_reqs.size(),
-                              direct_io ? &aligned_buf : nullptr,
-                              read_options.rate_limiter_priority);
+}
+
+void BlobFileReader::FinishMultiGetBlob(
+    const ReadOptions& read_options, MemoryAllocator* allocator,
+    autovector<std::pair<BlobReadRequest*, std::unique_ptr<BlobContents>>>&
+        blob_reqs,
+    MultiGetBlobReads* reads, uint64_t* bytes_read) const {
+  const size_t num_blobs = blob_reqs.size();
+  auto& read_reqs = reads->read_reqs;
+  const Status& s = reads->status;
   if (!s.ok()) {
     for (auto& req : read_reqs) {
       req.status.PermitUncheckedError();
@@ -483,6 +553,7 @@ void BlobFileReader::MultiGetBlob(
     }
 
     assert(j < read_reqs.size());
+    const uint64_t adjustment = reads->adjustments[j];
     auto& read_req = read_reqs[j++];
     const auto& record_slice = read_req.result;
     if (read_req.status.ok() && record_slice.size() != read_req.len) {
@@ -504,7 +575,7 @@ void BlobFileReader::MultiGetBlob(
     }
 
     // Uncompress blob if needed
-    Slice value_slice(record_slice.data() + adjustments[i], req->len);
+    Slice value_slice(record_slice.data() + adjustment, req->len);
     *req->status =
         UncompressBlobIfNeeded(value_slice, compression_type_, allocator,
                                clock_, statistics_, &blob_reqs[i].second);
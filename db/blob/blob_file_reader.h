@@ -7,6 +7,7 @@
 
 #include <cinttypes>
 #include <memory>
+#include <vector>
 
 #include "db/blob/blob_read_request.h"
 #include "file/random_access_file_reader.h"
@@ -56,6 +57,37 @@ class BlobFileReader {
           blob_reqs,
       uint64_t* bytes_read) const;
 
+  // The reads of one MultiGetBlob between SubmitMultiGetBlob() and
+  // FinishMultiGetBlob(). The io_handles must be polled in between, so that
+  // the reads of many blob files can be in flight at once.
+  struct MultiGetBlobReads {
+    std::vector<FSReadRequest> read_reqs;
+    autovector<uint64_t> adjustments;
+    std::unique_ptr<char[]> buf;
+    AlignedBuf aligned_buf;
+    std::vector<void*> io_handles;  // nullptr if completed synchronously
+    std::vector<IOHandleDeleter> del_fns;
+    Status status;
+
+    ~MultiGetBlobReads();
+  };
+
+  // Issues the reads of MultiGetBlob() with ReadAsync, offsets must be sorted
+  // in ascending order by caller.
+  void SubmitMultiGetBlob(
+      const ReadOptions& read_options,
+      autovector<std::pair<BlobReadRequest*, std::unique_ptr<BlobContents>>>&
+          blob_reqs,
+      MultiGetBlobReads* reads) const;
+
+  // Verifies and uncompresses the blobs read by SubmitMultiGetBlob() after
+  // all of its io_handles are polled.
+  void FinishMultiGetBlob(
+      const ReadOptions& read_options, MemoryAllocator* allocator,
+      autovector<std::pair<BlobReadRequest*, std::unique_ptr<BlobContents>>>&
+          blob_reqs,
+      MultiGetBlobReads* reads, uint64_t* bytes_read) const;
+
   CompressionType GetCompressionType() const { return compression_type_; }
 
   uint64_t GetFileSize() const { return file_size_; }
@@ -88,6 +120,12 @@ class BlobFileReader {
                              AlignedBuf* aligned_buf,
                              Env::IOPriority rate_limiter_priority);
 
+  void PrepareMultiGetBlob(
+      const ReadOptions& read_options,
+      autovector<std::pair<BlobReadRequest*, std::unique_ptr<BlobContents>>>&
+          blob_reqs,
+      MultiGetBlobReads* reads) const;
+
   static Status VerifyBlob(const Slice& record_slice, const Slice& user_key,
                            uint64_t value_size);
 
@@ -0,0 +1,166 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "rocksdb/blob_separation_policy.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/slice_transform.h"
+#include "util/hash.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+class AdaptiveBlobSeparationPolicy : public BlobSeparationPolicy {
+ public:
+  explicit AdaptiveBlobSeparationPolicy(
+      const AdaptiveBlobSeparationOptions& opts)
+      : opts_(opts) {
+    opts_.min_samples = std::max<uint64_t>(opts_.min_samples, 1);
+    opts_.decay_samples =
+        std::max<uint64_t>(opts_.decay_samples, 2 * opts_.min_samples);
+  }
+
+  const char* Name() const override { return "AdaptiveBlobSeparationPolicy"; }
+
+  bool ShouldSeparate(const Slice& user_key, const Slice& value,
+                      const BlobSeparationContext& ctx) override {
+    const uint64_t size = value.size();
+    const Slice prefix = GetPrefix(user_key);
+    Shard& shard = GetShard(prefix);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    PrefixStats* stats = FindOrAdd(shard, prefix);
+    if (!stats) {
+      return size >= ctx.min_blob_size;
+    }
+    // values rewritten by compaction were counted when they were flushed
+    if (BlobFileCreationReason::kFlush == ctx.reason) {
+      stats->flushed++;
+      stats->flushed_bytes += size;
+      if (stats->flushed >= opts_.decay_samples) {
+        stats->Decay();
+      }
+    }
+    bool separate = size >= ctx.min_blob_size;
+    if (separate && stats->flushed >= opts_.min_samples &&
+        size < opts_.max_hot_inline_size &&
+        stats->overwritten >= opts_.hot_overwrite_ratio * stats->flushed) {
+      separate = false;
+    }
+    if (separate) {
+      stats->separated++;
+    } else {
+      stats->inlined++;
+    }
+    return separate;
+  }
+
+  void OnOverwritten(const Slice& user_key) override {
+    const Slice prefix = GetPrefix(user_key);
+    Shard& shard = GetShard(prefix);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    PrefixStats* stats = FindOrAdd(shard, prefix);
+    if (stats) {
+      stats->overwritten++;
+    }
+  }
+
+  std::string GetPrintableStats() const override {
+    std::vector<std::pair<std::string, PrefixStats> > all;
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      all.insert(all.end(), shard.map.begin(), shard.map.end());
+    }
+    const size_t num_prefixes = all.size();
+    const size_t top = std::min<size_t>(num_prefixes, 16);
+    std::partial_sort(all.begin(), all.begin() + top, all.end(),
+                      [](const auto& x, const auto& y) {
+                        return x.second.flushed > y.second.flushed;
+                      });
+    char buf[256];
+    snprintf(buf, sizeof(buf), "prefixes: %" ROCKSDB_PRIszt "\n",
+             num_prefixes);
+    std::string res = buf;
+    for (size_t i = 0; i < top; i++) {
+      const PrefixStats& s = all[i].second;
+      const uint64_t total = s.separated + s.inlined;
+      snprintf(buf, sizeof(buf),
+               "  %s: flushed %" PRIu64 ", overwritten %" PRIu64
+               ", avg size %.1f, separated %.3f\n",
+               Slice(all[i].first).ToString(true).c_str(), s.flushed,
+               s.overwritten,
+               s.flushed ? double(s.flushed_bytes) / s.flushed : 0.0,
+               total ? double(s.separated) / total : 0.0);
+      res += buf;
+    }
+    return res;
+  }
+
+ private:
+  struct PrefixStats {
+    uint64_t flushed = 0;
+    uint64_t flushed_bytes = 0;
+    uint64_t overwritten = 0;
+    uint64_t separated = 0;
+    uint64_t inlined = 0;
+    void Decay() {
+      flushed /= 2;
+      flushed_bytes /= 2;
+      overwritten /= 2;
+    }
+  };
+  static constexpr size_t kNumShards = 16;
+  struct Shard {
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, PrefixStats> map;
+  };
+
+  Slice GetPrefix(const Slice& user_key) const {
+    if (opts_.prefix_extractor) {
+      // keys out of the domain share the empty prefix
+      if (opts_.prefix_extractor->InDomain(user_key)) {
+        return opts_.prefix_extractor->Transform(user_key);
+      }
+      return Slice();
+    }
+    return Slice(user_key.data(),
+                 std::min(user_key.size(), opts_.prefix_length));
+  }
+
+  Shard& GetShard(const Slice& prefix) {
+    return shards_[GetSliceNPHash64(prefix) % kNumShards];
+  }
+
+  PrefixStats* FindOrAdd(Shard& shard, const Slice& prefix) {
+    std::string key = prefix.ToString();
+    auto iter = shard.map.find(key);
+    if (shard.map.end() != iter) {
+      return &iter->second;
+    }
+    if (shard.map.size() * kNumShards >= opts_.max_prefixes) {
+      return nullptr;
+    }
+    return &shard.map[std::move(key)];
+  }
+
+  AdaptiveBlobSeparationOptions opts_;
+  Shard shards_[kNumShards];
+};
+
+}  // namespace
+
+std::shared_ptr<BlobSeparationPolicy> NewAdaptiveBlobSeparationPolicy(
+    const AdaptiveBlobSeparationOptions& opts) {
+  return std::make_shared<AdaptiveBlobSeparationPolicy>(opts);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -27,6 +27,7 @@ BlobSource::BlobSource(const ImmutableOptions* immutable_options,
     : db_id_(db_id),
       db_session_id_(db_session_id),
       statistics_(immutable_options->statistics.get()),
+      fs_(immutable_options->fs.get()),
       blob_file_cache_(blob_file_cache),
       blob_cache_(immutable_options->blob_cache),
       lowest_used_cache_tier_(immutable_options->lowest_used_cache_tier) {
@@ -301,11 +302,51 @@ void BlobSource::MultiGetBlob(const ReadOptions& read_options,
         [](const BlobReadRequest& lhs, const BlobReadRequest& rhs) -> bool {
           return lhs.offset < rhs.offset;
         });
+  }
 
-    MultiGetBlobFromOneFile(read_options, file_number, file_size,
-                            blob_reqs_in_file, &bytes_read_in_file);
+  if (!read_options.async_io || blob_reqs.size() == 1) {
+    for (auto& [file_number, file_size, blob_reqs_in_file] : blob_reqs) {
+      MultiGetBlobFromOneFile(read_options, file_number, file_size,
+                              blob_reqs_in_file, &bytes_read_in_file);
 
-    total_bytes_read += bytes_read_in_file;
+      total_bytes_read += bytes_read_in_file;
+    }
+  } else {
+    // Submit the reads of all files before waiting for any of them, the
+    // completions arrive in any order
+    std::vector<std::unique_ptr<OneFileMultiGet>> files;
+    std::vector<void*> io_handles;
+    files.reserve(blob_reqs.size());
+    for (auto& [file_number, file_size, blob_reqs_in_file] : blob_reqs) {
+      std::unique_ptr<OneFileMultiGet> file(new OneFileMultiGet);
+      if (StartMultiGetBlobFromOneFile(read_options, file_number,
+                                       blob_reqs_in_file, true /* async */,
+                                       file.get())) {
+        for (void* io_handle : file->reads.io_handles) {
+          if (io_handle != nullptr) {
+            io_handles.push_back(io_handle);
+          }
+        }
+        files.push_back(std::move(file));
+      } else {
+        total_bytes_read += file->total_bytes;
+      }
+    }
+    TEST_SYNC_POINT_CALLBACK("BlobSource::MultiGetBlob:Poll", &io_handles);
+    if (!io_handles.empty()) {
+      IOStatus s = fs_->Poll(io_handles, io_handles.size());
+      if (!s.ok()) {
+        fs_->AbortIO(io_handles).PermitUncheckedError();
+        for (auto& file : files) {
+          file->reads.status = s;
+        }
+      }
+    }
+    for (auto& file : files) {
+      FinishMultiGetBlobFromOneFile(read_options, true /* async */,
+                                    file.get());
+      total_bytes_read += file->total_bytes;
+    }
   }
 
   if (bytes_read) {
@@ -318,6 +359,20 @@ void BlobSource::MultiGetBlobFromOneFile(const ReadOptions& read_options,
                                          uint64_t /*file_size*/,
                                          autovector<BlobReadRequest>& blob_reqs,
                                          uint64_t* bytes_read) {
+  OneFileMultiGet file;
+  if (StartMultiGetBlobFromOneFile(read_options, file_number, blob_reqs,
+                                   false /* async */, &file)) {
+    FinishMultiGetBlobFromOneFile(read_options, false /* async */, &file);
+  }
+  if (bytes_read) {
+    *bytes_read = file.total_bytes;
+  }
+}
+
+bool BlobSource::StartMultiGetBlobFromOneFile(
+    const ReadOptions& read_options, uint64_t file_number,
+    autovector<BlobReadRequest>& blob_reqs, bool async,
+    OneFileMultiGet* file) {
   const size_t num_blobs = blob_reqs.size();
   assert(num_blobs > 0);
   assert(num_blobs <= MultiGetContext::MAX_BATCH_SIZE);
@@ -331,8 +386,10 @@ void BlobSource::MultiGetBlobFromOneFile(const ReadOptions& read_options,
   using Mask = uint64_t;
   Mask cache_hit_mask = 0;
 
-  uint64_t total_bytes = 0;
-  const OffsetableCacheKey base_cache_key(db_id_, db_session_id_, file_number);
+  uint64_t& total_bytes = file->total_bytes;
+  file->base_cache_key =
+      OffsetableCacheKey(db_id_, db_session_id_, file_number);
+  const OffsetableCacheKey& base_cache_key = file->base_cache_key;
 
   if (blob_cache_) {
     size_t cached_blob_count = 0;
@@ -369,10 +426,7 @@ void BlobSource::MultiGetBlobFromOneFile(const ReadOptions& read_options,
 
     // All blobs were read from the cache.
     if (cached_blob_count == num_blobs) {
-      if (bytes_read) {
-        *bytes_read = total_bytes;
-      }
-      return;
+      return false;
     }
   }
 
@@ -387,77 +441,87 @@ void BlobSource::MultiGetBlobFromOneFile(const ReadOptions& read_options,
             Status::Incomplete("Cannot read blob(s): no disk I/O allowed");
       }
     }
-    return;
+    return false;
   }
 
-  {
-    // Find the rest of blobs from the file since I/O is allowed.
-    autovector<std::pair<BlobReadRequest*, std::unique_ptr<BlobContents>>>
-        _blob_reqs;
-    uint64_t _bytes_read = 0;
-
-    for (size_t i = 0; i < num_blobs; ++i) {
-      if (!(cache_hit_mask & (Mask{1} << i))) {
-        _blob_reqs.emplace_back(&blob_reqs[i], std::unique_ptr<BlobContents>());
-      }
+  // Find the rest of blobs from the file since I/O is allowed.
+  auto& _blob_reqs = file->blob_reqs;
+  for (size_t i = 0; i < num_blobs; ++i) {
+    if (!(cache_hit_mask & (Mask{1} << i))) {
+      _blob_reqs.emplace_back(&blob_reqs[i], std::unique_ptr<BlobContents>());
     }
+  }
 
-    CacheHandleGuard<BlobFileReader> blob_file_reader;
-    Status s =
-        blob_file_cache_->GetBlobFileReader(file_number, &blob_file_reader);
-    if (!s.ok()) {
-      for (size_t i = 0; i < _blob_reqs.size(); ++i) {
-        BlobReadRequest* const req = _blob_reqs[i].first;
-        assert(req);
-        assert(req->status);
+  Status s = blob_file_cache_->GetBlobFileReader(file_number,
+                                                 &file->blob_file_reader);
+  if (!s.ok()) {
+    for (size_t i = 0; i < _blob_reqs.size(); ++i) {
+      BlobReadRequest* const req = _blob_reqs[i].first;
+      assert(req);
+      assert(req->status);
 
-        *req->status = s;
-      }
-      return;
+      *req->status = s;
     }
+    return false;
+  }
 
-    assert(blob_file_reader.GetValue());
+  assert(file->blob_file_reader.GetValue());
 
-    MemoryAllocator* const allocator = (blob_cache_ && read_options.fill_cache)
-                                           ? blob_cache_->memory_allocator()
-                                           : nullptr;
+  if (async) {
+    file->blob_file_reader.GetValue()->SubmitMultiGetBlob(
+        read_options, _blob_reqs, &file->reads);
+  }
+  return true;
+}
 
-    blob_file_reader.GetValue()->MultiGetBlob(read_options, allocator,
-                                              _blob_reqs, &_bytes_read);
-
-    if (blob_cache_ && read_options.fill_cache) {
-      // If filling cache is allowed and a cache is configured, try to put
-      // the blob(s) to the cache.
-      for (auto& [req, blob_contents] : _blob_reqs) {
-        assert(req);
-
-        if (req->status->ok()) {
-          CacheHandleGuard<BlobContents> blob_handle;
-          const CacheKey cache_key = base_cache_key.WithOffset(req->offset);
-          const Slice key = cache_key.AsSlice();
-          s = PutBlobIntoCache(key, &blob_contents, &blob_handle);
-          if (!s.ok()) {
-            *req->status = s;
-          } else {
-            PinCachedBlob(&blob_handle, req->result);
-          }
-        }
-      }
-    } else {
-      for (auto& [req, blob_contents] : _blob_reqs) {
-        assert(req);
+void BlobSource::FinishMultiGetBlobFromOneFile(const ReadOptions& read_options,
+                                               bool async,
+                                               OneFileMultiGet* file) {
+  auto& _blob_reqs = file->blob_reqs;
+  const BlobFileReader* blob_file_reader = file->blob_file_reader.GetValue();
+  uint64_t _bytes_read = 0;
+
+  MemoryAllocator* const allocator = (blob_cache_ && read_options.fill_cache)
+                                         ? blob_cache_->memory_allocator()
+                                         : nullptr;
+
+  if (async) {
+    blob_file_reader->FinishMultiGetBlob(read_options, allocator, _blob_reqs,
+                                         &file->reads, &_bytes_read);
+  } else {
+    blob_file_reader->MultiGetBlob(read_options, allocator, _blob_reqs,
+                                   &_bytes_read);
+  }
 
-        if (req->status->ok()) {
-          PinOwnedBlob(&blob_contents, req->result);
+  if (blob_cache_ && read_options.fill_cache) {
+    // If filling cache is allowed and a cache is configured, try to put
+    // the blob(s) to the cache.
+    for (auto& [req, blob_contents] : _blob_reqs) {
+      assert(req);
+
+      if (req->status->ok()) {
+        CacheHandleGuard<BlobContents> blob_handle;
+        const CacheKey cache_key = file->base_cache_key.WithOffset(req->offset);
+        const Slice key = cache_key.AsSlice();
+        Status s = PutBlobIntoCache(key, &blob_contents, &blob_handle);
+        if (!s.ok()) {
+          *req->status = s;
+        } else {
+          PinCachedBlob(&blob_handle, req->result);
         }
       }
     }
+  } else {
+    for (auto& [req, blob_contents] : _blob_reqs) {
+      assert(req);
 
-    total_bytes += _bytes_read;
-    if (bytes_read) {
-      *bytes_read = total_bytes;
+      if (req->status->ok()) {
+        PinOwnedBlob(&blob_contents, req->result);
+      }
     }
   }
+
+  file->total_bytes += _bytes_read;
 }
 
 bool BlobSource::TEST_BlobInCache(uint64_t file_number, uint64_t file_size,
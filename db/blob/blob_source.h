@@ -11,6 +11,7 @@
 #include "cache/cache_helpers.h"
 #include "cache/cache_key.h"
 #include "db/blob/blob_file_cache.h"
+#include "db/blob/blob_file_reader.h"
 #include "db/blob/blob_read_request.h"
 #include "rocksdb/cache.h"
 #include "rocksdb/rocksdb_namespace.h"
@@ -66,6 +67,9 @@ class BlobSource {
   //  - The main difference between this function and MultiGetBlobFromOneFile is
   //    that this function can read multiple blobs from multiple blob files.
   //
+  //  - With read_options.async_io, the reads of all blob files are submitted
+  //    with ReadAsync before waiting for any of them.
+  //
   //  - For consistency, whether the blob is found in the cache or on disk, sets
   //  "*bytes_read" to the total size of on-disk (possibly compressed) blob
   //  records.
@@ -107,6 +111,28 @@ class BlobSource {
                         uint64_t offset, size_t* charge = nullptr) const;
 
  private:
+  // The cache misses of MultiGetBlobFromOneFile() being read from the file
+  struct OneFileMultiGet {
+    OffsetableCacheKey base_cache_key;
+    autovector<std::pair<BlobReadRequest*, std::unique_ptr<BlobContents>>>
+        blob_reqs;
+    CacheHandleGuard<BlobFileReader> blob_file_reader;
+    BlobFileReader::MultiGetBlobReads reads;
+    uint64_t total_bytes = 0;
+  };
+
+  // Looks up blob_reqs in the blob cache, returns true if the misses must be
+  // read from the file, whose reads are submitted now if async.
+  bool StartMultiGetBlobFromOneFile(const ReadOptions& read_options,
+                                    uint64_t file_number,
+                                    autovector<BlobReadRequest>& blob_reqs,
+                                    bool async, OneFileMultiGet* file);
+
+  // Reads (or completes the async reads of) the cache misses, and fills the
+  // blob cache with them.
+  void FinishMultiGetBlobFromOneFile(const ReadOptions& read_options,
+                                     bool async, OneFileMultiGet* file);
+
   Status GetBlobFromCache(const Slice& cache_key,
                           CacheHandleGuard<BlobContents>* cached_blob) const;
 
@@ -137,6 +163,8 @@ class BlobSource {
 
   Statistics* statistics_;
 
+  FileSystem* fs_;
+
   // A cache to store blob file reader.
   BlobFileCache* blob_file_cache_;
 
@@ -370,6 +370,62 @@ TEST_F(DBBlobBasicTest, IterateBlobsFromCachePinning) {
   }
 }
 
+TEST_F(DBBlobBasicTest, IterateBlobsWithReadahead) {
+  Options options = GetDefaultOptions();
+  options.enable_blob_files = true;
+  options.min_blob_size = 0;
+
+  Reopen(options);
+
+  constexpr int num_blobs = 100;
+  std::vector<std::string> keys;
+  std::vector<std::string> blobs;
+
+  for (int i = 0; i < num_blobs; ++i) {
+    char key[16];
+    snprintf(key, sizeof(key), "key%04d", i);
+    keys.push_back(key);
+    blobs.push_back(std::string(100, 'a' + i % 26));
+    ASSERT_OK(Put(keys[i], blobs[i]));
+  }
+  ASSERT_OK(Flush());
+
+  for (bool async_io : {false, true}) {
+    ReadOptions read_options;
+    read_options.blob_readahead_size = 64 << 10;
+    read_options.async_io = async_io;
+
+    SetPerfLevel(kEnableCount);
+    get_perf_context()->Reset();
+
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    int i = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ASSERT_EQ(iter->key().ToString(), keys[i]);
+      ASSERT_EQ(iter->value().ToString(), blobs[i]);
+      ++i;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(i, num_blobs);
+
+    // Only the blob read before the scan was found sequential is read
+    // without readahead
+    ASSERT_EQ(get_perf_context()->blob_read_count, 1);
+
+    // Backward scans read the blobs one by one
+    get_perf_context()->Reset();
+    for (iter->SeekToLast(); iter->Valid(); iter->Prev()) {
+      --i;
+      ASSERT_EQ(iter->key().ToString(), keys[i]);
+      ASSERT_EQ(iter->value().ToString(), blobs[i]);
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(i, 0);
+    ASSERT_EQ(get_perf_context()->blob_read_count, num_blobs);
+    SetPerfLevel(kDisable);
+  }
+}
+
 TEST_F(DBBlobBasicTest, MultiGetBlobs) {
   constexpr size_t min_blob_size = 6;
 
@@ -880,6 +936,70 @@ TEST_F(DBBlobBasicTest, MultiGetBlobsFromMultipleFiles) {
   }
 }
 
+TEST_F(DBBlobBasicTest, MultiGetBlobsFromMultipleFilesAsync) {
+  Options options = GetDefaultOptions();
+  options.min_blob_size = 0;
+  options.create_if_missing = true;
+  options.enable_blob_files = true;
+
+  Reopen(options);
+
+  constexpr size_t kNumBlobFiles = 4;
+  constexpr size_t kNumBlobsPerFile = 5;
+  constexpr size_t kNumKeys = kNumBlobsPerFile * kNumBlobFiles;
+
+  std::vector<std::string> key_strs;
+  std::vector<std::string> value_strs;
+  for (size_t i = 0; i < kNumBlobFiles; ++i) {
+    for (size_t j = 0; j < kNumBlobsPerFile; ++j) {
+      std::string key = "key" + std::to_string(j) + "_" + std::to_string(i);
+      std::string value =
+          "value_as_blob" + std::to_string(i) + "_" + std::to_string(j);
+      ASSERT_OK(Put(key, value));
+      key_strs.push_back(key);
+      value_strs.push_back(value);
+    }
+    ASSERT_OK(Flush());
+  }
+  std::array<Slice, kNumKeys> keys;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    keys[i] = key_strs[i];
+  }
+
+  // The reads of all blob files are submitted before waiting for any of them
+  std::atomic<int> files_submitted{0};
+  std::atomic<int> polls{0};
+  std::atomic<int> files_submitted_before_poll{0};
+  SyncPoint::GetInstance()->SetCallBack(
+      "BlobFileReader::MultiGetBlob:ReadFromFile",
+      [&](void*) { files_submitted++; });
+  SyncPoint::GetInstance()->SetCallBack("BlobSource::MultiGetBlob:Poll",
+                                        [&](void*) {
+                                          polls++;
+                                          files_submitted_before_poll =
+                                              files_submitted.load();
+                                        });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  ReadOptions read_options;
+  read_options.async_io = true;
+  std::array<PinnableSlice, kNumKeys> values;
+  std::array<Status, kNumKeys> statuses;
+  db_->MultiGet(read_options, db_->DefaultColumnFamily(), kNumKeys, &keys[0],
+                &values[0], &statuses[0]);
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  ASSERT_EQ(polls.load(), 1);
+  ASSERT_EQ(files_submitted_before_poll.load(), int{kNumBlobFiles});
+  ASSERT_EQ(files_submitted.load(), int{kNumBlobFiles});
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    ASSERT_OK(statuses[i]);
+    ASSERT_EQ(value_strs[i], values[i]);
+  }
+}
+
 TEST_F(DBBlobBasicTest, GetBlob_CorruptIndex) {
   Options options = GetDefaultOptions();
   options.enable_blob_files = true;
@@ -1328,6 +1448,31 @@ TEST_F(DBBlobBasicTest, Properties) {
   }
 }
 
+TEST_F(DBBlobBasicTest, SeparationPolicyStats) {
+  Options options = GetDefaultOptions();
+  options.enable_blob_files = true;
+  options.min_blob_size = 0;
+  AdaptiveBlobSeparationOptions policy_opts;
+  policy_opts.prefix_length = 3;
+  options.blob_separation_policy =
+      NewAdaptiveBlobSeparationPolicy(policy_opts);
+
+  Reopen(options);
+
+  ASSERT_OK(Put("foo1", "blob1"));
+  ASSERT_OK(Put("foo2", "blob2"));
+  ASSERT_OK(Flush());
+
+  std::string cf_stats;
+  ASSERT_TRUE(db_->GetProperty(DB::Properties::kCFStats, &cf_stats));
+  const size_t pos =
+      cf_stats.find("Blob separation policy AdaptiveBlobSeparationPolicy:\n");
+  ASSERT_NE(pos, std::string::npos);
+  ASSERT_NE(cf_stats.find("prefixes: 1\n", pos), std::string::npos);
+  // the prefix "foo", hex encoded
+  ASSERT_NE(cf_stats.find("  666F6F: flushed 2", pos), std::string::npos);
+}
+
 TEST_F(DBBlobBasicTest, PropertiesMultiVersion) {
   Options options = GetDefaultOptions();
   options.enable_blob_files = true;
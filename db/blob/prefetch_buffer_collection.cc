@@ -18,4 +18,29 @@ FilePrefetchBuffer* PrefetchBufferCollection::GetOrCreatePrefetchBuffer(
   return prefetch_buffer.get();
 }
 
+FilePrefetchBuffer* BlobScanPrefetcher::GetPrefetchBuffer(
+    uint64_t file_number, uint64_t offset, uint64_t size) {
+  FileState& file = files_[file_number];
+  if (file.num_sequential_reads > 0 && offset >= file.next_offset &&
+      offset - file.next_offset < readahead_size_) {
+    file.num_sequential_reads++;
+  } else {
+    file.num_sequential_reads = 1;
+  }
+  file.next_offset = offset + size;
+  if (file.num_sequential_reads < kMinSequentialReads) {
+    return nullptr;
+  }
+  if (!file.prefetch_buffer) {
+    constexpr bool enable = true;
+    constexpr bool track_min_offset = false;
+    constexpr bool implicit_auto_readahead = false;
+    file.prefetch_buffer.reset(new FilePrefetchBuffer(
+        readahead_size_, readahead_size_, enable, track_min_offset,
+        implicit_auto_readahead, 0 /*num_file_reads*/,
+        0 /*num_file_reads_for_auto_readahead*/, fs_, clock_, stats_));
+  }
+  return file.prefetch_buffer.get();
+}
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -35,4 +35,41 @@ class PrefetchBufferCollection {
       prefetch_buffers_;  // maps file number to prefetch buffer
 };
 
+// Blob file readahead for an iterator. Unlike compaction, an iterator may
+// read a blob file randomly, so a blob file is read ahead only while the
+// blobs read from it have increasing offsets less than one readahead apart,
+// which is the case of forward scans since flush and compaction write blob
+// files in key order. Designed to be accessed by a single thread only.
+class BlobScanPrefetcher {
+ public:
+  BlobScanPrefetcher(uint64_t readahead_size, FileSystem* fs,
+                     SystemClock* clock, Statistics* stats)
+      : readahead_size_(readahead_size),
+        fs_(fs),
+        clock_(clock),
+        stats_(stats) {
+    assert(readahead_size_ > 0);
+  }
+
+  // Returns nullptr if the blob at offset should be read without readahead
+  FilePrefetchBuffer* GetPrefetchBuffer(uint64_t file_number, uint64_t offset,
+                                        uint64_t size);
+
+ private:
+  // sequential reads of a file before it is read ahead
+  static constexpr uint32_t kMinSequentialReads = 2;
+
+  struct FileState {
+    uint64_t next_offset = 0;
+    uint32_t num_sequential_reads = 0;
+    std::unique_ptr<FilePrefetchBuffer> prefetch_buffer;
+  };
+
+  uint64_t readahead_size_;
+  FileSystem* fs_;
+  SystemClock* clock_;
+  Statistics* stats_;
+  std::unordered_map<uint64_t, FileState> files_;  // maps file number
+};
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -803,19 +803,47 @@ const double kNearStopSlowdownRatio = 0.6;
 const double kDelayRecoverSlowdownRatio = 1.4;
 
 namespace {
+const uint64_t kMinWriteRate = 16 * 1024u;  // Minimum write rate 16KB/s.
+
+// The feedback of write_controller->policy(), which looks at the whole DB
+// rather than at the column family being recalculated.
+WriteStallFeedback GetWriteStallFeedback(ColumnFamilySet* column_family_set,
+                                         SystemClock* clock, bool near_stop) {
+  WriteController* write_controller = column_family_set->write_controller();
+  WriteStallFeedback fb;
+  fb.now_micros = clock->NowMicros();
+  fb.delayed_write_rate = write_controller->delayed_write_rate();
+  fb.max_delayed_write_rate = write_controller->max_delayed_write_rate();
+  for (auto cfd : *column_family_set) {
+    if (!cfd->IsDropped() && cfd->current() != nullptr) {
+      fb.pending_compaction_bytes +=
+          cfd->current()->storage_info()->estimated_compaction_needed_bytes();
+    }
+  }
+  fb.compaction_bytes = write_controller->compaction_bytes();
+  fb.remote_compaction_bytes = write_controller->remote_compaction_bytes();
+  fb.near_stop = near_stop;
+  return fb;
+}
+
 // If penalize_stop is true, we further reduce slowdown rate.
 std::unique_ptr<WriteControllerToken> SetupDelay(
-    WriteController* write_controller, uint64_t compaction_needed_bytes,
-    uint64_t prev_compaction_need_bytes, bool penalize_stop,
-    bool auto_compactions_disabled) {
-  const uint64_t kMinWriteRate = 16 * 1024u;  // Minimum write rate 16KB/s.
-
+    ColumnFamilySet* column_family_set, SystemClock* clock,
+    uint64_t compaction_needed_bytes, uint64_t prev_compaction_need_bytes,
+    bool penalize_stop, bool auto_compactions_disabled) {
+  WriteController* write_controller = column_family_set->write_controller();
   uint64_t max_write_rate = write_controller->max_delayed_write_rate();
   uint64_t write_rate = write_controller->delayed_write_rate();
 
   if (auto_compactions_disabled) {
     // When auto compaction is disabled, always use the value user gave.
     write_rate = max_write_rate;
+  } else if (write_controller->policy() != nullptr &&
+             max_write_rate > kMinWriteRate) {
+    // The policy also sees the first delay, to keep its measurements fresh
+    write_rate = write_controller->policy()->GetDelayedWriteRate(
+        GetWriteStallFeedback(column_family_set, clock, penalize_stop));
+    write_rate = std::max(write_rate, kMinWriteRate);
   } else if (write_controller->NeedsDelay() && max_write_rate > kMinWriteRate) {
     // If user gives rate less than kMinWriteRate, don't adjust it.
     //
@@ -991,9 +1019,9 @@ WriteStallCondition ColumnFamilyData::RecalculateWriteStallConditions(
     } else if (write_stall_condition == WriteStallCondition::kDelayed &&
                write_stall_cause == WriteStallCause::kMemtableLimit) {
       write_controller_token_ =
-          SetupDelay(write_controller, compaction_needed_bytes,
-                     prev_compaction_needed_bytes_, was_stopped,
-                     mutable_cf_options.disable_auto_compactions);
+          SetupDelay(column_family_set_, ioptions_.clock,
+                     compaction_needed_bytes, prev_compaction_needed_bytes_,
+                     was_stopped, mutable_cf_options.disable_auto_compactions);
       internal_stats_->AddCFStats(InternalStats::MEMTABLE_LIMIT_SLOWDOWNS, 1);
       ROCKS_LOG_WARN(
           ioptions_.logger,
@@ -1008,10 +1036,10 @@ WriteStallCondition ColumnFamilyData::RecalculateWriteStallConditions(
       // L0 is the last two files from stopping.
       bool near_stop = vstorage->l0_delay_trigger_count() >=
                        mutable_cf_options.level0_stop_writes_trigger - 2;
-      write_controller_token_ =
-          SetupDelay(write_controller, compaction_needed_bytes,
-                     prev_compaction_needed_bytes_, was_stopped || near_stop,
-                     mutable_cf_options.disable_auto_compactions);
+      write_controller_token_ = SetupDelay(
+          column_family_set_, ioptions_.clock, compaction_needed_bytes,
+          prev_compaction_needed_bytes_, was_stopped || near_stop,
+          mutable_cf_options.disable_auto_compactions);
       internal_stats_->AddCFStats(InternalStats::L0_FILE_COUNT_LIMIT_SLOWDOWNS,
                                   1);
       if (compaction_picker_->IsLevel0CompactionInProgress()) {
@@ -1037,10 +1065,10 @@ WriteStallCondition ColumnFamilyData::RecalculateWriteStallConditions(
                    mutable_cf_options.soft_pending_compaction_bytes_limit) /
                   4;
 
-      write_controller_token_ =
-          SetupDelay(write_controller, compaction_needed_bytes,
-                     prev_compaction_needed_bytes_, was_stopped || near_stop,
-                     mutable_cf_options.disable_auto_compactions);
+      write_controller_token_ = SetupDelay(
+          column_family_set_, ioptions_.clock, compaction_needed_bytes,
+          prev_compaction_needed_bytes_, was_stopped || near_stop,
+          mutable_cf_options.disable_auto_compactions);
       internal_stats_->AddCFStats(
           InternalStats::PENDING_COMPACTION_BYTES_LIMIT_SLOWDOWNS, 1);
       ROCKS_LOG_WARN(
@@ -1086,8 +1114,15 @@ WriteStallCondition ColumnFamilyData::RecalculateWriteStallConditions(
       // increase signal.
       if (needed_delay) {
         uint64_t write_rate = write_controller->delayed_write_rate();
-        write_controller->set_delayed_write_rate(static_cast<uint64_t>(
-            static_cast<double>(write_rate) * kDelayRecoverSlowdownRatio));
+        if (write_controller->policy() != nullptr) {
+          write_controller->set_delayed_write_rate(
+              write_controller->policy()->GetRecoveredWriteRate(
+                  GetWriteStallFeedback(column_family_set_, ioptions_.clock,
+                                        false)));
+        } else {
+          write_controller->set_delayed_write_rate(static_cast<uint64_t>(
+              static_cast<double>(write_rate) * kDelayRecoverSlowdownRatio));
+        }
         // Set the low pri limit to be 1/4 the delayed write rate.
         // Note we don't reset this value even after delay condition is relased.
         // Low-pri rate will continue to apply if there is a compaction
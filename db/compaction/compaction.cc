@@ -9,10 +9,12 @@
 
 #include "db/compaction/compaction.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <vector>
 
 #include "db/column_family.h"
+#include "db/version_set.h"
 #include "rocksdb/compaction_filter.h"
 #include "rocksdb/sst_partitioner.h"
 #include "test_util/sync_point.h"
@@ -232,6 +234,7 @@ Compaction::Compaction(
       output_temperature_(_output_temperature),
       deletion_compaction_(_deletion_compaction),
       l0_files_might_overlap_(l0_files_might_overlap),
+      partial_trivial_move_(_mutable_db_options.partial_trivial_move),
       inputs_(PopulateWithAtomicBoundaries(vstorage, std::move(_inputs))),
       grandparents_(std::move(_grandparents)),
       score_(_score),
@@ -268,6 +271,10 @@ Compaction::Compaction(
     else
       max_subcompactions_ = _mutable_db_options.max_subcompactions;
   }
+  if (_mutable_db_options.compaction_compression_threads > 0) {
+    output_compression_opts_.parallel_threads =
+        _mutable_db_options.compaction_compression_threads;
+  }
 
   // for the non-bottommost levels, it tries to build files match the target
   // file size, but not guaranteed. It could be 2x the size of the target size.
@@ -516,10 +523,132 @@ bool Compaction::IsTrivialMove() const {
   return true;
 }
 
+void Compaction::SetupUntouchedFiles() {
+  assert(input_version_ != nullptr);
+  assert(untouched_files_.empty());
+  // The inputs sent to a CompactionService are not pruned
+  if (!partial_trivial_move_ || is_compaction_woker_ ||
+      immutable_options_.compaction_service != nullptr ||
+      immutable_options_.compaction_style != kCompactionStyleLevel ||
+      compaction_reason_ != CompactionReason::kLevelMaxLevelSize ||
+      start_level_ == 0 || num_input_levels() != 2 ||
+      level(1) != output_level_ || SupportsPerKeyPlacement() ||
+      !immutable_options_.table_factory->InputCompressionMatchesOutput(this)) {
+    return;
+  }
+  const Comparator* ucmp = cfd_->user_comparator();
+  auto overlaps = [ucmp](const FileMetaData* a, const FileMetaData* b) {
+    return ucmp->CompareWithoutTimestamp(a->smallest.user_key(),
+                                         b->largest.user_key()) <= 0 &&
+           ucmp->CompareWithoutTimestamp(b->smallest.user_key(),
+                                         a->largest.user_key()) <= 0;
+  };
+  // A file is untouched if it overlaps no file of the other input level and
+  // shares no boundary user key with its neighbours in its own level
+  auto is_untouched = [&](size_t which, size_t i) {
+    const std::vector<FileMetaData*>& files = inputs_[which].files;
+    const FileMetaData* f = files[i];
+    if (f->marked_for_compaction) {
+      return false;
+    }
+    if ((i > 0 && overlaps(files[i - 1], f)) ||
+        (i + 1 < files.size() && overlaps(f, files[i + 1]))) {
+      return false;
+    }
+    for (const FileMetaData* other : inputs_[1 - which].files) {
+      if (overlaps(f, other)) {
+        return false;
+      }
+    }
+    return true;
+  };
+  // The same conditions as IsTrivialMove() for the files which are moved
+  std::unique_ptr<SstPartitioner> partitioner = CreateSstPartitioner();
+  auto can_move = [&](const FileMetaData* f) {
+    if (f->fd.GetPathId() != output_path_id_) {
+      return false;
+    }
+    if (partitioner && !partitioner->CanDoTrivialMove(f->smallest.user_key(),
+                                                      f->largest.user_key())) {
+      return false;
+    }
+    if (output_level_ + 1 < number_levels_) {
+      std::vector<FileMetaData*> file_grand_parents;
+      input_vstorage_->GetOverlappingInputs(output_level_ + 1, &f->smallest,
+                                            &f->largest, &file_grand_parents);
+      if (f->fd.GetFileSize() + TotalFileSize(file_grand_parents) >
+          max_compaction_bytes_) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  std::vector<CompactionInputFiles> rewrite(num_input_levels());
+  std::vector<FileMetaData*> untouched;
+  uint64_t moved_bytes = 0;
+  for (size_t which = 0; which < num_input_levels(); which++) {
+    const CompactionInputFiles& in = inputs_[which];
+    rewrite[which].level = in.level;
+    for (size_t i = 0; i < in.size(); i++) {
+      FileMetaData* f = in[i];
+      if (is_untouched(which, i) && (which != 0 || can_move(f))) {
+        untouched.push_back(f);
+        if (which == 0) {
+          moved_bytes += f->fd.GetFileSize();
+        }
+      } else {
+        rewrite[which].files.push_back(f);
+        rewrite[which].atomic_compaction_unit_boundaries.push_back(
+            in.atomic_compaction_unit_boundaries[i]);
+      }
+    }
+  }
+  if (untouched.empty() || rewrite[0].empty()) {
+    return;
+  }
+  // The outputs are cut at the untouched files by point keys only, a range
+  // tombstone could still extend an output over them
+  for (const CompactionInputFiles& in : rewrite) {
+    for (const FileMetaData* f : in.files) {
+      std::shared_ptr<const TableProperties> tp;
+      Status s = input_version_->GetTableProperties(&tp, f);
+      if (!s.ok() || tp->num_range_deletions > 0) {
+        return;
+      }
+    }
+  }
+  const InternalKeyComparator* icmp = input_vstorage_->InternalComparator();
+  std::sort(untouched.begin(), untouched.end(),
+            [icmp](const FileMetaData* a, const FileMetaData* b) {
+              return icmp->Compare(a->smallest, b->smallest) < 0;
+            });
+  rewrite_inputs_ = std::move(rewrite);
+  untouched_files_ = std::move(untouched);
+  partial_move_bytes_ = moved_bytes;
+  for (size_t which = 0; which < num_input_levels(); which++) {
+    DoGenerateLevelFilesBrief(&input_levels_[which],
+                              rewrite_inputs_[which].files, &arena_);
+  }
+}
+
 void Compaction::AddInputDeletions(VersionEdit* out_edit) {
   for (size_t which = 0; which < num_input_levels(); which++) {
     for (size_t i = 0; i < inputs_[which].size(); i++) {
-      out_edit->DeleteFile(level(which), inputs_[which][i]->fd.GetNumber());
+      FileMetaData* f = inputs_[which][i];
+      if (std::find(untouched_files_.begin(), untouched_files_.end(), f) ==
+          untouched_files_.end()) {
+        out_edit->DeleteFile(level(which), f->fd.GetNumber());
+      } else if (level(which) != output_level_) {
+        out_edit->DeleteFile(level(which), f->fd.GetNumber());
+        out_edit->AddFile(
+            output_level_, f->fd.GetNumber(), f->fd.GetPathId(),
+            f->fd.GetFileSize(), f->smallest, f->largest, f->fd.smallest_seqno,
+            f->fd.largest_seqno, f->marked_for_compaction, f->temperature,
+            f->oldest_blob_file_number, f->oldest_ancester_time,
+            f->file_creation_time, f->epoch_number, f->file_checksum,
+            f->file_checksum_func_name, f->unique_id);
+      }
     }
   }
 }
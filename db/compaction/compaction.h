@@ -151,7 +151,8 @@ class Compaction {
   const std::vector<AtomicCompactionUnitBoundary>* boundaries(
       size_t compaction_input_level) const {
     assert(compaction_input_level < inputs_.size());
-    return &inputs_[compaction_input_level].atomic_compaction_unit_boundaries;
+    return &(*rewrite_inputs())[compaction_input_level]
+                .atomic_compaction_unit_boundaries;
   }
 
   // Returns the list of file meta data of the specified compaction
@@ -166,7 +167,35 @@ class Compaction {
 
   const std::vector<CompactionInputFiles>* inputs() const { return &inputs_; }
 
-  // Returns the LevelFilesBrief of the specified compaction input level.
+  // The inputs which are read and rewritten, the same as inputs() unless
+  // SetupUntouchedFiles() found some untouched files.
+  const std::vector<CompactionInputFiles>* rewrite_inputs() const {
+    return rewrite_inputs_.empty() ? &inputs_ : &rewrite_inputs_;
+  }
+
+  // Input files which are not rewritten, sorted by key, see
+  // DBOptions::partial_trivial_move. Start level files among them are moved
+  // to the output level by AddInputDeletions(), output level files are left
+  // in place. No output file may overlap any of them.
+  const std::vector<FileMetaData*>& untouched_files() const {
+    return untouched_files_;
+  }
+  // A compaction worker must restore them from
+  // CompactionParams::untouched_files, its inputs are rewrite_inputs().
+  void set_untouched_files(std::vector<FileMetaData*> files) {
+    untouched_files_ = std::move(files);
+  }
+  // Total size of the untouched files moved to the output level
+  uint64_t partial_move_bytes() const { return partial_move_bytes_; }
+
+  // Find the untouched files if DBOptions::partial_trivial_move is on, and
+  // exclude them from rewrite_inputs() and input_levels().
+  // REQUIRES: input version is set, called before the compaction job reads
+  // its inputs
+  void SetupUntouchedFiles();
+
+  // Returns the LevelFilesBrief of the specified compaction input level,
+  // untouched_files() excluded.
   const LevelFilesBrief* input_levels(size_t compaction_input_level) const {
     return &input_levels_[compaction_input_level];
   }
@@ -206,7 +235,8 @@ class Compaction {
   // If true, then the compaction can be done by simply deleting input files.
   bool deletion_compaction() const { return deletion_compaction_; }
 
-  // Add all inputs to this compaction as delete operations to *edit.
+  // Add all inputs to this compaction as delete operations to *edit, except
+  // untouched files, which are moved to the output level or kept.
   void AddInputDeletions(VersionEdit* edit);
 
   // Returns true if the available information we have guarantees that
@@ -375,6 +405,13 @@ class Compaction {
 
   uint32_t max_subcompactions() const { return max_subcompactions_; }
 
+  // An L0 -> base level compaction which splits into subcompactions at the
+  // boundaries of its output level input files, see
+  // DBOptions::max_level0_range_splits. A compaction worker must restore it
+  // from CompactionParams::l0_range_split.
+  bool l0_range_split() const { return l0_range_split_; }
+  void set_l0_range_split(bool v) { l0_range_split_ = v; }
+
   bool enable_blob_garbage_collection() const {
     return enable_blob_garbage_collection_;
   }
@@ -480,11 +517,18 @@ class Compaction {
   // that is the case, set the value to false. Otherwise, set it true.
   bool l0_files_might_overlap_;
   bool is_compaction_woker_;
+  bool l0_range_split_ = false;
+  bool partial_trivial_move_;
 
   // Compaction input files organized by level. Constant after construction
   const std::vector<CompactionInputFiles> inputs_;
 
-  // A copy of inputs_, organized more closely in memory
+  // inputs_ without untouched_files_, empty if all inputs are rewritten
+  std::vector<CompactionInputFiles> rewrite_inputs_;
+  std::vector<FileMetaData*> untouched_files_;
+  uint64_t partial_move_bytes_ = 0;
+
+  // A copy of rewrite_inputs(), organized more closely in memory
   autovector<LevelFilesBrief, 2> input_levels_;
 
   // State used to check for number of overlapping grandparent files
@@ -26,6 +26,12 @@ CompactionParams::~CompactionParams() {
       }
       delete grandparents;
     }
+    if (untouched_files) {
+      for (auto meta : *untouched_files) {
+        delete meta;
+      }
+      delete untouched_files;
+    }
     if (inputs) {
       for (auto& level_files : *inputs) {
         for (auto meta : level_files.files)
@@ -106,6 +112,8 @@ std::string CompactionParams::DebugString() const {
           job_id, output_level, dbname.c_str(), cf_name.c_str());
   fprintf(fp, "bottommost_level = %d, compaction_reason = %s\n",
                bottommost_level, enum_cstr(compaction_reason));
+  fprintf(fp, "max_subcompactions = %u, l0_range_split = %d\n",
+               max_subcompactions, l0_range_split);
   fprintf(fp, "smallest_user_key = %s\n", html_user_key_decode(*this, smallest_user_key).c_str());
   fprintf(fp, "llargest_user_key = %s\n", html_user_key_decode(*this,  largest_user_key).c_str());
   for (size_t i = 0; i < inputs->size(); ++i) {
@@ -126,6 +134,16 @@ std::string CompactionParams::DebugString() const {
   else {
     fprintf(fp, "grandparents = nullptr\n");
   }
+  if (untouched_files) {
+    fprintf(fp, "untouched_files.size = %zd\n", untouched_files->size());
+    for (const FileMetaData* fmd : *untouched_files) {
+      PrintFileMetaData(*this, fp, fmd);
+    }
+  }
+  if (!blob_files.empty()) {
+    fprintf(fp, "blob_files.size = %zd, blob_file_garbages.size = %zd\n",
+            blob_files.size(), blob_file_garbages.size());
+  }
   if (existing_snapshots) {
     fprintf(fp, "existing_snapshots.size = %zd\n", existing_snapshots->size());
   }
@@ -153,6 +171,15 @@ void CompactionParams::InputBytes(size_t* res) const {
   res[1] = zip;
 }
 
+void CompactionParams::AddBlobFilesTo(VersionEdit* edit) const {
+  for (const auto& blob : blob_files) {
+    edit->AddBlobFile(blob);
+  }
+  for (const auto& garbage : blob_file_garbages) {
+    edit->AddBlobFileGarbage(garbage);
+  }
+}
+
 CompactionResults::CompactionResults() {
   curl_time_usec = 0;
   work_time_usec = 0;
@@ -54,9 +54,12 @@ struct CompactionParams {
   std::vector<DbPath> cf_paths;
 
   uint32_t max_subcompactions; // num_threads
+  bool l0_range_split = false; // see Compaction::l0_range_split()
   CompressionType compression;
   CompressionOptions compression_opts;
   const std::vector<FileMetaData*>* grandparents = nullptr;
+  // see Compaction::untouched_files(), inputs are the rewritten ones only
+  const std::vector<FileMetaData*>* untouched_files = nullptr;
   double score;
   bool manual_compaction;
   bool deletion_compaction;
@@ -83,6 +86,24 @@ struct CompactionParams {
   //FSDirectory* output_directory;
   //FSDirectory* blob_output_directory;
 
+  // blob files of the input version and their garbage, the worker rebuilds
+  // its blob file metadata from them by AddBlobFilesTo(), so that it can read
+  // blob values and relocate them (blob garbage collection)
+  std::vector<BlobFileAddition> blob_files;
+  std::vector<BlobFileGarbage> blob_file_garbages;
+  bool enable_blob_files = false;
+  uint64_t min_blob_size = 0;
+  uint64_t blob_file_size = 0;
+  CompressionType blob_compression_type = kNoCompression;
+  bool enable_blob_garbage_collection = false; // see Compaction
+  double blob_garbage_collection_age_cutoff = 0;
+  uint64_t blob_compaction_readahead_size = 0;
+  int blob_file_starting_level = 0;
+  // version_set.next_file_number is the begin of the file numbers reserved
+  // for the worker, because the output SSTs refer to blob files by number,
+  // output blob files can not be renumbered as output SSTs are
+  uint64_t reserved_file_number_end = 0;
+
   std::string smallest_user_key; // serialization must before
   std::string largest_user_key;  // ObjectRpcParam fields
   //ObjectRpcParam compaction_filter; // don't use compaction_filter
@@ -113,6 +134,7 @@ struct CompactionParams {
 
   std::string DebugString() const;
   void InputBytes(size_t* res) const;
+  void AddBlobFilesTo(VersionEdit*) const;
 };
 
 struct CompactionResults {
@@ -128,6 +150,8 @@ struct CompactionResults {
     InternalKey smallest_ikey;
     InternalKey largest_ikey;
     bool marked_for_compaction;
+    // blob files the SST refers to, written by the same worker or inputs
+    uint64_t oldest_blob_file_number = kInvalidBlobFileNumber;
   };
   // collect remote statistics
   struct RawStatistics {
@@ -137,6 +161,10 @@ struct CompactionResults {
 
   std::string output_dir;
   std::vector<std::vector<FileMinMeta> > output_files;
+  // blob files written in output_dir, and the garbage the compaction
+  // produced in the input blob files
+  std::vector<BlobFileAddition> blob_file_additions;
+  std::vector<BlobFileGarbage> blob_file_garbages;
   InternalStats::CompactionStats compaction_stats;
   CompactionJobStats job_stats;
   RawStatistics statistics;
@@ -168,6 +196,10 @@ class CompactionExecutorFactory {
   virtual ~CompactionExecutorFactory();
   virtual bool ShouldRunLocal(const Compaction*) const = 0;
   virtual bool AllowFallbackToLocal() const = 0;
+  // If true, the worker restores CompactionParams::untouched_files and cuts
+  // its outputs around them, see DBOptions::partial_trivial_move. Otherwise
+  // the worker gets all inputs of the compaction.
+  virtual bool SupportsPartialTrivialMove() const { return false; }
   virtual CompactionExecutor* NewExecutor(const Compaction*) const = 0;
   virtual const char* Name() const = 0;
 };
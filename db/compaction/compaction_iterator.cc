@@ -804,6 +804,9 @@ void CompactionIterator::NextFromInput() {
       }
 
       ++iter_stats_.num_record_drop_hidden;  // rule (A)
+      if (blob_file_builder_) {
+        blob_file_builder_->OnOverwritten(ikey_.user_key);
+      }
       AdvanceInputIter();
     } else if (compaction_ != nullptr &&
                (ikey_.type == kTypeDeletion ||
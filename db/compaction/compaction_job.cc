@@ -261,6 +261,21 @@ void CompactionJob::Prepare() {
   write_hint_ = cfd->CalculateSSTWriteHint(c->output_level());
   bottommost_level_ = c->bottommost_level();
 
+  auto exec = c->immutable_options()->compaction_executor_factory.get();
+  will_run_remote_ = exec && !exec->ShouldRunLocal(c);
+
+  if (!will_run_remote_ || exec->SupportsPartialTrivialMove()) {
+    c->SetupUntouchedFiles();
+  }
+  if (!c->untouched_files().empty()) {
+    ROCKS_LOG_BUFFER(log_buffer_,
+                     "[%s] [JOB %d] Partial trivial move: %zd untouched input "
+                     "files, %" PRIu64 " bytes moved to level-%d",
+                     cfd->GetName().c_str(), job_id_,
+                     c->untouched_files().size(), c->partial_move_bytes(),
+                     c->output_level());
+  }
+
   if (c->ShouldFormSubcompactions()) {
     StopWatch sw(db_options_.clock, stats_, SUBCOMPACTION_SETUP_TIME);
     GenSubcompactionBoundaries();
@@ -479,6 +494,11 @@ void CompactionJob::GenSubcompactionBoundaries() {
   // overlap with N-1 other ranges. Since we requested a relatively large number
   // (128) of ranges from each input files, even N range overlapping would
   // cause relatively small inaccuracy.
+  //
+  // If the table supports GetRandomInternalKeysAppend(), the anchors of a
+  // file are instead 128 uniform samples of its keys, each weighted by an
+  // equal share of the file size, so the partition keys are equi-depth
+  // quantiles of the merged samples.
 
   auto* c = compact_->compaction;
 #if defined(ROCKSDB_UNIT_TEST)
@@ -500,6 +520,8 @@ void CompactionJob::GenSubcompactionBoundaries() {
 
   uint64_t total_size = 0;
   std::vector<TableReader::Anchor> all_anchors;
+  const size_t kSamplesPerFile = 128;
+  std::vector<std::string> samples;
   int start_lvl = c->start_level();
   int out_lvl = c->output_level();
 
@@ -516,8 +538,21 @@ void CompactionJob::GenSubcompactionBoundaries() {
       for (size_t i = 0; i < num_files; i++) {
         FileMetaData* f = flevel->files[i].file_metadata;
         std::vector<TableReader::Anchor> my_anchors;
-        Status s = cfd->table_cache()->ApproximateKeyAnchors(
-            ReadOptions(), icomp, *f, my_anchors);
+        samples.clear();
+        Status s = cfd->table_cache()->GetRandomInternalKeysAppend(
+            ReadOptions(), icomp, *f, kSamplesPerFile, &samples);
+        if (s.ok() && !samples.empty()) {
+          TEST_SYNC_POINT_CALLBACK(
+              "CompactionJob::GenSubcompactionBoundaries:Samples", &samples);
+          size_t weight =
+              std::max<size_t>(f->fd.GetFileSize() / samples.size(), 1);
+          for (auto& ikey : samples) {
+            my_anchors.emplace_back(ExtractUserKey(ikey), weight);
+          }
+        } else {
+          s = cfd->table_cache()->ApproximateKeyAnchors(ReadOptions(), icomp,
+                                                        *f, my_anchors);
+        }
         if (!s.ok() || my_anchors.empty()) {
           my_anchors.emplace_back(f->largest.user_key(), f->fd.GetFileSize());
         }
@@ -543,15 +578,59 @@ void CompactionJob::GenSubcompactionBoundaries() {
                0;
       });
 
-  // Remove duplicated entries from boundaries.
-  all_anchors.erase(
-      std::unique(all_anchors.begin(), all_anchors.end(),
-                  [cfd_comparator](TableReader::Anchor& a,
-                                   TableReader::Anchor& b) -> bool {
-                    return cfd_comparator->CompareWithoutTimestamp(
-                               a.user_key, b.user_key) == 0;
-                  }),
-      all_anchors.end());
+  // Remove duplicated entries from boundaries, keeping their sizes: the
+  // same key may be sampled from several overlapping files.
+  size_t num_unique = 0;
+  for (size_t i = 0; i < all_anchors.size(); i++) {
+    if (num_unique > 0 &&
+        cfd_comparator->CompareWithoutTimestamp(
+            all_anchors[num_unique - 1].user_key, all_anchors[i].user_key) ==
+            0) {
+      all_anchors[num_unique - 1].range_size += all_anchors[i].range_size;
+    } else {
+      if (num_unique != i) {
+        all_anchors[num_unique] = std::move(all_anchors[i]);
+      }
+      num_unique++;
+    }
+  }
+  all_anchors.erase(all_anchors.begin() + num_unique, all_anchors.end());
+
+  bool has_trailing_anchor = false;
+  if (c->l0_range_split() && c->num_input_levels() > 1 &&
+      c->level(c->num_input_levels() - 1) == out_lvl) {
+    // Only cut between output level files: sum the anchors into one range
+    // per output level file, ending before the smallest key of the next
+    // one. Each subcompaction then owns whole output level files and the
+    // L0 slices overlapping them.
+    const LevelFilesBrief* out_files =
+        c->input_levels(c->num_input_levels() - 1);
+    std::vector<TableReader::Anchor> file_anchors;
+    size_t anchor_idx = 0;
+    for (size_t i = 1; i < out_files->num_files; i++) {
+      Slice next_smallest =
+          out_files->files[i].file_metadata->smallest.user_key();
+      size_t range_size = 0;
+      while (anchor_idx < all_anchors.size() &&
+             cfd_comparator->CompareWithoutTimestamp(
+                 all_anchors[anchor_idx].user_key, next_smallest) < 0) {
+        range_size += all_anchors[anchor_idx++].range_size;
+      }
+      file_anchors.emplace_back(next_smallest, range_size);
+    }
+    // The anchors from the smallest key of the last output level file on
+    // weigh in the last range, no boundary is taken from it below
+    size_t trailing_size = 0;
+    while (anchor_idx < all_anchors.size()) {
+      trailing_size += all_anchors[anchor_idx++].range_size;
+    }
+    if (trailing_size > 0) {
+      file_anchors.emplace_back(std::move(all_anchors.back().user_key),
+                                trailing_size);
+      has_trailing_anchor = true;
+    }
+    all_anchors.swap(file_anchors);
+  }
 
 #if defined(ROCKSDB_UNIT_TEST)
   // Get the number of planned subcompactions, may update reserve threads
@@ -610,6 +689,10 @@ void CompactionJob::GenSubcompactionBoundaries() {
   uint64_t cumulative_size = 0;
   uint64_t num_actual_subcompactions = 1U;
   for (TableReader::Anchor& anchor : all_anchors) {
+    if (has_trailing_anchor && &anchor == &all_anchors.back()) {
+      // Not an output level file boundary
+      break;
+    }
     cumulative_size += anchor.range_size;
     if (cumulative_size > next_threshold) {
       next_threshold += target_range_size;
@@ -629,14 +712,20 @@ void CompactionJob::GenSubcompactionBoundaries() {
 }
 
 Status CompactionJob::Run() {
-  auto icf_opt = compact_->compaction->immutable_options();
-  auto exec = icf_opt->compaction_executor_factory.get();
-  if (!exec || exec->ShouldRunLocal(compact_->compaction)) {
+  if (!will_run_remote_) {
     return RunLocal();
   }
+  auto icf_opt = compact_->compaction->immutable_options();
+  auto exec = icf_opt->compaction_executor_factory.get();
   Status s = RunRemote();
+  run_remote_ = s.ok();
+  if (remote_done_callback_) {
+    remote_done_callback_();
+  }
   if (!s.ok()) {
     if (exec->AllowFallbackToLocal()) {
+      remote_blob_file_additions_.clear();
+      remote_blob_file_garbages_.clear();
       s = RunLocal();
     } else {
       // fatal, rocksdb does not handle compact errors properly
@@ -712,7 +801,8 @@ Status CompactionJob::RunLocal() {
     }
   }
   uint64_t sum_raw = 0, sum_zip = 0;
-  for (auto& each_level : *compact_->compaction->inputs()) {
+  // untouched files of a partial trivial move are not read
+  for (auto& each_level : *compact_->compaction->rewrite_inputs()) {
     for (FileMetaData* fmd : each_level.files) {
       sum_raw += fmd->raw_key_size + fmd->raw_value_size;
       sum_zip += fmd->fd.file_size;
@@ -903,6 +993,96 @@ void CompactionJob::GetSubCompactOutputs(
   }
 }
 
+void CompactionJob::GetBlobFileResults(
+    std::vector<BlobFileAddition>* additions,
+    std::vector<BlobFileGarbage>* garbages) const {
+  std::unordered_map<uint64_t, BlobGarbageMeter::BlobStats> blob_total_garbage;
+
+  for (const auto& sub_compact : compact_->sub_compact_states) {
+    for (const auto& blob : sub_compact.Current().GetBlobFileAdditions()) {
+      additions->push_back(blob);
+    }
+
+    if (sub_compact.Current().GetBlobGarbageMeter()) {
+      const auto& flows = sub_compact.Current().GetBlobGarbageMeter()->flows();
+
+      for (const auto& pair : flows) {
+        const uint64_t blob_file_number = pair.first;
+        const BlobGarbageMeter::BlobInOutFlow& flow = pair.second;
+
+        assert(flow.IsValid());
+        if (flow.HasGarbage()) {
+          blob_total_garbage[blob_file_number].Add(flow.GetGarbageCount(),
+                                                   flow.GetGarbageBytes());
+        }
+      }
+    }
+  }
+
+  for (const auto& pair : blob_total_garbage) {
+    const uint64_t blob_file_number = pair.first;
+    const BlobGarbageMeter::BlobStats& stats = pair.second;
+
+    garbages->emplace_back(blob_file_number, stats.GetCount(),
+                           stats.GetBytes());
+  }
+}
+
+void CompactionJob::SetBlobParams(CompactionParams* rpc_params) const {
+  const Compaction* c = compact_->compaction;
+  auto mut_cfo = c->mutable_cf_options();
+  const auto* vstorage = c->input_version()->storage_info();
+  uint64_t total_blob_bytes = 0;
+  for (const auto& meta : vstorage->GetBlobFiles()) {
+    rpc_params->blob_files.emplace_back(
+        meta->GetBlobFileNumber(), meta->GetTotalBlobCount(),
+        meta->GetTotalBlobBytes(), meta->GetChecksumMethod(),
+        meta->GetChecksumValue());
+    if (meta->GetGarbageBlobCount() > 0) {
+      rpc_params->blob_file_garbages.emplace_back(
+          meta->GetBlobFileNumber(), meta->GetGarbageBlobCount(),
+          meta->GetGarbageBlobBytes());
+    }
+    total_blob_bytes += meta->GetTotalBlobBytes();
+  }
+  rpc_params->enable_blob_files = mut_cfo->enable_blob_files;
+  // blob_separation_policy is stateful and local, the worker separates
+  // values by min_blob_size
+  rpc_params->min_blob_size = mut_cfo->min_blob_size;
+  rpc_params->blob_file_size = mut_cfo->blob_file_size;
+  rpc_params->blob_compression_type = mut_cfo->blob_compression_type;
+  rpc_params->enable_blob_garbage_collection =
+      c->enable_blob_garbage_collection();
+  rpc_params->blob_garbage_collection_age_cutoff =
+      c->blob_garbage_collection_age_cutoff();
+  rpc_params->blob_compaction_readahead_size =
+      mut_cfo->blob_compaction_readahead_size;
+  rpc_params->blob_file_starting_level = mut_cfo->blob_file_starting_level;
+
+  if (!mut_cfo->enable_blob_files && rpc_params->blob_files.empty()) {
+    return;
+  }
+  // Output files of the worker, both SSTs and blob files, are numbered from
+  // a range reserved here, it is generous because file numbers are cheap
+  size_t input_bytes[2];
+  rpc_params->InputBytes(input_bytes);
+  uint64_t out_bytes = input_bytes[0];
+  if (c->enable_blob_garbage_collection()) {
+    out_bytes += total_blob_bytes;
+  }
+  uint64_t min_file_size = mut_cfo->blob_file_size;
+  if (c->max_output_file_size()) {
+    min_file_size = std::min(min_file_size, c->max_output_file_size());
+  }
+  min_file_size = std::max<uint64_t>(min_file_size, 1 << 20);
+  const uint64_t num_reserved =
+      2 * (out_bytes / min_file_size + rpc_params->max_subcompactions + 1);
+  rpc_params->version_set.next_file_number =
+      versions_->FetchAddFileNumber(num_reserved);
+  rpc_params->reserved_file_number_end =
+      rpc_params->version_set.next_file_number + num_reserved;
+}
+
 Status CompactionJob::RunRemote()
 try {
   ROCKSDB_VERIFY_F(nullptr == snapshot_checker_,
@@ -945,6 +1125,7 @@ try {
 //rpc_params.compaction_job_stats = this->compaction_job_stats_;
 //rpc_params.max_subcompactions = uint32_t(num_threads);
   rpc_params.max_subcompactions = c->max_subcompactions();
+  rpc_params.l0_range_split = c->l0_range_split();
   rpc_params.shutting_down = this->shutting_down_;
 
   const uint64_t start_micros = env_->NowMicros();
@@ -953,6 +1134,15 @@ try {
   auto exec = exec_factory->NewExecutor(c);
   std::unique_ptr<CompactionExecutor> exec_auto_del(exec);
   exec->SetParams(&rpc_params, c);
+  // the worker builds its outputs with the compression threads of this
+  // compaction, see DBOptions::compaction_compression_threads
+  rpc_params.compression_opts.parallel_threads =
+      c->output_compression_opts().parallel_threads;
+  if (!c->untouched_files().empty()) {
+    rpc_params.inputs = c->rewrite_inputs();
+    rpc_params.untouched_files = &c->untouched_files();
+  }
+  SetBlobParams(&rpc_params);
   Status s = exec->Execute(rpc_params, &rpc_results);
   if (!s.ok()) {
     compact_->status = s;
@@ -962,6 +1152,31 @@ try {
     compact_->status = rpc_results.status;
     return rpc_results.status;
   }
+  // outputs of a faulty worker may overlap the untouched files, they must
+  // not be installed. The error is retryable, so the compaction is picked
+  // again instead of stopping background work.
+  if (!c->untouched_files().empty()) {
+    auto ucmp = cfd->user_comparator();
+    for (const auto& sub_outputs : rpc_results.output_files) {
+      for (const auto& min_meta : sub_outputs) {
+        for (const FileMetaData* f : c->untouched_files()) {
+          const Slice lo = min_meta.smallest_ikey.user_key();
+          const Slice hi = min_meta.largest_ikey.user_key();
+          if (ucmp->CompareWithoutTimestamp(lo, f->largest.user_key()) <= 0 &&
+              ucmp->CompareWithoutTimestamp(f->smallest.user_key(), hi) <= 0) {
+            IOStatus io_s =
+                IOStatus::IOError("dcompact output overlaps untouched file",
+                                  std::to_string(f->fd.GetNumber()));
+            io_s.SetRetryable(true);
+            s = io_s;
+            exec->CleanFiles(rpc_params, rpc_results);
+            compact_->status = s;
+            return s;
+          }
+        }
+      }
+    }
+  }
   //exec->NotifyResults(&rpc_results, c);
 
   // remote compact fabricates a version_set, which may cause
@@ -998,6 +1213,49 @@ try {
     }
   }
 
+  // blob files keep the numbers the worker gave them, output SSTs refer to
+  // them by number. Numbers are checked before any file is moved into the
+  // db, a faulty worker must not shadow live files, the error is retryable
+  // as above.
+  const auto* vstorage = c->input_version()->storage_info();
+  for (const auto& blob : rpc_results.blob_file_additions) {
+    const uint64_t file_number = blob.GetBlobFileNumber();
+    if (file_number < rpc_params.version_set.next_file_number ||
+        file_number >= rpc_params.reserved_file_number_end) {
+      IOStatus io_s =
+          IOStatus::IOError("dcompact blob file number is not reserved",
+                            std::to_string(file_number));
+      io_s.SetRetryable(true);
+      s = io_s;
+      exec->CleanFiles(rpc_params, rpc_results);
+      compact_->status = s;
+      return s;
+    }
+  }
+  for (const auto& sub_outputs : rpc_results.output_files) {
+    for (const auto& min_meta : sub_outputs) {
+      const uint64_t blob_number = min_meta.oldest_blob_file_number;
+      if (blob_number == kInvalidBlobFileNumber ||
+          vstorage->GetBlobFileMetaData(blob_number)) {
+        continue;
+      }
+      bool added = false;
+      for (const auto& blob : rpc_results.blob_file_additions) {
+        added = added || blob.GetBlobFileNumber() == blob_number;
+      }
+      if (!added) {
+        IOStatus io_s =
+            IOStatus::IOError("dcompact output refers to unknown blob file",
+                              std::to_string(blob_number));
+        io_s.SetRetryable(true);
+        s = io_s;
+        exec->CleanFiles(rpc_params, rpc_results);
+        compact_->status = s;
+        return s;
+      }
+    }
+  }
+
   long long rename_t0 = env_->NowMicros();
   size_t out_raw_bytes = 0;
   uint64_t epoch_number = c->MinInputFileEpochNumber();
@@ -1047,6 +1305,7 @@ try {
       meta.raw_key_size = tp->raw_key_size;
       meta.raw_value_size = tp->raw_value_size;
       meta.marked_for_compaction = min_meta.marked_for_compaction;
+      meta.oldest_blob_file_number = min_meta.oldest_blob_file_number;
       meta.epoch_number = epoch_number;
       bool enable_order_check = mut_cfo->check_flush_compaction_key_order;
       bool enable_hash = paranoid_file_checks_;
@@ -1064,6 +1323,32 @@ try {
     compact_->num_output_records += sub_state.num_output_records;
   }
   compact_->compaction->SetOutputTableProperties(std::move(tp_map));
+
+  if (!rpc_results.blob_file_additions.empty()) {
+    const std::string& blob_dir = imm_cfo->cf_paths.front().path;
+    for (const auto& blob : rpc_results.blob_file_additions) {
+      const uint64_t file_number = blob.GetBlobFileNumber();
+      auto old_fname = BlobFileName(rpc_results.output_dir, file_number);
+      auto new_fname = BlobFileName(blob_dir, file_number);
+      Status st = env_->RenameFile(old_fname, new_fname);
+      if (!st.ok()) {
+        ROCKS_LOG_ERROR(db_options_.info_log, "rename(%s, %s) = %s",
+            old_fname.c_str(), new_fname.c_str(), st.ToString().c_str());
+        compact_->status = st;
+        return st;
+      }
+      if (blob_callback_) {
+        blob_callback_->OnBlobFileCompleted(
+            new_fname, cfd->GetName(), job_id_, file_number,
+            BlobFileCreationReason::kCompaction, Status::OK(),
+            blob.GetChecksumValue(), blob.GetChecksumMethod(),
+            blob.GetTotalBlobCount(), blob.GetTotalBlobBytes())
+            .PermitUncheckedError();
+      }
+    }
+  }
+  remote_blob_file_additions_ = std::move(rpc_results.blob_file_additions);
+  remote_blob_file_garbages_ = std::move(rpc_results.blob_file_garbages);
   long long rename_t1 = env_->NowMicros();
 
   {
@@ -1118,8 +1403,10 @@ try {
   MoveTK(REMOTE_COMPACT_READ_BYTES,  COMPACT_READ_BYTES);
   MoveTK(REMOTE_COMPACT_WRITE_BYTES, COMPACT_WRITE_BYTES);
 
-  stats_->Merge(rpc_results.statistics.tickers,
-                rpc_results.statistics.histograms);
+  if (stats_) {  // DBOptions::statistics is optional
+    stats_->Merge(rpc_results.statistics.tickers,
+                  rpc_results.statistics.histograms);
+  }
 
   LogFlush(db_options_.info_log);
   TEST_SYNC_POINT("CompactionJob::RunRemote():End");
@@ -1165,10 +1452,17 @@ Status CompactionJob::Install(const MutableCFOptions& mutable_cf_options) {
   assert(cfd);
 
   int output_level = compact_->compaction->output_level();
+  compaction_stats_.stats.bytes_moved =
+      compact_->compaction->partial_move_bytes();
   cfd->internal_stats()->AddCompactionStats(output_level, thread_pri_,
                                             compaction_stats_);
 
   if (status.ok()) {
+    const auto& cstats = compaction_stats_.stats;
+    versions_->GetColumnFamilySet()->write_controller()->RecordCompaction(
+        cstats.bytes_read_non_output_levels + cstats.bytes_read_output_level +
+            cstats.bytes_read_blob,
+        run_remote_);
     status = InstallCompactionResults(mutable_cf_options);
   }
   if (!versions_->io_status().ok()) {
@@ -1277,6 +1571,10 @@ Status CompactionJob::Install(const MutableCFOptions& mutable_cf_options) {
          << compaction_job_stats_->num_single_del_mismatch;
   stream << "num_single_delete_fallthrough"
          << compaction_job_stats_->num_single_del_fallthru;
+  stream << "max_subcompaction_input_bytes"
+         << compaction_job_stats_->max_subcompaction_input_bytes
+         << "max_subcompaction_micros"
+         << compaction_job_stats_->max_subcompaction_micros;
 
   if (measure_io_stats_) {
     stream << "file_write_nanos" << compaction_job_stats_->file_write_nanos;
@@ -1398,6 +1696,7 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
 #endif  // !ROCKSDB_LITE
 
   uint64_t prev_cpu_micros = db_options_.clock->CPUMicros();
+  const uint64_t start_micros = db_options_.clock->NowMicros();
 
   ColumnFamilyData* cfd = sub_compact->compaction->column_family_data();
 
@@ -1731,6 +2030,13 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
 
   sub_compact->compaction_job_stats.cpu_micros =
       db_options_.clock->CPUMicros() - prev_cpu_micros;
+  // Aggregated into the count and the maximums by CompactionJobStats::Add()
+  sub_compact->compaction_job_stats.num_subcompactions = 1;
+  sub_compact->compaction_job_stats.max_subcompaction_input_bytes =
+      sub_compact->compaction_job_stats.total_input_raw_key_bytes +
+      sub_compact->compaction_job_stats.total_input_raw_value_bytes;
+  sub_compact->compaction_job_stats.max_subcompaction_micros =
+      db_options_.clock->NowMicros() - start_micros;
 
   if (measure_io_stats_) {
     sub_compact->compaction_job_stats.file_write_nanos +=
@@ -2022,37 +2328,25 @@ Status CompactionJob::InstallCompactionResults(
   // Add compaction inputs
   compaction->AddInputDeletions(edit);
 
-  std::unordered_map<uint64_t, BlobGarbageMeter::BlobStats> blob_total_garbage;
-
   for (const auto& sub_compact : compact_->sub_compact_states) {
     sub_compact.AddOutputsEdit(edit);
-
-    for (const auto& blob : sub_compact.Current().GetBlobFileAdditions()) {
-      edit->AddBlobFile(blob);
-    }
-
-    if (sub_compact.Current().GetBlobGarbageMeter()) {
-      const auto& flows = sub_compact.Current().GetBlobGarbageMeter()->flows();
-
-      for (const auto& pair : flows) {
-        const uint64_t blob_file_number = pair.first;
-        const BlobGarbageMeter::BlobInOutFlow& flow = pair.second;
-
-        assert(flow.IsValid());
-        if (flow.HasGarbage()) {
-          blob_total_garbage[blob_file_number].Add(flow.GetGarbageCount(),
-                                                   flow.GetGarbageBytes());
-        }
-      }
-    }
   }
 
-  for (const auto& pair : blob_total_garbage) {
-    const uint64_t blob_file_number = pair.first;
-    const BlobGarbageMeter::BlobStats& stats = pair.second;
-
-    edit->AddBlobFileGarbage(blob_file_number, stats.GetCount(),
-                             stats.GetBytes());
+  std::vector<BlobFileAddition> blob_file_additions;
+  std::vector<BlobFileGarbage> blob_file_garbages;
+  GetBlobFileResults(&blob_file_additions, &blob_file_garbages);
+  for (auto& blob : blob_file_additions) {
+    edit->AddBlobFile(std::move(blob));
+  }
+  for (auto& garbage : blob_file_garbages) {
+    edit->AddBlobFileGarbage(std::move(garbage));
+  }
+  // dcompact blob results, see RunRemote
+  for (auto& blob : remote_blob_file_additions_) {
+    edit->AddBlobFile(std::move(blob));
+  }
+  for (auto& garbage : remote_blob_file_garbages_) {
+    edit->AddBlobFileGarbage(std::move(garbage));
   }
 
 #if defined(ROCKSDB_UNIT_TEST)
@@ -2291,11 +2585,13 @@ void CompactionJob::UpdateCompactionInputStatsHelper(int* num_files,
                                                      uint64_t* bytes_read,
                                                      int input_level) {
   const Compaction* compaction = compact_->compaction;
-  auto num_input_files = compaction->num_input_files(input_level);
+  // Untouched files are not read
+  const LevelFilesBrief* flevel = compaction->input_levels(input_level);
+  auto num_input_files = flevel->num_files;
   *num_files += static_cast<int>(num_input_files);
 
   for (size_t i = 0; i < num_input_files; ++i) {
-    const auto* file_meta = compaction->input(input_level, i);
+    const auto* file_meta = flevel->files[i].file_metadata;
     *bytes_read += file_meta->fd.GetFileSize();
     compaction_stats_.stats.num_input_records +=
         static_cast<uint64_t>(file_meta->num_entries);
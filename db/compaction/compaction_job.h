@@ -49,6 +49,7 @@
 namespace ROCKSDB_NAMESPACE {
 
 class Arena;
+struct CompactionParams;
 class CompactionState;
 class ErrorHandler;
 class MemTable;
@@ -184,6 +185,16 @@ class CompactionJob {
   // subcompaction results
   Status Run();
 
+  // Whether Run() sends the compaction to the compaction_executor_factory,
+  // decided by Prepare()
+  bool WillRunRemote() const { return will_run_remote_; }
+
+  // Called by Run() without the mutex as soon as the remote run returned,
+  // before a failed one falls back to a local run
+  void SetRemoteDoneCallback(std::function<void()> callback) {
+    remote_done_callback_ = std::move(callback);
+  }
+
   // REQUIRED: mutex held
   // Add compaction input/output to the current version
   Status Install(const MutableCFOptions& mutable_cf_options);
@@ -192,6 +203,10 @@ class CompactionJob {
   IOStatus io_status() const { return io_status_; }
 
   void GetSubCompactOutputs(std::vector<std::vector<const FileMetaData*> >*) const;
+  // blob files written by the compaction and the garbage it produced in the
+  // input blob files, a compaction worker returns them in CompactionResults
+  void GetBlobFileResults(std::vector<BlobFileAddition>*,
+                          std::vector<BlobFileGarbage>*) const;
   CompactionJobStats* GetCompactionJobStats() const { return compaction_job_stats_; }
   const InternalStats::CompactionStatsFull& GetCompactionStats() const { return compaction_stats_; }
 
@@ -207,6 +222,12 @@ class CompactionJob {
 
   CompactionState* compact_;
   InternalStats::CompactionStatsFull compaction_stats_;
+  // compaction_stats_ came from a CompactionExecutor
+  bool run_remote_ = false;
+  bool will_run_remote_ = false;
+  std::function<void()> remote_done_callback_;
+  std::vector<BlobFileAddition> remote_blob_file_additions_;
+  std::vector<BlobFileGarbage> remote_blob_file_garbages_;
   const ImmutableDBOptions& db_options_;
   const MutableDBOptions mutable_db_options_copy_;
   LogBuffer* log_buffer_;
@@ -278,6 +299,7 @@ class CompactionJob {
 
   Status RunLocal();
   Status RunRemote();
+  void SetBlobParams(CompactionParams*) const;
 
   uint32_t job_id_;
 
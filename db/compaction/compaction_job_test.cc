@@ -16,9 +16,11 @@
 
 #include "db/blob/blob_index.h"
 #include "db/column_family.h"
+#include "db/compaction/compaction_executor.h"
 #include "db/db_impl/db_impl.h"
 #include "db/error_handler.h"
 #include "db/version_set.h"
+#include "file/file_util.h"
 #include "file/random_access_file_reader.h"
 #include "file/writable_file_writer.h"
 #include "options/options_helper.h"
@@ -668,6 +670,14 @@ class CompactionJobTestBase : public testing::Test {
     compaction_job.Prepare();
     mutex_.Unlock();
     Status s = compaction_job.Run();
+    if (expect_retryable_error_) {
+      ASSERT_TRUE(s.IsIOError());
+      ASSERT_TRUE(status_to_io_status(Status(s)).GetRetryable());
+      mutex_.Lock();
+      ASSERT_EQ(s, compaction_job.Install(*cfd->GetLatestMutableCFOptions()));
+      mutex_.Unlock();
+      return;
+    }
     ASSERT_OK(s);
     ASSERT_OK(compaction_job.io_status());
     mutex_.Lock();
@@ -743,6 +753,8 @@ class CompactionJobTestBase : public testing::Test {
   const std::function<std::string(uint64_t)> encode_u64_ts_;
   const bool test_io_priority_;
   std::function<void(Compaction& comp)> verify_per_key_placement_;
+  // RunCompaction() expects CompactionJob::Run() to fail retryably
+  bool expect_retryable_error_ = false;
   const TableTypeForTest table_type_ = kMockTable;
 };
 
@@ -1459,6 +1471,160 @@ TEST_F(CompactionJobTest, OldestBlobFileNumber) {
                 /* expected_oldest_blob_file_numbers */ {19});
 }
 
+TEST_F(CompactionJobTest, RemoteBlobOutputs) {
+  // A worker writing one SST and the blob file it refers to, numbered from
+  // the range reserved by CompactionJob::SetBlobParams()
+  struct Worker {
+    std::string output_dir;
+    mock::KVVector contents;
+    uint64_t next_file_number = 0;
+    uint64_t reserved_file_number_end = 0;
+    uint64_t blob_file_number = 0;
+    bool out_of_range = false;
+  };
+  class StubExecutor : public CompactionExecutor {
+   public:
+    StubExecutor(Worker* worker, Env* env,
+                 std::shared_ptr<mock::MockTableFactory> table_factory)
+        : worker_(worker), env_(env), table_factory_(table_factory) {}
+    void SetParams(CompactionParams* params, const Compaction* c) override {
+      params->inputs = c->inputs();
+    }
+    Status Execute(const CompactionParams& params,
+                   CompactionResults* results) override {
+      worker_->next_file_number = params.version_set.next_file_number;
+      worker_->reserved_file_number_end = params.reserved_file_number_end;
+      const uint64_t sst_number = params.version_set.next_file_number;
+      worker_->blob_file_number = worker_->out_of_range
+                                      ? params.reserved_file_number_end
+                                      : sst_number + 1;
+      const uint64_t blob_number = worker_->blob_file_number;
+      worker_->contents[0].second = BlobStr(blob_number, 0, 4);
+      Status s = env_->CreateDirIfMissing(worker_->output_dir);
+      if (s.ok()) {
+        s = WriteStringToFile(env_, "blob",
+                              BlobFileName(worker_->output_dir, blob_number));
+      }
+      if (s.ok()) {
+        s = table_factory_->CreateMockTable(
+            env_, MakeTableFileName(worker_->output_dir, sst_number),
+            worker_->contents);
+      }
+      if (!s.ok()) {
+        return s;
+      }
+      CompactionResults::FileMinMeta min_meta;
+      min_meta.file_number = sst_number;
+      min_meta.file_size = 10;
+      min_meta.smallest_seqno = 0;
+      min_meta.largest_seqno = 0;
+      min_meta.smallest_ikey.DecodeFrom(worker_->contents.front().first);
+      min_meta.largest_ikey.DecodeFrom(worker_->contents.back().first);
+      min_meta.marked_for_compaction = false;
+      min_meta.oldest_blob_file_number = blob_number;
+      results->output_dir = worker_->output_dir;
+      results->output_files.resize(1);
+      results->output_files[0].push_back(min_meta);
+      results->blob_file_additions.emplace_back(blob_number, 1, 4, "", "");
+      results->job_stats.num_input_files = 1;
+      results->job_stats.num_output_files = 1;
+      results->status = Status::OK();
+      return Status::OK();
+    }
+    void CleanFiles(const CompactionParams&,
+                    const CompactionResults&) override {}
+
+   private:
+    Worker* worker_;
+    Env* env_;
+    std::shared_ptr<mock::MockTableFactory> table_factory_;
+  };
+  class StubExecutorFactory : public CompactionExecutorFactory {
+   public:
+    StubExecutorFactory(Worker* worker, Env* env,
+                        std::shared_ptr<mock::MockTableFactory> table_factory)
+        : worker_(worker), env_(env), table_factory_(table_factory) {}
+    bool ShouldRunLocal(const Compaction*) const override { return false; }
+    bool AllowFallbackToLocal() const override { return false; }
+    CompactionExecutor* NewExecutor(const Compaction*) const override {
+      return new StubExecutor(worker_, env_, table_factory_);
+    }
+    const char* Name() const override { return "StubExecutorFactory"; }
+
+   private:
+    Worker* worker_;
+    Env* env_;
+    std::shared_ptr<mock::MockTableFactory> table_factory_;
+  };
+
+  for (bool out_of_range : {false, true}) {
+    Worker worker;
+    worker.output_dir = dbname_ + "/dcompact_out";
+    worker.out_of_range = out_of_range;
+    cf_options_.enable_blob_files = true;
+    cf_options_.compaction_executor_factory =
+        std::make_shared<StubExecutorFactory>(&worker, env_,
+                                              mock_table_factory_);
+    NewDB();
+
+    auto file1 = mock::MakeMockFile({{KeyStr("a", 1U, kTypeValue), "val1"},
+                                     {KeyStr("b", 2U, kTypeValue), "val2"}});
+    AddMockFile(file1);
+    SetLastSequence(2U);
+
+    // the value of "a" is moved to the blob file by the worker
+    worker.contents = mock::MakeMockFile(
+        {{KeyStr("a", 0U, kTypeBlobIndex), ""},
+         {KeyStr("b", 0U, kTypeValue), "val2"}});
+
+    constexpr int input_level = 0;
+    auto files = cfd_->current()->storage_info()->LevelFiles(input_level);
+    expect_retryable_error_ = out_of_range;
+    RunCompaction({files}, {input_level}, {worker.contents},
+                  std::vector<SequenceNumber>(), kMaxSequenceNumber,
+                  /* output_level */ 1, /* verify */ false);
+    expect_retryable_error_ = false;
+
+    ASSERT_LT(worker.next_file_number, worker.reserved_file_number_end);
+    ASSERT_GE(versions_->current_next_file_number(),
+              worker.reserved_file_number_end);
+    const std::string blob_fname =
+        BlobFileName(dbname_, worker.blob_file_number);
+    const auto* vstorage = cfd_->current()->storage_info();
+    if (out_of_range) {
+      // nothing of the worker is moved into the db or installed
+      ASSERT_TRUE(env_->FileExists(blob_fname).IsNotFound());
+      ASSERT_EQ(0, vstorage->NumLevelFiles(1));
+      ASSERT_EQ(nullptr,
+                vstorage->GetBlobFileMetaData(worker.blob_file_number));
+      ASSERT_OK(DestroyDir(env_, worker.output_dir));
+      continue;
+    }
+    ASSERT_OK(env_->FileExists(blob_fname));
+    ASSERT_TRUE(
+        env_->FileExists(BlobFileName(worker.output_dir,
+                                      worker.blob_file_number))
+            .IsNotFound());
+    ASSERT_TRUE(env_->FileExists(MakeTableFileName(worker.output_dir,
+                                                   worker.next_file_number))
+                    .IsNotFound());
+
+    // the output SST is renumbered, the blob file keeps its number
+    ASSERT_EQ(1, vstorage->NumLevelFiles(1));
+    const FileMetaData* output = vstorage->LevelFiles(1)[0];
+    ASSERT_NE(worker.next_file_number, output->fd.GetNumber());
+    ASSERT_GE(output->fd.GetNumber(), worker.reserved_file_number_end);
+    ASSERT_OK(env_->FileExists(GenerateFileName(output->fd.GetNumber())));
+    ASSERT_EQ(worker.blob_file_number, output->oldest_blob_file_number);
+    auto blob_meta = vstorage->GetBlobFileMetaData(worker.blob_file_number);
+    ASSERT_NE(nullptr, blob_meta);
+    ASSERT_EQ(1U, blob_meta->GetTotalBlobCount());
+    ASSERT_EQ(4U, blob_meta->GetTotalBlobBytes());
+    mock_table_factory_->AssertLatestFiles({worker.contents});
+    ASSERT_OK(DestroyDir(env_, worker.output_dir));
+  }
+}
+
 TEST_F(CompactionJobTest, VerifyPenultimateLevelOutput) {
   cf_options_.bottommost_temperature = Temperature::kCold;
   SyncPoint::GetInstance()->SetCallBack(
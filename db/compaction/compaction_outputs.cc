@@ -193,10 +193,28 @@ bool CompactionOutputs::ShouldStopBefore(const CompactionIterator& c_iter) {
   size_t num_grandparent_boundaries_crossed =
       UpdateGrandparentBoundaryInfo(internal_key);
 
+  // An output file must not span an untouched input file, which stays in or
+  // is moved to the output level
+  const std::vector<FileMetaData*>& untouched = compaction_->untouched_files();
+  bool untouched_file_crossed = false;
+  while (untouched_file_index_ < untouched.size() &&
+         compaction_->column_family_data()
+                 ->user_comparator()
+                 ->CompareWithoutTimestamp(
+                     untouched[untouched_file_index_]->smallest.user_key(),
+                     c_iter.user_key()) < 0) {
+    untouched_file_index_++;
+    untouched_file_crossed = true;
+  }
+
   if (!HasBuilder()) {
     return false;
   }
 
+  if (untouched_file_crossed) {
+    return true;
+  }
+
   // If there's user defined partitioner, check that first
   if (partitioner_ && partitioner_->ShouldPartition(PartitionerRequest(
                           last_key_for_partitioner_, c_iter.user_key(),
@@ -648,10 +666,10 @@ Status CompactionOutputs::AddRangeDels(
 }
 
 void CompactionOutputs::FillFilesToCutForTtl() {
+  const CompactionPri pri = compaction_->immutable_options()->compaction_pri;
   if (compaction_->immutable_options()->compaction_style !=
           kCompactionStyleLevel ||
-      compaction_->immutable_options()->compaction_pri !=
-          kMinOverlappingRatio ||
+      (pri != kMinOverlappingRatio && pri != kReadHeatOverlappingRatio) ||
       compaction_->mutable_cf_options()->ttl == 0 ||
       compaction_->num_input_levels() < 2 || compaction_->bottommost_level()) {
     return;
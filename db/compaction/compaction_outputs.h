@@ -326,6 +326,9 @@ class CompactionOutputs {
   // An index that used to speed up ShouldStopBefore().
   size_t grandparent_index_ = 0;
 
+  // The first of Compaction::untouched_files() after the last key
+  size_t untouched_file_index_ = 0;
+
   // if the output key is being grandparent files gap, so:
   //  key > grandparents[grandparent_index_ - 1].largest &&
   //  key < grandparents[grandparent_index_].smallest
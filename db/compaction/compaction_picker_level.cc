@@ -9,12 +9,14 @@
 
 #include "db/compaction/compaction_picker_level.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "db/version_edit.h"
 #include "logging/log_buffer.h"
+#include "logging/logging.h"
 #include "test_util/sync_point.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -83,6 +85,10 @@ class LevelCompactionBuilder {
 
   Compaction* GetCompaction();
 
+  // Return the number of key range slices for an L0 -> base level
+  // compaction when L0 piles up, or 0 if it should not be split.
+  uint32_t GetL0RangeSplits() const;
+
   // For the specfied level, pick a file that we want to compact.
   // Returns false if there is no file to compact.
   // If it returns true, inputs->files.size() will be exactly one for
@@ -106,6 +112,14 @@ class LevelCompactionBuilder {
   // otherwise, returns false.
   bool PickIntraL0Compaction();
 
+  // For L0->L0, merges the newest L0 sorted runs instead of compacting L0 to
+  // the base level while L0 is tiered, see
+  // AdvancedColumnFamilyOptions::level0_tiered_write_rate.
+  //
+  // Returns true if `inputs` is populated with a span of files to be compacted;
+  // otherwise, returns false.
+  bool PickTieredL0Compaction();
+
   // Return true if TrivialMove is extended. `start_index` is the index of
   // the intiial file picked, which should already be in `start_level_inputs_`.
   bool TryExtendNonL0TrivialMove(int start_index);
@@ -191,6 +205,11 @@ void LevelCompactionBuilder::SetupInitialFiles() {
         // may starve.
         continue;
       }
+      if (start_level_ == 0 && PickTieredL0Compaction()) {
+        output_level_ = 0;
+        compaction_reason_ = CompactionReason::kLevelL0FilesNum;
+        break;
+      }
       output_level_ =
           (start_level_ == 0) ? vstorage_->base_level() : start_level_ + 1;
       bool picked_file_to_compact = PickFileToCompact();
@@ -507,7 +526,39 @@ Compaction* LevelCompactionBuilder::PickCompaction() {
   return c;
 }
 
+uint32_t LevelCompactionBuilder::GetL0RangeSplits() const {
+  if (start_level_ != 0 || output_level_ == 0 || is_l0_trivial_move_ ||
+      mutable_db_options_.max_level0_range_splits <= 1) {
+    return 0;
+  }
+  // Not piled up, it is drained by one compaction as usual
+  const int trigger =
+      std::max(mutable_cf_options_.level0_file_num_compaction_trigger, 1);
+  if (vstorage_->NumLevelFiles(0) < 2 * trigger) {
+    return 0;
+  }
+  // Each slice covers at least one output level file
+  size_t num_output_level_files = output_level_inputs_.size();
+  if (num_output_level_files <= 1) {
+    return 0;
+  }
+  uint32_t splits = static_cast<uint32_t>(
+      std::min<size_t>(mutable_db_options_.max_level0_range_splits,
+                       num_output_level_files));
+  // Without the split, subcompactions may cut anywhere in the key space, so
+  // the split only pays off when the output level files allow more ranges
+  uint32_t subcompactions =
+      output_level_ == 1 && mutable_db_options_.max_level1_subcompactions
+          ? mutable_db_options_.max_level1_subcompactions
+          : mutable_db_options_.max_subcompactions;
+  if (splits <= subcompactions) {
+    return 0;
+  }
+  return splits;
+}
+
 Compaction* LevelCompactionBuilder::GetCompaction() {
+  const uint32_t l0_range_splits = GetL0RangeSplits();
   auto c = new Compaction(
       vstorage_, ioptions_, mutable_cf_options_, mutable_db_options_,
       std::move(compaction_inputs_), output_level_,
@@ -520,10 +571,19 @@ Compaction* LevelCompactionBuilder::GetCompaction() {
                          vstorage_->base_level()),
       GetCompressionOptions(mutable_cf_options_, vstorage_, output_level_),
       Temperature::kUnknown,
-      /* max_subcompactions */ 0, std::move(grandparents_), is_manual_,
+      /* max_subcompactions */ l0_range_splits, std::move(grandparents_),
+      is_manual_,
       /* trim_ts */ "", start_level_score_, false /* deletion_compaction */,
       /* l0_files_might_overlap */ start_level_ == 0 && !is_l0_trivial_move_,
       compaction_reason_);
+  if (l0_range_splits > 0) {
+    c->set_l0_range_split(true);
+    ROCKS_LOG_BUFFER(log_buffer_,
+                     "[%s] Splitting L0 -> L%d compaction of %" ROCKSDB_PRIszt
+                     " L0 files into up to %u key ranges",
+                     cf_name_.c_str(), output_level_,
+                     start_level_inputs_.size(), l0_range_splits);
+  }
 
   // If it's level 0 compaction, make sure we don't execute any other level 0
   // compactions in parallel
@@ -834,6 +894,45 @@ bool LevelCompactionBuilder::PickIntraL0Compaction() {
                                mutable_cf_options_.max_compaction_bytes,
                                &start_level_inputs_);
 }
+
+bool LevelCompactionBuilder::PickTieredL0Compaction() {
+  const uint64_t tiered_write_rate =
+      mutable_cf_options_.level0_tiered_write_rate;
+  const uint64_t l0_bytes = vstorage_->NumLevelBytes(0);
+  if (tiered_write_rate == 0 ||
+      l0_bytes >= mutable_cf_options_.max_bytes_for_level_base) {
+    return false;
+  }
+  int64_t now = 0;
+  if (!ioptions_.clock->GetCurrentTime(&now).ok()) {
+    return false;
+  }
+  // All bytes now in L0 were written since the oldest ancestor time of L0
+  const std::vector<FileMetaData*>& level_files =
+      vstorage_->LevelFiles(0 /* level */);
+  uint64_t oldest_time = kUnknownOldestAncesterTime;
+  for (FileMetaData* f : level_files) {
+    uint64_t t = f->TryGetOldestAncesterTime();
+    if (t != kUnknownOldestAncesterTime &&
+        (oldest_time == kUnknownOldestAncesterTime || t < oldest_time)) {
+      oldest_time = t;
+    }
+  }
+  if (oldest_time == kUnknownOldestAncesterTime) {
+    return false;
+  }
+  uint64_t seconds = static_cast<uint64_t>(now) > oldest_time
+                         ? static_cast<uint64_t>(now) - oldest_time
+                         : 1;
+  if (l0_bytes / seconds < tiered_write_rate) {
+    return false;
+  }
+  start_level_inputs_.clear();
+  return FindIntraL0Compaction(level_files, kMinFilesForIntraL0Compaction,
+                               std::numeric_limits<uint64_t>::max(),
+                               mutable_cf_options_.max_compaction_bytes,
+                               &start_level_inputs_);
+}
 }  // namespace
 
 Compaction* LevelCompactionPicker::PickCompaction(
@@ -253,6 +253,73 @@ TEST_F(CompactionPickerTest, Level0Trigger) {
   ASSERT_EQ(2U, compaction->input(0, 1)->fd.GetNumber());
 }
 
+TEST_F(CompactionPickerTest, Level0RangeSplit) {
+  NewVersionStorage(6, kCompactionStyleLevel);
+  mutable_cf_options_.level0_file_num_compaction_trigger = 2;
+  mutable_db_options_.max_level0_range_splits = 8;
+  Add(0, 1U, "150", "400");
+  Add(0, 2U, "160", "390");
+  Add(0, 3U, "170", "380");
+  Add(0, 4U, "180", "370");
+  Add(1, 11U, "100", "200");
+  Add(1, 12U, "210", "300");
+  Add(1, 13U, "310", "400");
+  UpdateVersionStorageInfo();
+
+  std::unique_ptr<Compaction> compaction(level_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, mutable_db_options_, vstorage_.get(),
+      &log_buffer_));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_EQ(4U, compaction->num_input_files(0));
+  ASSERT_EQ(3U, compaction->num_input_files(1));
+  ASSERT_TRUE(compaction->l0_range_split());
+  // At most one key range per L1 file
+  ASSERT_EQ(3U, compaction->max_subcompactions());
+}
+
+TEST_F(CompactionPickerTest, Level0RangeSplitFewerThanSubcompactions) {
+  NewVersionStorage(6, kCompactionStyleLevel);
+  mutable_cf_options_.level0_file_num_compaction_trigger = 2;
+  mutable_db_options_.max_level0_range_splits = 8;
+  mutable_db_options_.max_subcompactions = 4;
+  Add(0, 1U, "150", "400");
+  Add(0, 2U, "160", "390");
+  Add(0, 3U, "170", "380");
+  Add(0, 4U, "180", "370");
+  Add(1, 11U, "100", "200");
+  Add(1, 12U, "210", "300");
+  Add(1, 13U, "310", "400");
+  UpdateVersionStorageInfo();
+
+  std::unique_ptr<Compaction> compaction(level_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, mutable_db_options_, vstorage_.get(),
+      &log_buffer_));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_EQ(4U, compaction->num_input_files(0));
+  // 3 L1 files give fewer ranges than 4 subcompactions cutting anywhere
+  ASSERT_FALSE(compaction->l0_range_split());
+  ASSERT_EQ(4U, compaction->max_subcompactions());
+}
+
+TEST_F(CompactionPickerTest, Level0RangeSplitNotPiledUp) {
+  NewVersionStorage(6, kCompactionStyleLevel);
+  mutable_cf_options_.level0_file_num_compaction_trigger = 2;
+  mutable_db_options_.max_level0_range_splits = 8;
+  Add(0, 1U, "150", "400");
+  Add(0, 2U, "160", "390");
+  Add(1, 11U, "100", "200");
+  Add(1, 12U, "210", "300");
+  Add(1, 13U, "310", "400");
+  UpdateVersionStorageInfo();
+
+  std::unique_ptr<Compaction> compaction(level_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, mutable_db_options_, vstorage_.get(),
+      &log_buffer_));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_EQ(2U, compaction->num_input_files(0));
+  ASSERT_FALSE(compaction->l0_range_split());
+}
+
 TEST_F(CompactionPickerTest, Level1Trigger) {
   NewVersionStorage(6, kCompactionStyleLevel);
   Add(1, 66U, "150", "200", 1000000000U);
@@ -1368,6 +1435,41 @@ TEST_F(CompactionPickerTest, CompactionPriMinOverlapping4) {
   ASSERT_EQ(6U, compaction->input(0, 0)->fd.GetNumber());
 }
 
+TEST_F(CompactionPickerTest, CompactionPriReadHeatOverlappingRatio) {
+  for (bool hot : {false, true}) {
+    NewVersionStorage(6, kCompactionStyleLevel);
+    ioptions_.compaction_pri = kReadHeatOverlappingRatio;
+    mutable_cf_options_.max_bytes_for_level_base = 1000000;
+    mutable_cf_options_.max_bytes_for_level_multiplier = 10;
+
+    Add(2, 6U, "150", "199", 50000000U);  // Overlapping ratio 2
+    Add(2, 7U, "200", "299", 50000000U);  // Overlapping ratio 3
+
+    Add(3, 26U, "150", "199", 100000000U);
+    Add(3, 27U, "200", "299", 150000000U);
+    if (hot) {
+      const auto& files = vstorage_->LevelFiles(2);
+      files[0]->stats.num_reads_sampled = 1000;
+      files[1]->stats.num_reads_sampled = 100000;
+    }
+    UpdateVersionStorageInfo();
+
+    LevelCompactionPicker local_level_compaction_picker =
+        LevelCompactionPicker(ioptions_, &icmp_);
+    std::unique_ptr<Compaction> compaction(
+        local_level_compaction_picker.PickCompaction(
+            cf_name_, mutable_cf_options_, mutable_db_options_,
+            vstorage_.get(), &log_buffer_));
+    ASSERT_TRUE(compaction.get() != nullptr);
+    ASSERT_EQ(1U, compaction->num_input_files(0));
+    // Without reads, file 6 has the smallest overlapping ratio. File 7 is
+    // about twice as read-hot as the level average, so its score is divided
+    // by about 1 + 2, which outweighs its higher overlapping ratio.
+    ASSERT_EQ(hot ? 7U : 6U, compaction->input(0, 0)->fd.GetNumber());
+    DeleteVersionStorage();
+  }
+}
+
 TEST_F(CompactionPickerTest, CompactionPriRoundRobin) {
   std::vector<InternalKey> test_cursors = {InternalKey("249", 100, kTypeValue),
                                            InternalKey("600", 100, kTypeValue),
@@ -2873,6 +2975,45 @@ TEST_F(CompactionPickerTest, IntraL0MaxCompactionBytesHit) {
   ASSERT_EQ(0, compaction->output_level());
 }
 
+TEST_F(CompactionPickerTest, Level0TieredWriteRate) {
+  int64_t now = 0;
+  ASSERT_OK(ioptions_.clock->GetCurrentTime(&now));
+  // 4MB written to L0 in the last 10 seconds
+  const uint64_t oldest_time = static_cast<uint64_t>(now) - 10;
+  for (uint64_t tiered_write_rate : {0, 100000, 1000000}) {
+    mutable_cf_options_.level0_file_num_compaction_trigger = 4;
+    mutable_cf_options_.max_bytes_for_level_base = 64000000u;
+    mutable_cf_options_.max_compaction_bytes = 100000000u;
+    mutable_cf_options_.level0_tiered_write_rate = tiered_write_rate;
+    NewVersionStorage(6, kCompactionStyleLevel);
+
+    Add(0, 1U, "100", "350", 1000000U, 0, 100, 101, 0, false,
+        Temperature::kUnknown, oldest_time);
+    Add(0, 2U, "100", "350", 1000000U, 0, 102, 103, 0, false,
+        Temperature::kUnknown, oldest_time + 3);
+    Add(0, 3U, "100", "350", 1000000U, 0, 104, 105, 0, false,
+        Temperature::kUnknown, oldest_time + 6);
+    Add(0, 4U, "100", "350", 1000000U, 0, 106, 107, 0, false,
+        Temperature::kUnknown, oldest_time + 9);
+    Add(1, 6U, "100", "350", 1000000U, 0, 50, 51);
+    UpdateVersionStorageInfo();
+
+    LevelCompactionPicker local_level_compaction_picker =
+        LevelCompactionPicker(ioptions_, &icmp_);
+    std::unique_ptr<Compaction> compaction(
+        local_level_compaction_picker.PickCompaction(
+            cf_name_, mutable_cf_options_, mutable_db_options_,
+            vstorage_.get(), &log_buffer_));
+    ASSERT_TRUE(compaction.get() != nullptr);
+    ASSERT_EQ(4U, compaction->num_input_files(0));
+    ASSERT_EQ(CompactionReason::kLevelL0FilesNum,
+              compaction->compaction_reason());
+    // Tiered only while the measured rate reaches level0_tiered_write_rate
+    ASSERT_EQ(tiered_write_rate == 100000 ? 0 : 1,
+              compaction->output_level());
+    DeleteVersionStorage();
+  }
+}
 
 #ifndef ROCKSDB_LITE
 TEST_F(CompactionPickerTest, UniversalMarkedCompactionFullOverlap) {
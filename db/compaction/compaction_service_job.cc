@@ -627,6 +627,18 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct CompactionJobStats, num_single_del_mismatch),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"num_subcompactions",
+         {offsetof(struct CompactionJobStats, num_subcompactions),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"max_subcompaction_input_bytes",
+         {offsetof(struct CompactionJobStats, max_subcompaction_input_bytes),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"max_subcompaction_micros",
+         {offsetof(struct CompactionJobStats, max_subcompaction_micros),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
 };
 
 namespace {
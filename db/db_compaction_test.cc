@@ -11,6 +11,7 @@
 
 #include "compaction/compaction_picker_universal.h"
 #include "db/blob/blob_index.h"
+#include "db/compaction/compaction_executor.h"
 #include "db/db_test_util.h"
 #include "db/dbformat.h"
 #include "env/mock_env.h"
@@ -2634,6 +2635,571 @@ TEST_P(DBCompactionTestWithParam, ConvertCompactionStyle) {
   ASSERT_EQ(keys_in_db, expected_keys);
 }
 
+TEST_F(DBCompactionTest, Level0RangeSplit) {
+  Options options = CurrentOptions();
+  options.level0_file_num_compaction_trigger = 2;
+  options.target_file_size_base = 4 << 10;
+  options.max_level0_range_splits = 4;
+  options.max_subcompactions = 1;
+  options.disable_auto_compactions = true;
+  DestroyAndReopen(options);
+
+  // 4 L1 files over disjoint key ranges
+  Random rnd(301);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 100; j++) {
+      ASSERT_OK(Put(Key(i * 100 + j), rnd.RandomString(100)));
+    }
+    ASSERT_OK(Flush());
+  }
+  MoveFilesToLevel(1);
+  ASSERT_EQ(4, NumTableFilesAtLevel(1));
+
+  // 4 L0 files overlapping all of them
+  std::map<std::string, std::string> expected;
+  for (int i = 0; i < 4; i++) {
+    for (int j = i; j < 400; j += 4) {
+      expected[Key(j)] = rnd.RandomString(100);
+      ASSERT_OK(Put(Key(j), expected[Key(j)]));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ(4, NumTableFilesAtLevel(0));
+
+  uint64_t num_subcompactions = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "CompactionJob::GenSubcompactionBoundaries:1", [&](void* arg) {
+        num_subcompactions = *static_cast<uint64_t*>(arg);
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+  ASSERT_OK(dbfull()->EnableAutoCompaction({dbfull()->DefaultColumnFamily()}));
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  // Split although max_subcompactions is 1
+  ASSERT_GT(num_subcompactions, 1);
+  ASSERT_EQ(0, NumTableFilesAtLevel(0));
+  for (const auto& kv : expected) {
+    ASSERT_EQ(kv.second, Get(kv.first));
+  }
+}
+
+TEST_F(DBCompactionTest, SampledSubcompactionBoundaries) {
+  class StatsListener : public EventListener {
+   public:
+    void OnCompactionCompleted(DB* /*db*/,
+                               const CompactionJobInfo& ci) override {
+      stats_ = ci.stats;
+    }
+    CompactionJobStats stats_;
+  };
+  auto listener = std::make_shared<StatsListener>();
+
+  Options options = CurrentOptions();
+  options.compression = kNoCompression;
+  options.max_subcompactions = 4;
+  options.target_file_size_base = 64 << 10;
+  options.disable_auto_compactions = true;
+  options.listeners.push_back(listener);
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1 << 10;
+  table_options.enable_get_random_keys = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  // Most of the bytes are in the first 4% of the key space
+  Random rnd(301);
+  for (int i = 0; i < 4; i++) {
+    for (int j = i; j < 400; j += 4) {
+      ASSERT_OK(Put(Key(j), rnd.RandomString(1000)));
+    }
+    for (int j = 400 + i; j < 10000; j += 4) {
+      ASSERT_OK(Put(Key(j), rnd.RandomString(10)));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ(4, NumTableFilesAtLevel(0));
+
+  int num_sampled_files = 0;
+  uint64_t num_subcompactions = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "CompactionJob::GenSubcompactionBoundaries:Samples", [&](void* arg) {
+        auto* samples = static_cast<std::vector<std::string>*>(arg);
+        ASSERT_EQ(128, samples->size());
+        num_sampled_files++;
+      });
+  SyncPoint::GetInstance()->SetCallBack(
+      "CompactionJob::GenSubcompactionBoundaries:1", [&](void* arg) {
+        num_subcompactions = *static_cast<uint64_t*>(arg);
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+  ASSERT_OK(dbfull()->TEST_CompactRange(0, nullptr, nullptr));
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  ASSERT_EQ(4, num_sampled_files);
+  // The boundaries are quantiles of the sampled keys, so the dense part is
+  // spread over the subcompactions instead of falling into one of them
+  ASSERT_EQ(4, num_subcompactions);
+  const CompactionJobStats& stats = listener->stats_;
+  ASSERT_EQ(4, stats.num_subcompactions);
+  const uint64_t input_bytes =
+      stats.total_input_raw_key_bytes + stats.total_input_raw_value_bytes;
+  ASSERT_GT(stats.max_subcompaction_input_bytes, input_bytes / 4);
+  ASSERT_LT(stats.max_subcompaction_input_bytes, input_bytes / 2);
+}
+
+TEST_F(DBCompactionTest, PartialTrivialMove) {
+  Options options = CurrentOptions();
+  options.num_levels = 3;
+  options.compaction_pri = kRoundRobin;
+  options.compression = kNoCompression;
+  options.max_bytes_for_level_base = 1;
+  options.target_file_size_base = 1 << 20;
+  options.max_compaction_bytes = 1 << 30;
+  options.partial_trivial_move = true;
+  options.disable_auto_compactions = true;
+  options.statistics = CreateDBStatistics();
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  std::map<std::string, std::string> expected;
+  auto put_file = [&](int first, int level) {
+    for (int i = first; i < first + 10; i++) {
+      expected[Key(i)] = rnd.RandomString(100);
+      ASSERT_OK(Put(Key(i), expected[Key(i)]));
+    }
+    ASSERT_OK(Flush());
+    MoveFilesToLevel(level);
+  };
+  auto file_at = [&](int level, int first) -> LiveFileMetaData {
+    std::vector<LiveFileMetaData> metadata;
+    db_->GetLiveFilesMetaData(&metadata);
+    for (const auto& meta : metadata) {
+      if (meta.level == level && meta.smallestkey == Key(first)) {
+        return meta;
+      }
+    }
+    return LiveFileMetaData();
+  };
+  auto file_number_at = [&](int level, int first) -> uint64_t {
+    return file_at(level, first).file_number;
+  };
+
+  // L2: [0, 10) [30, 40) [50, 60)
+  put_file(0, 2);
+  put_file(30, 2);
+  put_file(50, 2);
+  // L1: [0, 10) [20, 30) [50, 60) [70, 80)
+  put_file(0, 1);
+  put_file(20, 1);
+  put_file(50, 1);
+  put_file(70, 1);
+  ASSERT_EQ("0,4,3", FilesPerLevel());
+  const uint64_t moved1 = file_number_at(1, 20);
+  const uint64_t moved2 = file_number_at(1, 70);
+  const uint64_t kept = file_number_at(2, 30);
+  ASSERT_NE(0U, moved1);
+  ASSERT_NE(0U, moved2);
+  ASSERT_NE(0U, kept);
+  // only the overlapping files are read
+  const uint64_t rewritten_bytes =
+      file_at(1, 0).size + file_at(1, 50).size + file_at(2, 0).size +
+      file_at(2, 50).size;
+  ASSERT_OK(options.statistics->Reset());
+
+  ASSERT_OK(dbfull()->EnableAutoCompaction({dbfull()->DefaultColumnFamily()}));
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  HistogramData input_zip_bytes;
+  options.statistics->histogramData(LCOMPACTION_INPUT_ZIP_BYTES,
+                                    &input_zip_bytes);
+  ASSERT_EQ(rewritten_bytes, input_zip_bytes.sum);
+
+  // [20, 30) and [70, 80) are moved, [30, 40) is kept, the rewritten outputs
+  // are cut around them
+  ASSERT_EQ("0,0,5", FilesPerLevel());
+  ASSERT_EQ(moved1, file_number_at(2, 20));
+  ASSERT_EQ(moved2, file_number_at(2, 70));
+  ASSERT_EQ(kept, file_number_at(2, 30));
+  for (const auto& kv : expected) {
+    ASSERT_EQ(kv.second, Get(kv.first));
+  }
+}
+
+TEST_F(DBCompactionTest, PartialTrivialMoveRemote) {
+  // Records the params a worker gets and fails, so the compaction falls back
+  // to local
+  struct Received {
+    int num_executes = 0;
+    size_t num_inputs = 0;
+    size_t num_untouched = 0;
+  };
+  class FailingExecutor : public CompactionExecutor {
+   public:
+    explicit FailingExecutor(Received* received) : received_(received) {}
+    void SetParams(CompactionParams* params, const Compaction* c) override {
+      params->inputs = c->inputs();
+    }
+    Status Execute(const CompactionParams& params,
+                   CompactionResults*) override {
+      received_->num_executes++;
+      received_->num_inputs = 0;
+      for (const auto& level_files : *params.inputs) {
+        received_->num_inputs += level_files.size();
+      }
+      received_->num_untouched =
+          params.untouched_files ? params.untouched_files->size() : 0;
+      return Status::NotSupported("FailingExecutor");
+    }
+    void CleanFiles(const CompactionParams&,
+                    const CompactionResults&) override {}
+
+   private:
+    Received* received_;
+  };
+  class FailingExecutorFactory : public CompactionExecutorFactory {
+   public:
+    explicit FailingExecutorFactory(bool supports_partial_trivial_move)
+        : supports_partial_trivial_move_(supports_partial_trivial_move) {}
+    bool ShouldRunLocal(const Compaction*) const override { return false; }
+    bool AllowFallbackToLocal() const override { return true; }
+    bool SupportsPartialTrivialMove() const override {
+      return supports_partial_trivial_move_;
+    }
+    CompactionExecutor* NewExecutor(const Compaction*) const override {
+      return new FailingExecutor(&received_);
+    }
+    const char* Name() const override { return "FailingExecutorFactory"; }
+    mutable Received received_;
+
+   private:
+    bool supports_partial_trivial_move_;
+  };
+
+  for (bool supported : {false, true}) {
+    auto factory = std::make_shared<FailingExecutorFactory>(supported);
+    Options options = CurrentOptions();
+    options.num_levels = 3;
+    options.compaction_pri = kRoundRobin;
+    options.compression = kNoCompression;
+    options.max_bytes_for_level_base = 1;
+    options.target_file_size_base = 1 << 20;
+    options.max_compaction_bytes = 1 << 30;
+    options.partial_trivial_move = true;
+    options.disable_auto_compactions = true;
+    options.compaction_executor_factory = factory;
+    DestroyAndReopen(options);
+
+    Random rnd(301);
+    auto put_file = [&](int first, int level) {
+      for (int i = first; i < first + 10; i++) {
+        ASSERT_OK(Put(Key(i), rnd.RandomString(100)));
+      }
+      ASSERT_OK(Flush());
+      MoveFilesToLevel(level);
+    };
+    // The same shape as PartialTrivialMove, 3 of the 7 inputs are untouched
+    put_file(0, 2);
+    put_file(30, 2);
+    put_file(50, 2);
+    put_file(0, 1);
+    put_file(20, 1);
+    put_file(50, 1);
+    put_file(70, 1);
+    ASSERT_EQ("0,4,3", FilesPerLevel());
+    factory->received_ = Received();
+
+    ASSERT_OK(
+        dbfull()->EnableAutoCompaction({dbfull()->DefaultColumnFamily()}));
+    ASSERT_OK(dbfull()->TEST_WaitForCompact());
+
+    const Received& received = factory->received_;
+    ASSERT_EQ(1, received.num_executes);
+    if (supported) {
+      ASSERT_EQ(4U, received.num_inputs);
+      ASSERT_EQ(3U, received.num_untouched);
+    } else {
+      // A worker unaware of untouched files gets all inputs
+      ASSERT_EQ(7U, received.num_inputs);
+      ASSERT_EQ(0U, received.num_untouched);
+    }
+    ASSERT_EQ(0, NumTableFilesAtLevel(1));
+  }
+}
+
+TEST_F(DBCompactionTest, StallAwareScheduling) {
+  Options options = CurrentOptions();
+  options.stall_aware_scheduling = true;
+  options.max_background_compactions = 1;
+  options.level0_file_num_compaction_trigger = 2;
+  options.level0_slowdown_writes_trigger = 20;
+  options.level0_stop_writes_trigger = 30;
+  options.statistics = CreateDBStatistics();
+  CreateAndReopenWithCF({"one", "two"}, options);
+
+  std::vector<std::string> compacted_cfs;
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::BackgroundCompaction:BeforeCompaction", [&](void* arg) {
+        compacted_cfs.push_back(static_cast<ColumnFamilyData*>(arg)->GetName());
+      });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  test::SleepingBackgroundTask sleeping_task;
+  env_->Schedule(&test::SleepingBackgroundTask::DoSleepTask, &sleeping_task,
+                 Env::Priority::LOW);
+  sleeping_task.WaitUntilSleeping();
+
+  // "one" is queued for compaction first, "two" has more L0 files
+  for (int i = 0; i < 2; i++) {
+    ASSERT_OK(Put(1, "a", "v" + std::to_string(i)));
+    ASSERT_OK(Put(1, "z", "v" + std::to_string(i)));
+    ASSERT_OK(Flush(1));
+  }
+  for (int i = 0; i < 4; i++) {
+    ASSERT_OK(Put(2, "a", "v" + std::to_string(i)));
+    ASSERT_OK(Put(2, "z", "v" + std::to_string(i)));
+    ASSERT_OK(Flush(2));
+  }
+
+  sleeping_task.WakeUp();
+  sleeping_task.WaitUntilDone();
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  ASSERT_EQ(compacted_cfs.size(), 2U);
+  ASSERT_EQ(compacted_cfs[0], "two");
+  ASSERT_EQ(compacted_cfs[1], "one");
+
+  HistogramData wait_data;
+  options.statistics->histogramData(COMPACTION_QUEUE_WAIT_MICROS, &wait_data);
+  ASSERT_GE(wait_data.count, 2U);
+  options.statistics->histogramData(FLUSH_QUEUE_WAIT_MICROS, &wait_data);
+  ASSERT_GE(wait_data.count, 6U);
+}
+
+TEST_F(DBCompactionTest, RemoteCompactionWait) {
+  // Checks the wait accounting while the worker runs, then fails so the
+  // compaction falls back to local
+  struct Observed {
+    DBCompactionTest* test = nullptr;
+    int num_executes = 0;
+    int waiting = 0;
+    int low_threads = 0;
+    // if > 0, the LOW pool is resized to it during the wait
+    int set_low_threads = 0;
+  };
+  class WaitingExecutor : public CompactionExecutor {
+   public:
+    explicit WaitingExecutor(Observed* observed) : observed_(observed) {}
+    void SetParams(CompactionParams* params, const Compaction* c) override {
+      params->inputs = c->inputs();
+    }
+    Status Execute(const CompactionParams&, CompactionResults*) override {
+      observed_->num_executes++;
+      observed_->waiting =
+          observed_->test->dbfull()->TEST_BGRemoteCompactionsWaiting();
+      observed_->low_threads =
+          observed_->test->env_->GetBackgroundThreads(Env::Priority::LOW);
+      if (observed_->set_low_threads > 0) {
+        observed_->test->env_->SetBackgroundThreads(
+            observed_->set_low_threads, Env::Priority::LOW);
+      }
+      return Status::NotSupported("WaitingExecutor");
+    }
+    void CleanFiles(const CompactionParams&,
+                    const CompactionResults&) override {}
+
+   private:
+    Observed* observed_;
+  };
+  class WaitingExecutorFactory : public CompactionExecutorFactory {
+   public:
+    bool ShouldRunLocal(const Compaction*) const override { return false; }
+    bool AllowFallbackToLocal() const override { return true; }
+    CompactionExecutor* NewExecutor(const Compaction*) const override {
+      return new WaitingExecutor(&observed_);
+    }
+    const char* Name() const override { return "WaitingExecutorFactory"; }
+    mutable Observed observed_;
+  };
+
+  const int saved_low_threads = env_->GetBackgroundThreads(Env::Priority::LOW);
+  env_->SetBackgroundThreads(1, Env::Priority::LOW);
+
+  auto factory = std::make_shared<WaitingExecutorFactory>();
+  factory->observed_.test = this;
+  Options options = CurrentOptions();
+  options.max_background_compactions = 1;
+  options.max_background_remote_compactions = 1;
+  options.level0_file_num_compaction_trigger = 2;
+  options.compaction_executor_factory = factory;
+  Reopen(options);
+  ASSERT_EQ(1, env_->GetBackgroundThreads(Env::Priority::LOW));
+
+  int waiting_on_fallback = -1;
+  int low_threads_on_fallback = -1;
+  auto on_fallback = [&](void*) {
+    waiting_on_fallback = dbfull()->TEST_BGRemoteCompactionsWaiting();
+    low_threads_on_fallback = env_->GetBackgroundThreads(Env::Priority::LOW);
+  };
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "CompactionJob::Run():Start", on_fallback);
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  for (int i = 0; i < 2; i++) {
+    ASSERT_OK(Put("a", "v" + std::to_string(i)));
+    ASSERT_OK(Put("z", "v" + std::to_string(i)));
+    ASSERT_OK(Flush());
+  }
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  // The remote wait got a thread of its own
+  ASSERT_EQ(1, factory->observed_.num_executes);
+  ASSERT_EQ(1, factory->observed_.waiting);
+  ASSERT_EQ(2, factory->observed_.low_threads);
+  // and gave it back before the local fallback
+  ASSERT_EQ(0, waiting_on_fallback);
+  ASSERT_EQ(1, low_threads_on_fallback);
+  ASSERT_EQ(0, NumTableFilesAtLevel(0));
+  ASSERT_EQ(1, NumTableFilesAtLevel(1));
+  ASSERT_EQ("v1", Get("a"));
+
+  // A pool size set by someone else during the wait is kept
+  factory->observed_.set_low_threads = 3;
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "CompactionJob::Run():Start", on_fallback);
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+  for (int i = 2; i < 4; i++) {
+    ASSERT_OK(Put("a", "v" + std::to_string(i)));
+    ASSERT_OK(Put("z", "v" + std::to_string(i)));
+    ASSERT_OK(Flush());
+  }
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+  ASSERT_EQ(2, factory->observed_.num_executes);
+  ASSERT_EQ(2, factory->observed_.low_threads);
+  ASSERT_EQ(0, waiting_on_fallback);
+  ASSERT_EQ(3, low_threads_on_fallback);
+  ASSERT_EQ(3, env_->GetBackgroundThreads(Env::Priority::LOW));
+
+  Close();
+  env_->SetBackgroundThreads(saved_low_threads, Env::Priority::LOW);
+}
+
+TEST_F(DBCompactionTest, CompactionCompressionThreads) {
+  Options options = CurrentOptions();
+  options.compaction_compression_threads = 4;
+  options.level0_file_num_compaction_trigger = 2;
+  BlockBasedTableOptions table_options;
+  table_options.index_type = BlockBasedTableOptions::kTwoLevelIndexSearch;
+  table_options.partition_filters = true;
+  table_options.filter_policy.reset(NewBloomFilterPolicy(10));
+  table_options.metadata_block_size = 256;
+  table_options.block_size = 1024;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  uint32_t parallel_threads = 0;
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "LevelCompactionPicker::PickCompaction:Return", [&](void* arg) {
+        auto* c = static_cast<Compaction*>(arg);
+        parallel_threads = c->output_compression_opts().parallel_threads;
+      });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  Random rnd(301);
+  constexpr int kNumKeys = 2000;
+  std::vector<std::string> values(kNumKeys);
+  for (int f = 0; f < 2; f++) {
+    for (int i = f; i < kNumKeys; i += 2) {
+      values[i] = rnd.RandomString(50) + std::string(50, 'x');
+      ASSERT_OK(Put(Key(i), values[i]));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  ASSERT_EQ(parallel_threads, 4U);
+  ASSERT_EQ("0,1", FilesPerLevel(0));
+  for (int i = 0; i < kNumKeys; i++) {
+    ASSERT_EQ(Get(Key(i)), values[i]);
+    ASSERT_EQ(Get(Key(i) + "_absent"), "NOT_FOUND");
+  }
+  std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+  int count = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ASSERT_EQ(iter->value(), values[count]);
+    count++;
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(count, kNumKeys);
+}
+
+TEST_F(DBCompactionTest, CompactionAsyncReadahead) {
+  for (bool rate_limited : {false, true}) {
+    Options options = CurrentOptions();
+    options.compaction_readahead_size = 16 << 10;
+    options.compaction_async_readahead = true;
+    options.compression = kNoCompression;
+    options.level0_file_num_compaction_trigger = 2;
+    BlockBasedTableOptions table_options;
+    table_options.block_size = 1024;
+    options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+    if (rate_limited) {
+      options.rate_limiter.reset(NewGenericRateLimiter(
+          1 << 30 /* rate_bytes_per_sec */, 100 * 1000 /* refill_period_us */,
+          10 /* fairness */, RateLimiter::Mode::kReadsOnly));
+    }
+    DestroyAndReopen(options);
+
+    std::atomic<int> async_prefetches{0};
+    ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+        "FilePrefetchBuffer::PrefetchAsyncInternal:Start",
+        [&](void*) { async_prefetches++; });
+    ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+    Random rnd(301);
+    constexpr int kNumKeys = 2000;
+    std::vector<std::string> values(kNumKeys);
+    for (int f = 0; f < 2; f++) {
+      for (int i = f; i < kNumKeys; i += 2) {
+        values[i] = rnd.RandomString(100);
+        ASSERT_OK(Put(Key(i), values[i]));
+      }
+      ASSERT_OK(Flush());
+    }
+    ASSERT_OK(dbfull()->TEST_WaitForCompact());
+    ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+    ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+
+    if (rate_limited) {
+      // ReadAsync is not charged, the reads ahead are synchronous instead
+      ASSERT_EQ(async_prefetches.load(), 0);
+      ASSERT_GT(options.rate_limiter->GetTotalBytesThrough(Env::IO_LOW),
+                200U << 10);
+    } else {
+      // Each input file is about 120KB, read ahead by 16KB
+      ASSERT_GT(async_prefetches.load(), 2);
+    }
+    ASSERT_EQ("0,1", FilesPerLevel(0));
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    int count = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ASSERT_EQ(iter->value(), values[count]);
+      count++;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(count, kNumKeys);
+  }
+}
+
 TEST_F(DBCompactionTest, L0_CompactionBug_Issue44_a) {
   do {
     CreateAndReopenWithCF({"pikachu"}, CurrentOptions());
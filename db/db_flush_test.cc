@@ -2039,6 +2039,133 @@ TEST_F(DBFlushTest, FlushWithBlob) {
 #endif  // ROCKSDB_LITE
 }
 
+TEST_F(DBFlushTest, FlushPartitions) {
+  class PartitionListener : public EventListener {
+   public:
+    void OnFlushCompleted(DB* /*db*/, const FlushJobInfo& info) override {
+      std::lock_guard<std::mutex> lock(mutex_);
+      flushed_files_.insert(info.file_number);
+      for (const auto& part : info.partition_file_infos) {
+        ASSERT_EQ(part.file_path.substr(part.file_path.rfind('/')),
+                  MakeTableFileName("", part.file_number));
+        ASSERT_GT(part.table_properties.num_entries, 0U);
+        ASSERT_LE(part.smallest_seqno, part.largest_seqno);
+        flushed_files_.insert(part.file_number);
+      }
+    }
+    std::set<uint64_t> FlushedFiles() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return flushed_files_;
+    }
+
+   private:
+    std::mutex mutex_;
+    std::set<uint64_t> flushed_files_;
+  };
+  auto listener = std::make_shared<PartitionListener>();
+
+  Options options = CurrentOptions();
+  options.max_flush_partitions = 4;
+  options.target_file_size_base = 64 << 10;
+  options.write_buffer_size = 4 << 20;
+  options.disable_auto_compactions = true;
+  options.level0_file_num_compaction_trigger = 2;
+  options.listeners.push_back(listener);
+  Reopen(options);
+  env_->SetBackgroundThreads(4, Env::Priority::HIGH);
+
+  // The partitions are built by the flush thread and by helpers scheduled
+  // in the HIGH pool. The flush thread leaves partitions to the helpers
+  // until one of them has started.
+  std::atomic<int> num_partitions{0};
+  std::atomic<int> num_on_helpers{0};
+  SyncPoint::GetInstance()->SetCallBack(
+      "FlushJob::WriteLevel0Table:Partition", [&](void* arg) {
+        num_partitions++;
+        if (*static_cast<bool*>(arg)) {
+          num_on_helpers++;
+          return;
+        }
+        for (int i = 0; i < 1000 && num_on_helpers == 0; i++) {
+          env_->SleepForMicroseconds(10000);
+        }
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  Random rnd(301);
+  constexpr int kNumKeys = 2000;
+  std::vector<std::string> values(kNumKeys);
+  for (int i = 0; i < kNumKeys; i++) {
+    values[i] = rnd.RandomString(200);
+  }
+  // Insert in random order, overwriting some of the keys
+  for (int i = 0; i < 2 * kNumKeys; i++) {
+    int k = static_cast<int>(rnd.Uniform(kNumKeys));
+    ASSERT_OK(Put(Key(k), values[k]));
+  }
+  for (int i = 0; i < kNumKeys; i++) {
+    ASSERT_OK(Put(Key(i), values[i]));
+  }
+  ASSERT_OK(Flush());
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  ASSERT_EQ(num_partitions.load(), 3);
+  ASSERT_GE(num_on_helpers.load(), 1);
+
+  VersionSet* const versions = dbfull()->GetVersionSet();
+  ColumnFamilyData* const cfd = versions->GetColumnFamilySet()->GetDefault();
+  const VersionStorageInfo* const storage_info =
+      cfd->current()->storage_info();
+  const auto& l0_files = storage_info->LevelFiles(0);
+  ASSERT_EQ(l0_files.size(), 4U);
+
+  // Disjoint key ranges of the same flush
+  std::vector<FileMetaData*> files(l0_files.begin(), l0_files.end());
+  std::sort(files.begin(), files.end(),
+            [](const FileMetaData* x, const FileMetaData* y) {
+              return x->smallest.user_key().compare(y->smallest.user_key()) <
+                     0;
+            });
+  for (size_t i = 0; i < files.size(); i++) {
+    ASSERT_EQ(files[i]->epoch_number, files[0]->epoch_number);
+    if (i > 0) {
+      ASSERT_LT(files[i - 1]->largest.user_key().compare(
+                    files[i]->smallest.user_key()),
+                0);
+    }
+  }
+  ASSERT_EQ(files.front()->smallest.user_key(), Key(0));
+  ASSERT_EQ(files.back()->largest.user_key(), Key(kNumKeys - 1));
+
+  // The listener is told about every file of the flush
+  std::set<uint64_t> expected_files;
+  for (const FileMetaData* f : files) {
+    expected_files.insert(f->fd.GetNumber());
+  }
+  ASSERT_EQ(listener->FlushedFiles(), expected_files);
+
+  // The files of one flush are a single sorted run for the L0 triggers
+  ASSERT_EQ(storage_info->l0_delay_trigger_count(), 1);
+  ASSERT_LT(storage_info->CompactionScore(0), 1);
+
+  for (int i = 0; i < kNumKeys; i++) {
+    ASSERT_EQ(Get(Key(i)), values[i]);
+  }
+
+  // Range tombstones are not partitioned
+  ASSERT_OK(Put(Key(0), values[0]));
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(),
+                             Key(0), Key(1)));
+  for (int i = 1; i < kNumKeys; i++) {
+    ASSERT_OK(Put(Key(i), values[i]));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_EQ(NumTableFilesAtLevel(0), 5);
+  ASSERT_EQ(cfd->current()->storage_info()->l0_delay_trigger_count(), 2);
+  ASSERT_EQ(Get(Key(0)), "NOT_FOUND");
+  ASSERT_EQ(Get(Key(1)), values[1]);
+}
+
 TEST_F(DBFlushTest, FlushWithChecksumHandoff1) {
   if (mem_env_ || encrypted_env_) {
     ROCKSDB_GTEST_SKIP("Test requires non-mem or non-encrypted environment");
@@ -25,6 +25,7 @@
 #include <utility>
 #include <vector>
 
+#include "cache/cache_helpers.h"
 #include "db/arena_wrapped_db_iter.h"
 #include "db/builder.h"
 #include "db/compaction/compaction_job.h"
@@ -122,6 +123,8 @@ void DumpRocksDBBuildVersion(Logger* log);
 // because FiberPool.m_channel must be destructed first
 static ROCKSDB_STATIC_TLS thread_local terark::FiberPool gt_fiber_pool(
     boost::fibers::context::active_pp());
+static void MultiGetFiberYield() { gt_fiber_pool.unchecked_yield(); }
+
 struct ToplingMGetCtx : protected MergeContext {
   MergeContext& merge_context() { return *this; }
   SequenceNumber max_covering_tombstone_seq = 0;
@@ -299,6 +302,7 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
       unscheduled_compactions_(0),
       bg_bottom_compaction_scheduled_(0),
       bg_compaction_scheduled_(0),
+      bg_remote_compaction_waiting_(0),
       num_running_compactions_(0),
       bg_flush_scheduled_(0),
       num_running_flushes_(0),
@@ -380,6 +384,7 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
                                  io_tracer_, db_id_, db_session_id_));
   column_family_memtables_.reset(
       new ColumnFamilyMemTablesImpl(versions_->GetColumnFamilySet()));
+  write_controller_.set_policy(immutable_db_options_.write_controller_policy);
 
   DumpRocksDBBuildVersion(immutable_db_options_.info_log.get());
   DumpDBFileSummary(immutable_db_options_, dbname_, db_session_id_);
@@ -1201,6 +1206,14 @@ void DBImpl::DumpStats() {
                                                  &stats);
       }
     }
+
+    std::string policy_stats;
+    if (GetPropertyHandleWriteControllerPolicyStats(&policy_stats)) {
+      stats.append("\n** Write Controller Policy ");
+      stats.append(write_controller_.policy()->Name());
+      stats.append(" **\n");
+      stats.append(policy_stats);
+    }
   }
   TEST_SYNC_POINT("DBImpl::DumpStats:2");
   ROCKS_LOG_INFO(immutable_db_options_.info_log,
@@ -3081,6 +3094,14 @@ if (UNLIKELY(!g_MultiGetUseFiber)) {
   //TEST_SYNC_POINT("DBImpl::GetImpl:PostMemTableGet:0");
   //TEST_SYNC_POINT("DBImpl::GetImpl:PostMemTableGet:1");
   size_t counting = 0;
+  // Blob indexes found in SST are not resolved per key by Version::Get, but
+  // all together after the fibers finish, see Version::MultiGetBlob
+  const bool has_blob_files =
+      !sv->current->storage_info()->GetBlobFiles().empty();
+  std::unique_ptr<bool[]> is_blob_in_sst;
+  if (has_blob_files) {
+    is_blob_in_sst.reset(new bool[num_keys]());
+  }
   auto get_in_sst = [&](size_t i, size_t/*unused*/ = 0) {
     MergeContext& merge_context = ctx_vec[i].merge_context();
     PinnedIteratorsManager pinned_iters_mgr;
@@ -3095,12 +3116,16 @@ if (UNLIKELY(!g_MultiGetUseFiber)) {
         value_found,
         nullptr, nullptr,
         callback,
-        is_blob_index,
+        has_blob_files ? &is_blob_in_sst[i] : is_blob_index,
         get_value);
     counting++;
   };
+  // While a fiber waits for a secondary cache lookup of a block, let the
+  // other fibers issue their own reads and lookups
+  std::unique_ptr<CacheWaitYieldScope> cache_wait_yield;
   if (read_options.async_io) {
     gt_fiber_pool.update_fiber_count(read_options.async_queue_depth);
+    cache_wait_yield.reset(new CacheWaitYieldScope(&MultiGetFiberYield));
   }
   size_t memtab_miss = 0;
   for (size_t i = 0; i < num_keys; i++) {
@@ -3116,6 +3141,23 @@ if (UNLIKELY(!g_MultiGetUseFiber)) {
   while (counting < memtab_miss) {
     gt_fiber_pool.unchecked_yield();
   }
+  if (has_blob_files) {
+    std::vector<Slice> blob_keys;
+    std::vector<PinnableSlice*> blob_values;
+    std::vector<Status*> blob_statuses;
+    for (size_t i = 0; i < num_keys; i++) {
+      if (is_blob_in_sst[i] && statuses[i].ok()) {
+        blob_keys.push_back(ctx_vec[i].lkey.user_key());
+        blob_values.push_back(&values[i]);
+        blob_statuses.push_back(&statuses[i]);
+      }
+    }
+    if (!blob_keys.empty()) {
+      sv->current->MultiGetBlob(read_options, blob_keys.size(),
+                                blob_keys.data(), blob_values.data(),
+                                blob_statuses.data());
+    }
+  }
 
   // Post processing (decrement reference counts and record statistics)
   RecordTick(stats_, MEMTABLE_MISS, memtab_miss);
@@ -4283,6 +4325,17 @@ bool DBImpl::GetPropertyHandleOptionsStatistics(std::string* value) {
   return true;
 }
 
+bool DBImpl::GetPropertyHandleWriteControllerPolicyStats(std::string* value) {
+  assert(value != nullptr);
+  mutex_.AssertHeld();
+  WriteControllerPolicy* policy = write_controller_.policy();
+  if (!policy) {
+    return false;
+  }
+  *value = policy->GetPrintableStats();
+  return true;
+}
+
 #ifndef ROCKSDB_LITE
 Status DBImpl::ResetStats() {
   InstrumentedMutexLock l(&mutex_);
@@ -5638,6 +5691,106 @@ Status DBImpl::GetLatestSequenceForKey(
   return s;
 }
 
+void DBImpl::GetLatestSequenceForKeys(
+    SuperVersion* sv, size_t num_keys, const Slice* keys, bool cache_only,
+    const SequenceNumber* lower_bound_seqs, SequenceNumber* seqs,
+    bool* found_record_for_keys, Status* statuses, int async_queue_depth) {
+  assert(sv->cfd->user_comparator()->timestamp_size() == 0);
+  ReadOptions read_options;
+  const SequenceNumber current_seq = versions_->LastSequence();
+  const SequenceNumber lower_bound_in_mem = sv->mem->GetEarliestSequenceNumber();
+  const SequenceNumber lower_bound_in_imm = sv->imm->GetEarliestSequenceNumber();
+  auto is_unexpected = [](const Status& s) {
+    return !(s.ok() || s.IsNotFound() || s.IsMergeInProgress());
+  };
+  std::vector<ToplingMGetCtx> ctx_vec(num_keys);
+  std::vector<size_t> sst_keys;
+
+  // Same memtable, immutable memtables, history order as
+  // GetLatestSequenceForKey, but all keys pass one table before moving on to
+  // the next, so each pass walks a single skiplist with a hot cache
+  for (size_t i = 0; i < num_keys; i++) {
+    auto& ctx = ctx_vec[i];
+    ctx.InitLookupKey(keys[i], current_seq, nullptr);
+    seqs[i] = kMaxSequenceNumber;
+    found_record_for_keys[i] = false;
+    statuses[i] = Status::OK();
+    sv->mem->Get(ctx.lkey, /*value=*/nullptr, /*columns=*/nullptr,
+                 /*timestamp=*/nullptr, &statuses[i], &ctx.merge_context(),
+                 &ctx.max_covering_tombstone_seq, &seqs[i], read_options,
+                 false /* immutable_memtable */, nullptr /*read_callback*/);
+    if (is_unexpected(statuses[i]) || seqs[i] != kMaxSequenceNumber) {
+      found_record_for_keys[i] = seqs[i] != kMaxSequenceNumber;
+      ctx.set_done();
+    } else if (lower_bound_in_mem != kMaxSequenceNumber &&
+               lower_bound_in_mem < lower_bound_seqs[i]) {
+      ctx.set_done();
+    }
+  }
+  for (size_t i = 0; i < num_keys; i++) {
+    auto& ctx = ctx_vec[i];
+    if (ctx.is_done()) continue;
+    sv->imm->Get(ctx.lkey, /*value=*/nullptr, /*columns=*/nullptr,
+                 /*timestamp=*/nullptr, &statuses[i], &ctx.merge_context(),
+                 &ctx.max_covering_tombstone_seq, &seqs[i], read_options);
+    if (is_unexpected(statuses[i]) || seqs[i] != kMaxSequenceNumber) {
+      found_record_for_keys[i] = seqs[i] != kMaxSequenceNumber;
+      ctx.set_done();
+    } else if (lower_bound_in_imm != kMaxSequenceNumber &&
+               lower_bound_in_imm < lower_bound_seqs[i]) {
+      ctx.set_done();
+    }
+  }
+  for (size_t i = 0; i < num_keys; i++) {
+    auto& ctx = ctx_vec[i];
+    if (ctx.is_done()) continue;
+    sv->imm->GetFromHistory(ctx.lkey, /*value=*/nullptr, /*columns=*/nullptr,
+                            /*timestamp=*/nullptr, &statuses[i],
+                            &ctx.merge_context(),
+                            &ctx.max_covering_tombstone_seq, &seqs[i],
+                            read_options);
+    if (is_unexpected(statuses[i]) || seqs[i] != kMaxSequenceNumber) {
+      found_record_for_keys[i] = seqs[i] != kMaxSequenceNumber;
+    } else if (!cache_only) {
+      sst_keys.push_back(i);
+    }
+  }
+  if (sst_keys.empty()) {
+    return;
+  }
+  size_t counting = 0;
+  auto get_in_sst = [&](size_t i, size_t/*unused*/ = 0) {
+    auto& ctx = ctx_vec[i];
+    PinnedIteratorsManager pinned_iters_mgr;
+    sv->current->Get(read_options, ctx.lkey, /*value=*/nullptr,
+                     /*columns=*/nullptr, /*timestamp=*/nullptr, &statuses[i],
+                     &ctx.merge_context(), &ctx.max_covering_tombstone_seq,
+                     &pinned_iters_mgr, nullptr /* value_found */,
+                     &found_record_for_keys[i], &seqs[i],
+                     nullptr /*read_callback*/);
+    if (is_unexpected(statuses[i])) {
+      ROCKS_LOG_ERROR(immutable_db_options_.info_log,
+                      "Unexpected status returned from Version::Get: %s\n",
+                      statuses[i].ToString().c_str());
+    }
+    counting++;
+  };
+  if (async_queue_depth > 1 && sst_keys.size() > 1 && g_MultiGetUseFiber) {
+    gt_fiber_pool.update_fiber_count(async_queue_depth);
+    CacheWaitYieldScope cache_wait_yield(&MultiGetFiberYield);
+    for (size_t i : sst_keys) {
+      gt_fiber_pool.push({TERARK_C_CALLBACK(get_in_sst), i});
+    }
+    while (counting < sst_keys.size()) {
+      gt_fiber_pool.unchecked_yield();
+    }
+  } else {
+    for (size_t i : sst_keys) {
+      get_in_sst(i);
+    }
+  }
+}
+
 Status DBImpl::IngestExternalFile(
     ColumnFamilyHandle* column_family,
     const std::vector<std::string>& external_files,
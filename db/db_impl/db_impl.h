@@ -716,6 +716,18 @@ class DBImpl : public DB {
                                  bool* found_record_for_key,
                                  bool* is_blob_index);
 
+  // Batched GetLatestSequenceForKey() for column families without user
+  // defined timestamp. Keys should be sorted by the user comparator so the
+  // memtable probes walk the skiplists in order. Keys which are not resolved
+  // by the memtables are looked up in the SST files (unless cache_only), on
+  // fibers when async_queue_depth > 1, like MultiGet does.
+  void GetLatestSequenceForKeys(SuperVersion* sv, size_t num_keys,
+                                const Slice* keys, bool cache_only,
+                                const SequenceNumber* lower_bound_seqs,
+                                SequenceNumber* seqs,
+                                bool* found_record_for_keys, Status* statuses,
+                                int async_queue_depth = 0);
+
   Status TraceIteratorSeek(const uint32_t& cf_id, const Slice& key,
                            const Slice& lower_bound, const Slice upper_bound);
   Status TraceIteratorSeekForPrev(const uint32_t& cf_id, const Slice& key,
@@ -1164,6 +1176,7 @@ class DBImpl : public DB {
 
   int TEST_BGCompactionsAllowed() const;
   int TEST_BGFlushesAllowed() const;
+  int TEST_BGRemoteCompactionsWaiting() const;
   size_t TEST_GetWalPreallocateBlockSize(uint64_t write_buffer_size) const;
   void TEST_WaitForPeriodicTaskRun(std::function<void()> callback) const;
   SeqnoToTimeMapping TEST_GetSeqnoToTimeMapping() const;
@@ -1705,6 +1718,8 @@ class DBImpl : public DB {
     DBImpl* db_;
 
     Env::Priority thread_pri_;
+    // When the flush was scheduled, for FLUSH_QUEUE_WAIT_MICROS
+    uint64_t schedule_micros_ = 0;
   };
 
   // Information for a manual compaction
@@ -1763,6 +1778,8 @@ class DBImpl : public DB {
     // background compaction takes ownership of `prepicked_compaction`.
     PrepickedCompaction* prepicked_compaction;
     Env::Priority compaction_pri_;
+    // When the compaction was scheduled, for COMPACTION_QUEUE_WAIT_MICROS
+    uint64_t schedule_micros_ = 0;
   };
 
   // Initialize the built-in column family for persistent stats. Depending on
@@ -2119,6 +2136,15 @@ class DBImpl : public DB {
   ColumnFamilyData* PickCompactionFromQueue(
       std::unique_ptr<TaskLimiterToken>* token, LogBuffer* log_buffer);
 
+  // Stop counting a compaction waiting for a remote worker in
+  // max_background_compactions, see
+  // DBOptions::max_background_remote_compactions. Return false if the limit
+  // of such compactions is reached.
+  // The LOW pool gets a thread for each such compaction of thread_pri LOW,
+  // counted per Env, which is given back when the wait ends.
+  bool BeginRemoteCompactionWait(Env::Priority thread_pri);
+  void EndRemoteCompactionWait(Env::Priority thread_pri);
+
   // helper function to call after some of the logs_ were synced
   void MarkLogsSynced(uint64_t up_to, bool synced_dir, VersionEdit* edit);
   Status ApplyWALToManifest(VersionEdit* edit);
@@ -2170,6 +2196,7 @@ private:
                               const DBPropertyInfo& property_info,
                               bool is_locked, uint64_t* value);
   bool GetPropertyHandleOptionsStatistics(std::string* value);
+  bool GetPropertyHandleWriteControllerPolicyStats(std::string* value);
 
   bool HasPendingManualCompaction();
   bool HasExclusiveManualCompaction();
@@ -2503,6 +2530,11 @@ private:
   // count how many background compactions are running or have been scheduled
   int bg_compaction_scheduled_;
 
+  // the part of bg_compaction_scheduled_ and bg_bottom_compaction_scheduled_
+  // which waits for a remote worker and is not counted in
+  // max_background_compactions
+  int bg_remote_compaction_waiting_;
+
   // stores the number of compactions are currently running
   int num_running_compactions_;
 
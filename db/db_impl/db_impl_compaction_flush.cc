@@ -8,6 +8,8 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 #include <cinttypes>
 #include <deque>
+#include <mutex>
+#include <unordered_map>
 
 #include "db/builder.h"
 #include "db/db_impl/db_impl.h"
@@ -25,6 +27,38 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+namespace {
+// How close the compaction debt of cfd is to a write stall, 1 at the
+// slowdown triggers. REQUIRES: db mutex held
+double CompactionStallUrgency(ColumnFamilyData* cfd) {
+  const VersionStorageInfo* vstorage = cfd->current()->storage_info();
+  const MutableCFOptions* mopts = cfd->GetLatestMutableCFOptions();
+  double urgency = 0;
+  if (mopts->level0_slowdown_writes_trigger > 0) {
+    urgency = static_cast<double>(vstorage->l0_delay_trigger_count()) /
+              mopts->level0_slowdown_writes_trigger;
+  }
+  if (mopts->soft_pending_compaction_bytes_limit > 0) {
+    urgency = std::max(
+        urgency,
+        static_cast<double>(vstorage->estimated_compaction_needed_bytes()) /
+            mopts->soft_pending_compaction_bytes_limit);
+  }
+  return urgency;
+}
+
+// How close the immutable memtables of cfd are to a write stall, 1 at
+// max_write_buffer_number. REQUIRES: db mutex held
+double FlushStallUrgency(ColumnFamilyData* cfd) {
+  const MutableCFOptions* mopts = cfd->GetLatestMutableCFOptions();
+  if (mopts->max_write_buffer_number <= 0) {
+    return 0;
+  }
+  return static_cast<double>(cfd->imm()->NumNotFlushed()) /
+         mopts->max_write_buffer_number;
+}
+}  // namespace
+
 bool DBImpl::EnoughRoomForCompaction(
     ColumnFamilyData* cfd, const std::vector<CompactionInputFiles>& inputs,
     bool* sfm_reserved_compact_space, LogBuffer* log_buffer) {
@@ -356,6 +390,11 @@ Status DBImpl::FlushMemTableToOutputFile(
       // exists. Otherwise, some tests may fail.  Ignore the error in the
       // interim.
       sfm->OnAddFile(file_path).PermitUncheckedError();
+      for (const auto& f : flush_job.GetPartitionFileMetaData()) {
+        sfm->OnAddFile(MakeTableFileName(cfd->ioptions()->cf_paths[0].path,
+                                         f.fd.GetNumber()))
+            .PermitUncheckedError();
+      }
       if (sfm->IsMaxAllowedSpaceReached()) {
         Status new_bg_error =
             Status::SpaceLimit("Max allowed space was reached");
@@ -770,6 +809,12 @@ Status DBImpl::AtomicFlushMemTablesToOutputFiles(
         // exists. Otherwise, some tests may fail.  Ignore the error in the
         // interim.
         sfm->OnAddFile(file_path).PermitUncheckedError();
+        for (const auto& f : jobs[i]->GetPartitionFileMetaData()) {
+          sfm->OnAddFile(MakeTableFileName(
+                             cfds[i]->ioptions()->cf_paths[0].path,
+                             f.fd.GetNumber()))
+              .PermitUncheckedError();
+        }
         if (sfm->IsMaxAllowedSpaceReached() &&
             error_handler_.GetBGError().ok()) {
           Status new_bg_error =
@@ -2008,6 +2053,7 @@ Status DBImpl::RunManualCompaction(
       }
       ca = new CompactionArg;
       ca->db = this;
+      ca->schedule_micros_ = immutable_db_options_.clock->NowMicros();
       ca->prepicked_compaction = new PrepickedCompaction;
       ca->prepicked_compaction->manual_compaction_state = &manual;
       ca->prepicked_compaction->compaction = compaction;
@@ -2549,6 +2595,7 @@ void DBImpl::MaybeScheduleFlushOrCompaction() {
     FlushThreadArg* fta = new FlushThreadArg;
     fta->db_ = this;
     fta->thread_pri_ = Env::Priority::HIGH;
+    fta->schedule_micros_ = immutable_db_options_.clock->NowMicros();
     env_->Schedule(&DBImpl::BGWorkFlush, fta, Env::Priority::HIGH, this,
                    &DBImpl::UnscheduleFlushCallback);
     --unscheduled_flushes_;
@@ -2567,6 +2614,7 @@ void DBImpl::MaybeScheduleFlushOrCompaction() {
       FlushThreadArg* fta = new FlushThreadArg;
       fta->db_ = this;
       fta->thread_pri_ = Env::Priority::LOW;
+      fta->schedule_micros_ = immutable_db_options_.clock->NowMicros();
       env_->Schedule(&DBImpl::BGWorkFlush, fta, Env::Priority::LOW, this,
                      &DBImpl::UnscheduleFlushCallback);
       --unscheduled_flushes_;
@@ -2591,13 +2639,15 @@ void DBImpl::MaybeScheduleFlushOrCompaction() {
     return;
   }
 
-  while (bg_compaction_scheduled_ + bg_bottom_compaction_scheduled_ <
+  while (bg_compaction_scheduled_ + bg_bottom_compaction_scheduled_ -
+                 bg_remote_compaction_waiting_ <
              bg_job_limits.max_compactions &&
          unscheduled_compactions_ > 0) {
     CompactionArg* ca = new CompactionArg;
     ca->db = this;
     ca->compaction_pri_ = Env::Priority::LOW;
     ca->prepicked_compaction = nullptr;
+    ca->schedule_micros_ = immutable_db_options_.clock->NowMicros();
     bg_compaction_scheduled_++;
     unscheduled_compactions_--;
     env_->Schedule(&DBImpl::BGWorkCompaction, ca, Env::Priority::LOW, this,
@@ -2661,6 +2711,17 @@ ColumnFamilyData* DBImpl::PopFirstFromCompactionQueue() {
 
 DBImpl::FlushRequest DBImpl::PopFirstFromFlushQueue() {
   assert(!flush_queue_.empty());
+  if (mutable_db_options_.stall_aware_scheduling &&
+      !immutable_db_options_.atomic_flush && flush_queue_.size() > 1) {
+    // Move the column family closest to a write stall to the front, ties in
+    // the order of the queue
+    auto most_urgent = std::max_element(
+        flush_queue_.begin(), flush_queue_.end(),
+        [](const FlushRequest& x, const FlushRequest& y) {
+          return FlushStallUrgency(x[0].first) < FlushStallUrgency(y[0].first);
+        });
+    std::rotate(flush_queue_.begin(), most_urgent, most_urgent + 1);
+  }
   FlushRequest flush_req = flush_queue_.front();
   flush_queue_.pop_front();
   if (!immutable_db_options_.atomic_flush) {
@@ -2682,6 +2743,24 @@ ColumnFamilyData* DBImpl::PickCompactionFromQueue(
     std::unique_ptr<TaskLimiterToken>* token, LogBuffer* log_buffer) {
   assert(!compaction_queue_.empty());
   assert(*token == nullptr);
+  if (mutable_db_options_.stall_aware_scheduling &&
+      compaction_queue_.size() > 1) {
+    // Serve the column family closest to a write stall first, ties in the
+    // order of the queue
+    std::vector<std::pair<double, ColumnFamilyData*>> ranked;
+    ranked.reserve(compaction_queue_.size());
+    for (ColumnFamilyData* queued : compaction_queue_) {
+      ranked.emplace_back(CompactionStallUrgency(queued), queued);
+    }
+    std::stable_sort(ranked.begin(), ranked.end(),
+                     [](const std::pair<double, ColumnFamilyData*>& x,
+                        const std::pair<double, ColumnFamilyData*>& y) {
+                       return x.first > y.first;
+                     });
+    for (size_t i = 0; i < ranked.size(); i++) {
+      compaction_queue_[i] = ranked[i].second;
+    }
+  }
   autovector<ColumnFamilyData*> throttled_candidates;
   ColumnFamilyData* cfd = nullptr;
   while (!compaction_queue_.empty()) {
@@ -2704,6 +2783,80 @@ ColumnFamilyData* DBImpl::PickCompactionFromQueue(
   return cfd;
 }
 
+namespace {
+// The LOW pool of an Env is shared by all DBs on it, so the threads added
+// for remote compaction waits are counted per Env. floor is the pool size
+// without them. A size set by anyone else meanwhile becomes the new floor,
+// the pool is never shrunk below it.
+struct RemoteWaitThreads {
+  int num_waiting = 0;
+  int floor = 0;
+  int expected = 0;  // pool size after the last change made here
+};
+std::mutex& RemoteWaitThreadsMutex() {
+  static std::mutex* mutex = new std::mutex();
+  return *mutex;
+}
+std::unordered_map<Env*, RemoteWaitThreads>& RemoteWaitThreadsMap() {
+  static auto* map = new std::unordered_map<Env*, RemoteWaitThreads>();
+  return *map;
+}
+}  // namespace
+
+bool DBImpl::BeginRemoteCompactionWait(Env::Priority thread_pri) {
+  mutex_.AssertHeld();
+  if (bg_remote_compaction_waiting_ >=
+      mutable_db_options_.max_background_remote_compactions) {
+    return false;
+  }
+  bg_remote_compaction_waiting_++;
+  if (thread_pri == Env::Priority::LOW) {
+    // This thread only waits, add one to run the local compactions
+    std::lock_guard<std::mutex> lock(RemoteWaitThreadsMutex());
+    RemoteWaitThreads& t = RemoteWaitThreadsMap()[env_];
+    const int num_threads = env_->GetBackgroundThreads(Env::Priority::LOW);
+    if (t.num_waiting == 0 || num_threads != t.expected) {
+      t.floor = num_threads;
+    }
+    t.num_waiting++;
+    env_->IncBackgroundThreadsIfNeeded(
+        std::max(t.floor + t.num_waiting,
+                 GetBGJobLimits().max_compactions +
+                     bg_remote_compaction_waiting_),
+        Env::Priority::LOW);
+    t.expected = env_->GetBackgroundThreads(Env::Priority::LOW);
+  }
+  MaybeScheduleFlushOrCompaction();
+  return true;
+}
+
+void DBImpl::EndRemoteCompactionWait(Env::Priority thread_pri) {
+  mutex_.AssertHeld();
+  assert(bg_remote_compaction_waiting_ > 0);
+  bg_remote_compaction_waiting_--;
+  if (thread_pri == Env::Priority::LOW) {
+    // Give back the thread added for this wait, if no one resized the pool
+    std::lock_guard<std::mutex> lock(RemoteWaitThreadsMutex());
+    auto& map = RemoteWaitThreadsMap();
+    auto iter = map.find(env_);
+    assert(iter != map.end());
+    RemoteWaitThreads& t = iter->second;
+    assert(t.num_waiting > 0);
+    t.num_waiting--;
+    const int num_threads = env_->GetBackgroundThreads(Env::Priority::LOW);
+    if (num_threads != t.expected) {
+      t.floor = num_threads;
+    }
+    if (num_threads > t.floor + t.num_waiting) {
+      env_->SetBackgroundThreads(t.floor + t.num_waiting, Env::Priority::LOW);
+    }
+    t.expected = env_->GetBackgroundThreads(Env::Priority::LOW);
+    if (t.num_waiting == 0) {
+      map.erase(iter);
+    }
+  }
+}
+
 void DBImpl::SchedulePendingFlush(const FlushRequest& flush_req,
                                   FlushReason flush_reason) {
   mutex_.AssertHeld();
@@ -2756,6 +2909,12 @@ void DBImpl::BGWorkFlush(void* arg) {
 
   IOSTATS_SET_THREAD_POOL_ID(fta.thread_pri_);
   TEST_SYNC_POINT("DBImpl::BGWorkFlush");
+  if (fta.schedule_micros_) {
+    RecordInHistogram(
+        fta.db_->stats_, FLUSH_QUEUE_WAIT_MICROS,
+        fta.db_->immutable_db_options_.clock->NowMicros() -
+            fta.schedule_micros_);
+  }
   static_cast_with_check<DBImpl>(fta.db_)->BackgroundCallFlush(fta.thread_pri_);
   TEST_SYNC_POINT("DBImpl::BGWorkFlush:done");
 }
@@ -2765,6 +2924,11 @@ void DBImpl::BGWorkCompaction(void* arg) {
   delete reinterpret_cast<CompactionArg*>(arg);
   IOSTATS_SET_THREAD_POOL_ID(Env::Priority::LOW);
   TEST_SYNC_POINT("DBImpl::BGWorkCompaction");
+  if (ca.schedule_micros_) {
+    RecordInHistogram(
+        ca.db->stats_, COMPACTION_QUEUE_WAIT_MICROS,
+        ca.db->immutable_db_options_.clock->NowMicros() - ca.schedule_micros_);
+  }
   auto prepicked_compaction =
       static_cast<PrepickedCompaction*>(ca.prepicked_compaction);
   static_cast_with_check<DBImpl>(ca.db)->BackgroundCallCompaction(
@@ -2777,6 +2941,11 @@ void DBImpl::BGWorkBottomCompaction(void* arg) {
   delete static_cast<CompactionArg*>(arg);
   IOSTATS_SET_THREAD_POOL_ID(Env::Priority::BOTTOM);
   TEST_SYNC_POINT("DBImpl::BGWorkBottomCompaction");
+  if (ca.schedule_micros_) {
+    RecordInHistogram(
+        ca.db->stats_, BOTTOM_COMPACTION_QUEUE_WAIT_MICROS,
+        ca.db->immutable_db_options_.clock->NowMicros() - ca.schedule_micros_);
+  }
   auto* prepicked_compaction = ca.prepicked_compaction;
   assert(prepicked_compaction && prepicked_compaction->compaction);
   ca.db->BackgroundCallCompaction(prepicked_compaction, Env::Priority::BOTTOM);
@@ -3468,6 +3637,7 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
     ca->prepicked_compaction->manual_compaction_state = nullptr;
     // Transfer requested token, so it doesn't need to do it again.
     ca->prepicked_compaction->task_token = std::move(task_token);
+    ca->schedule_micros_ = immutable_db_options_.clock->NowMicros();
     ++bg_bottom_compaction_scheduled_;
     env_->Schedule(&DBImpl::BGWorkBottomCompaction, ca, Env::Priority::BOTTOM,
                    this, &DBImpl::UnscheduleCompactionCallback);
@@ -3502,6 +3672,14 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
         c->trim_ts(), &blob_callback_, &bg_compaction_scheduled_,
         &bg_bottom_compaction_scheduled_);
     compaction_job.Prepare();
+    if (compaction_job.WillRunRemote() &&
+        BeginRemoteCompactionWait(thread_pri)) {
+      // The wait ends before a failed remote run falls back to local
+      compaction_job.SetRemoteDoneCallback([this, thread_pri]() {
+        InstrumentedMutexLock l(&mutex_);
+        EndRemoteCompactionWait(thread_pri);
+      });
+    }
 
     NotifyOnCompactionBegin(c->column_family_data(), c.get(), status,
                             compaction_job_stats, job_context->job_id);
@@ -275,6 +275,11 @@ int DBImpl::TEST_BGFlushesAllowed() const {
   return GetBGJobLimits().max_flushes;
 }
 
+int DBImpl::TEST_BGRemoteCompactionsWaiting() const {
+  InstrumentedMutexLock l(&mutex_);
+  return bg_remote_compaction_waiting_;
+}
+
 SequenceNumber DBImpl::TEST_GetLastVisibleSequence() const {
   if (last_seq_same_as_publish_seq_) {
     return versions_->LastSequence();
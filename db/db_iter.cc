@@ -13,6 +13,7 @@
 #include <limits>
 #include <string>
 
+#include "db/blob/blob_index.h"
 #include "db/dbformat.h"
 #include "db/merge_context.h"
 #include "db/merge_helper.h"
@@ -78,6 +79,8 @@ DBIter::DBIter(Env* _env, const ReadOptions& read_options,
       read_tier_(read_options.read_tier),
       fill_cache_(read_options.fill_cache),
       verify_checksums_(read_options.verify_checksums),
+      async_io_(read_options.async_io),
+      blob_readahead_size_(read_options.blob_readahead_size),
       expose_blob_index_(expose_blob_index),
       is_blob_(false),
       arena_mode_(arena_mode),
@@ -216,11 +219,32 @@ bool DBIter::SetBlobValueIfNeeded(const Slice& user_key,
   read_options.fill_cache = fill_cache_;
   read_options.verify_checksums = verify_checksums_;
 
-  constexpr FilePrefetchBuffer* prefetch_buffer = nullptr;
   constexpr uint64_t* bytes_read = nullptr;
-
-  const Status s = version_->GetBlob(read_options, user_key, blob_index,
-                                     prefetch_buffer, &blob_value_, bytes_read);
+  Status s;
+
+  if (blob_readahead_size_) {
+    BlobIndex blob_idx;
+    s = blob_idx.DecodeFrom(blob_index);
+    if (s.ok()) {
+      FilePrefetchBuffer* prefetch_buffer = nullptr;
+      if (!blob_idx.HasTTL() && !blob_idx.IsInlined()) {
+        if (!blob_prefetcher_) {
+          blob_prefetcher_.reset(new BlobScanPrefetcher(
+              blob_readahead_size_, env_->GetFileSystem().get(), clock_,
+              statistics_));
+        }
+        prefetch_buffer = blob_prefetcher_->GetPrefetchBuffer(
+            blob_idx.file_number(), blob_idx.offset(), blob_idx.size());
+        read_options.async_io = async_io_;
+      }
+      s = version_->GetBlob(read_options, user_key, blob_idx, prefetch_buffer,
+                            &blob_value_, bytes_read);
+    }
+  } else {
+    constexpr FilePrefetchBuffer* prefetch_buffer = nullptr;
+    s = version_->GetBlob(read_options, user_key, blob_index, prefetch_buffer,
+                          &blob_value_, bytes_read);
+  }
 
   if (!s.ok()) {
     status_ = s;
@@ -11,6 +11,7 @@
 #include <cstdint>
 #include <string>
 
+#include "db/blob/prefetch_buffer_collection.h"
 #include "db/db_impl/db_impl.h"
 #include "db/range_del_aggregator.h"
 #include "memory/arena.h"
@@ -423,6 +424,11 @@ class DBIter final : public Iterator {
   ReadTier read_tier_;
   bool fill_cache_;
   bool verify_checksums_;
+  bool async_io_;
+  // ReadOptions::blob_readahead_size, blob_prefetcher_ is created on the
+  // first blob read
+  size_t blob_readahead_size_;
+  std::unique_ptr<BlobScanPrefetcher> blob_prefetcher_;
   // Whether the iterator is allowed to expose blob references. Set to true when
   // the stacked BlobDB implementation is used, false otherwise.
   bool expose_blob_index_;
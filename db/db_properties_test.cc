@@ -1821,6 +1821,22 @@ TEST_F(DBPropertiesTest, MinObsoleteSstNumberToKeep) {
   ASSERT_TRUE(listener->Validated());
 }
 
+TEST_F(DBPropertiesTest, WriteControllerPolicyStats) {
+  Options options = CurrentOptions();
+  Reopen(options);
+  std::string prop;
+  ASSERT_FALSE(
+      db_->GetProperty(DB::Properties::kWriteControllerPolicyStats, &prop));
+
+  options.write_controller_policy =
+      NewCompactionThroughputWriteControllerPolicy();
+  Reopen(options);
+  ASSERT_TRUE(
+      db_->GetProperty(DB::Properties::kWriteControllerPolicyStats, &prop));
+  ASSERT_NE(prop.find("updates: 0 "), std::string::npos);
+  ASSERT_NE(prop.find("compaction MB/s: "), std::string::npos);
+}
+
 TEST_F(DBPropertiesTest, BlobCacheProperties) {
   Options options;
   uint64_t value;
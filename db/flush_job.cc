@@ -11,9 +11,12 @@
 
 #include <algorithm>
 #include <cinttypes>
+#include <functional>
+#include <memory>
 #include <vector>
 
 #include "db/builder.h"
+#include "db/compaction/clipping_iterator.h"
 #include "db/db_iter.h"
 #include "db/dbformat.h"
 #include "db/event_helpers.h"
@@ -811,6 +814,133 @@ bool FlushJob::MemPurgeDecider(double threshold) {
           threshold);
 }
 
+std::vector<std::string> FlushJob::GenPartitionBounds(
+    uint64_t total_data_size) const {
+  std::vector<std::string> bounds;
+  const uint64_t target_file_size =
+      std::max<uint64_t>(mutable_cf_options_.target_file_size_base, 1);
+  const uint64_t num_partitions =
+      std::min<uint64_t>(db_options_.max_flush_partitions,
+                         total_data_size / target_file_size);
+  const Comparator* ucmp = cfd_->user_comparator();
+  if (num_partitions <= 1 || ucmp->timestamp_size() != 0) {
+    return bounds;
+  }
+  uint64_t total_num_entries = 0;
+  for (MemTable* m : mems_) {
+    if (!m->SupportUniqueRandomSample()) {
+      return bounds;
+    }
+    total_num_entries += m->num_entries();
+  }
+  // Enough samples for each range to get within a few percent of the
+  // average size
+  const uint64_t kSamplesPerPartition = 128;
+  const uint64_t num_samples = kSamplesPerPartition * num_partitions;
+  std::vector<Slice> keys;
+  std::unordered_set<const char*> sentries;
+  for (MemTable* m : mems_) {
+    const uint64_t nentries = m->num_entries();
+    if (nentries == 0) {
+      continue;
+    }
+    // Sample each memtable in proportion to its number of entries
+    const uint64_t target_sample_size = std::max<uint64_t>(
+        num_samples * nentries / std::max<uint64_t>(total_num_entries, 1), 1);
+    m->UniqueRandomSample(target_sample_size, &sentries);
+    for (const char* entry : sentries) {
+      keys.push_back(ExtractUserKey(GetLengthPrefixedSlice(entry)));
+    }
+  }
+  std::sort(keys.begin(), keys.end(), [ucmp](const Slice& x, const Slice& y) {
+    return ucmp->Compare(x, y) < 0;
+  });
+  keys.erase(std::unique(keys.begin(), keys.end(),
+                         [ucmp](const Slice& x, const Slice& y) {
+                           return ucmp->Equal(x, y);
+                         }),
+             keys.end());
+  if (keys.size() < num_partitions * 2) {
+    return bounds;
+  }
+  // All versions of a user key are in the same range, the bound is before
+  // the newest version of its user key
+  for (uint64_t i = 1; i < num_partitions; i++) {
+    const Slice& user_key = keys[i * keys.size() / num_partitions];
+    InternalKey bound(user_key, kMaxSequenceNumber, kValueTypeForSeek);
+    bounds.push_back(bound.Encode().ToString());
+  }
+  return bounds;
+}
+
+namespace {
+// The partitions of a flush are claimed one by one by the flush thread and
+// by helpers scheduled in its thread pool. The flush thread waits only for
+// the partitions helpers have claimed, so a helper which is still queued
+// when the flush ends finds nothing left and returns.
+struct FlushPartitionWork {
+  FlushPartitionWork(size_t _num, std::function<void(size_t)>&& _build)
+      : num(_num), build(std::move(_build)), cv(&mu) {}
+
+  void Run(bool on_helper) {
+    for (;;) {
+      size_t i;
+      {
+        MutexLock lock(&mu);
+        if (next >= num) {
+          return;
+        }
+        i = next++;
+        if (on_helper) {
+          num_running++;
+        }
+      }
+      TEST_SYNC_POINT_CALLBACK("FlushJob::WriteLevel0Table:Partition",
+                               &on_helper);
+      if (on_helper) {
+        // IOSTATS are per thread, the flush thread records its own
+        const uint64_t prev_bytes_written = IOSTATS(bytes_written);
+        build(i);
+        RecordTick(stats, FLUSH_WRITE_BYTES,
+                   IOSTATS(bytes_written) - prev_bytes_written);
+        MutexLock lock(&mu);
+        if (--num_running == 0) {
+          cv.SignalAll();
+        }
+      } else {
+        build(i);
+      }
+    }
+  }
+
+  void WaitForHelpers() {
+    MutexLock lock(&mu);
+    assert(next >= num);
+    while (num_running > 0) {
+      cv.Wait();
+    }
+  }
+
+  static void BGWork(void* arg) {
+    std::unique_ptr<std::shared_ptr<FlushPartitionWork>> work(
+        static_cast<std::shared_ptr<FlushPartitionWork>*>(arg));
+    (*work)->Run(true /* on_helper */);
+  }
+
+  static void UnscheduleWork(void* arg) {
+    delete static_cast<std::shared_ptr<FlushPartitionWork>*>(arg);
+  }
+
+  const size_t num;
+  const std::function<void(size_t)> build;
+  Statistics* stats = nullptr;
+  port::Mutex mu;
+  port::CondVar cv;
+  size_t next = 0;
+  size_t num_running = 0;
+};
+}  // namespace
+
 Status FlushJob::WriteLevel0Table() {
   AutoThreadOperationStageUpdater stage_updater(
       ThreadStatus::STAGE_FLUSH_WRITE_L0);
@@ -880,10 +1010,33 @@ Status FlushJob::WriteLevel0Table() {
                          << total_memory_usage << "flush_reason"
                          << GetFlushReasonString(cfd_->GetFlushReason());
 
+    // The memtables are split at partition_bounds into key ranges, each
+    // flushed to its own L0 file, concurrently by the helpers of
+    // FlushPartitionWork
+    std::vector<std::string> partition_bounds;
+    if (range_del_iters.empty() && db_options_.max_flush_partitions > 1) {
+      partition_bounds = GenPartitionBounds(total_data_size);
+    }
+    const std::vector<Slice> bound_slices(partition_bounds.begin(),
+                                          partition_bounds.end());
+    if (!partition_bounds.empty()) {
+      ROCKS_LOG_INFO(db_options_.info_log,
+                     "[%s] [JOB %d] Level-0 flush split into %zu partitions",
+                     cfd_->GetName().c_str(), job_context_->job_id,
+                     partition_bounds.size() + 1);
+    }
+
     {
       ScopedArenaIterator iter(
           NewMergingIterator(&cfd_->internal_comparator(), memtables.data(),
                              static_cast<int>(memtables.size()), &arena));
+      std::unique_ptr<InternalIterator> clip;
+      InternalIterator* input = iter.get();
+      if (!bound_slices.empty()) {
+        clip.reset(new ClippingIterator(iter.get(), nullptr, &bound_slices[0],
+                                        &cfd_->internal_comparator()));
+        input = clip.get();
+      }
       ROCKS_LOG_INFO(db_options_.info_log,
                      "[%s] [JOB %d] Level-0 flush table #%" PRIu64 ": started",
                      cfd_->GetName().c_str(), job_context_->job_id,
@@ -932,9 +1085,86 @@ Status FlushJob::WriteLevel0Table() {
           meta_.fd.GetNumber());
       const SequenceNumber job_snapshot_seq =
           job_context_->GetJobSnapshotSequence();
+
+      struct Partition {
+        FileMetaData meta;
+        std::vector<BlobFileAddition> blob_file_additions;
+        Status status;
+        uint64_t num_input_entries = 0;
+        uint64_t memtable_payload_bytes = 0;
+        uint64_t memtable_garbage_bytes = 0;
+        TableProperties table_properties;
+      };
+      std::vector<Partition> partitions(bound_slices.size());
+      for (Partition& p : partitions) {
+        p.meta.fd = FileDescriptor(versions_->NewFileNumber(), 0, 0);
+        p.meta.epoch_number = meta_.epoch_number;
+        p.meta.oldest_ancester_time = oldest_ancester_time;
+        p.meta.file_creation_time = current_time;
+      }
+      auto build_partition = [&](size_t i) {
+        Partition* p = &partitions[i];
+        const Slice* start = &bound_slices[i];
+        const Slice* end =
+            i + 1 < bound_slices.size() ? &bound_slices[i + 1] : nullptr;
+        Arena part_arena;
+        std::vector<InternalIterator*> part_memtables;
+        for (MemTable* m : mems_) {
+          part_memtables.push_back(m->NewIterator(ro, &part_arena));
+        }
+        ScopedArenaIterator part_iter(NewMergingIterator(
+            &cfd_->internal_comparator(), part_memtables.data(),
+            static_cast<int>(part_memtables.size()), &part_arena));
+        ClippingIterator part_input(part_iter.get(), start, end,
+                                    &cfd_->internal_comparator());
+        TableBuilderOptions part_tboptions(
+            *cfd_->ioptions(), mutable_cf_options_,
+            cfd_->internal_comparator(),
+            cfd_->int_tbl_prop_collector_factories(), output_compression_,
+            mutable_cf_options_.compression_opts, cfd_->GetID(),
+            cfd_->GetName(), 0 /* level */, false /* is_bottommost */,
+            TableFileCreationReason::kFlush, oldest_key_time, current_time,
+            db_id_, db_session_id_, 0 /* target_file_size */,
+            p->meta.fd.GetNumber());
+        IOStatus part_io_s;
+        p->status = BuildTable(
+            dbname_, versions_, db_options_, part_tboptions, file_options_,
+            cfd_->table_cache(), &part_input, {} /* range_del_iters */,
+            &p->meta, &p->blob_file_additions, existing_snapshots_,
+            earliest_write_conflict_snapshot_, job_snapshot_seq,
+            snapshot_checker_, mutable_cf_options_.paranoid_file_checks,
+            cfd_->internal_stats(), &part_io_s, io_tracer_,
+            BlobFileCreationReason::kFlush, seqno_to_time_mapping_,
+            event_logger_, job_context_->job_id, io_priority,
+            &p->table_properties, write_hint, full_history_ts_low,
+            blob_callback_, &p->num_input_entries, &p->memtable_payload_bytes,
+            &p->memtable_garbage_bytes);
+        assert(!p->status.ok() || part_io_s.ok());
+        part_io_s.PermitUncheckedError();
+      };
+      auto partition_work = std::make_shared<FlushPartitionWork>(
+          partitions.size(), build_partition);
+      partition_work->stats = stats_;
+      if (!partitions.empty()) {
+        // Helpers run in the pool of this flush, with its priorities, the
+        // thread of this flush is one of the pool threads
+        const Env::Priority pool = Env::Priority::LOW == thread_pri_
+                                       ? Env::Priority::LOW
+                                       : Env::Priority::HIGH;
+        Env* const env = db_options_.env;
+        const int pool_threads = env->GetBackgroundThreads(pool);
+        const size_t num_helpers = std::min<size_t>(
+            partitions.size(), pool_threads > 1 ? pool_threads - 1 : 0);
+        for (size_t i = 0; i < num_helpers; i++) {
+          env->Schedule(&FlushPartitionWork::BGWork,
+                        new std::shared_ptr<FlushPartitionWork>(partition_work),
+                        pool, nullptr, &FlushPartitionWork::UnscheduleWork);
+        }
+      }
+
       s = BuildTable(
           dbname_, versions_, db_options_, tboptions, file_options_,
-          cfd_->table_cache(), iter.get(), std::move(range_del_iters), &meta_,
+          cfd_->table_cache(), input, std::move(range_del_iters), &meta_,
           &blob_file_additions, existing_snapshots_,
           earliest_write_conflict_snapshot_, job_snapshot_seq,
           snapshot_checker_, mutable_cf_options_.paranoid_file_checks,
@@ -946,6 +1176,30 @@ Status FlushJob::WriteLevel0Table() {
       // TODO: Cleanup io_status in BuildTable and table builders
       assert(!s.ok() || io_s.ok());
       io_s.PermitUncheckedError();
+      partition_work->Run(false /* on_helper */);
+      partition_work->WaitForHelpers();
+      for (auto& p : partitions) {
+        num_input_entries += p.num_input_entries;
+        memtable_payload_bytes += p.memtable_payload_bytes;
+        memtable_garbage_bytes += p.memtable_garbage_bytes;
+        if (s.ok()) {
+          s = p.status;
+        } else {
+          p.status.PermitUncheckedError();
+        }
+      }
+      if (s.ok()) {
+        for (auto& p : partitions) {
+          if (p.meta.fd.GetFileSize() > 0) {
+            partition_meta_.push_back(p.meta);
+            partition_table_properties_.push_back(
+                std::move(p.table_properties));
+          }
+          for (auto& blob : p.blob_file_additions) {
+            blob_file_additions.push_back(std::move(blob));
+          }
+        }
+      }
       if (num_input_entries != total_num_entries && s.ok()) {
         std::string msg = "Expected " + std::to_string(total_num_entries) +
                           " entries in memtables, but read " +
@@ -974,6 +1228,14 @@ Status FlushJob::WriteLevel0Table() {
                      meta_.fd.GetNumber(), meta_.fd.GetFileSize(),
                      s.ToString().c_str(),
                      meta_.marked_for_compaction ? " (needs compaction)" : "");
+    for (const FileMetaData& f : partition_meta_) {
+      ROCKS_LOG_BUFFER(log_buffer_,
+                       "[%s] [JOB %d] Level-0 flush partition table #%" PRIu64
+                       ": %" PRIu64 " bytes%s",
+                       cfd_->GetName().c_str(), job_context_->job_id,
+                       f.fd.GetNumber(), f.fd.GetFileSize(),
+                       f.marked_for_compaction ? " (needs compaction)" : "");
+    }
 
     if (s.ok() && output_file_directory_ != nullptr && sync_output_directory_) {
       s = output_file_directory_->FsyncWithDirOptions(
@@ -987,7 +1249,8 @@ Status FlushJob::WriteLevel0Table() {
 
   // Note that if file_size is zero, the file has been deleted and
   // should not be added to the manifest.
-  const bool has_output = meta_.fd.GetFileSize() > 0;
+  const bool has_output =
+      meta_.fd.GetFileSize() > 0 || !partition_meta_.empty();
 
   if (s.ok() && has_output) {
     TEST_SYNC_POINT("DBImpl::FlushJob:SSTFileCreated");
@@ -995,15 +1258,27 @@ Status FlushJob::WriteLevel0Table() {
     // insert files directly into higher levels because some other
     // threads could be concurrently producing compacted files for
     // that key range.
-    // Add file to L0
-    edit_->AddFile(0 /* level */, meta_.fd.GetNumber(), meta_.fd.GetPathId(),
-                   meta_.fd.GetFileSize(), meta_.smallest, meta_.largest,
-                   meta_.fd.smallest_seqno, meta_.fd.largest_seqno,
-                   meta_.marked_for_compaction, meta_.temperature,
-                   meta_.oldest_blob_file_number, meta_.oldest_ancester_time,
-                   meta_.file_creation_time, meta_.epoch_number,
-                   meta_.file_checksum, meta_.file_checksum_func_name,
-                   meta_.unique_id);
+    // Add file to L0, the partitions share the epoch number of the flush
+    // as their key ranges are disjoint
+    if (meta_.fd.GetFileSize() > 0) {
+      edit_->AddFile(0 /* level */, meta_.fd.GetNumber(), meta_.fd.GetPathId(),
+                     meta_.fd.GetFileSize(), meta_.smallest, meta_.largest,
+                     meta_.fd.smallest_seqno, meta_.fd.largest_seqno,
+                     meta_.marked_for_compaction, meta_.temperature,
+                     meta_.oldest_blob_file_number, meta_.oldest_ancester_time,
+                     meta_.file_creation_time, meta_.epoch_number,
+                     meta_.file_checksum, meta_.file_checksum_func_name,
+                     meta_.unique_id);
+    }
+    for (const FileMetaData& f : partition_meta_) {
+      edit_->AddFile(0 /* level */, f.fd.GetNumber(), f.fd.GetPathId(),
+                     f.fd.GetFileSize(), f.smallest, f.largest,
+                     f.fd.smallest_seqno, f.fd.largest_seqno,
+                     f.marked_for_compaction, f.temperature,
+                     f.oldest_blob_file_number, f.oldest_ancester_time,
+                     f.file_creation_time, f.epoch_number, f.file_checksum,
+                     f.file_checksum_func_name, f.unique_id);
+    }
 
     edit_->SetBlobFileAdditions(std::move(blob_file_additions));
   }
@@ -1027,7 +1302,11 @@ Status FlushJob::WriteLevel0Table() {
 
   if (has_output) {
     stats.bytes_written = meta_.fd.GetFileSize();
-    stats.num_output_files = 1;
+    stats.num_output_files = meta_.fd.GetFileSize() > 0 ? 1 : 0;
+    for (const FileMetaData& f : partition_meta_) {
+      stats.bytes_written += f.fd.GetFileSize();
+      stats.num_output_files++;
+    }
   }
 
   const auto& blobs = edit_->GetBlobFileAdditions();
@@ -1090,6 +1369,20 @@ std::unique_ptr<FlushJobInfo> FlushJob::GetFlushJobInfo() const {
     info->blob_file_addition_infos.emplace_back(
         std::move(blob_file_addition_info));
   }
+
+  assert(partition_table_properties_.size() == partition_meta_.size());
+  for (size_t i = 0; i < partition_meta_.size(); i++) {
+    const FileMetaData& f = partition_meta_[i];
+    FlushPartitionFileInfo part;
+    part.file_path = MakeTableFileName(cfd_->ioptions()->cf_paths[0].path,
+                                       f.fd.GetNumber());
+    part.file_number = f.fd.GetNumber();
+    part.oldest_blob_file_number = f.oldest_blob_file_number;
+    part.smallest_seqno = f.fd.smallest_seqno;
+    part.largest_seqno = f.fd.largest_seqno;
+    part.table_properties = partition_table_properties_[i];
+    info->partition_file_infos.push_back(std::move(part));
+  }
   return info;
 }
 #endif  // !ROCKSDB_LITE
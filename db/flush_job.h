@@ -89,6 +89,13 @@ class FlushJob {
   void Cancel();
   const autovector<MemTable*>& GetMemTables() const { return mems_; }
 
+  // When the flush was split by DBOptions::max_flush_partitions, the L0
+  // files of the key ranges after the first one. The first one is returned
+  // by Run() in file_meta.
+  const std::vector<FileMetaData>& GetPartitionFileMetaData() const {
+    return partition_meta_;
+  }
+
 #ifndef ROCKSDB_LITE
   std::list<std::unique_ptr<FlushJobInfo>>* GetCommittedFlushJobsInfo() {
     return &committed_flush_jobs_info_;
@@ -102,6 +109,10 @@ class FlushJob {
   void ReportFlushInputSize(const autovector<MemTable*>& mems);
   void RecordFlushIOStats();
   Status WriteLevel0Table();
+  // Sample the memtables for the internal keys splitting them into key
+  // ranges of about the same size, see DBOptions::max_flush_partitions.
+  // Empty if the flush should not be split.
+  std::vector<std::string> GenPartitionBounds(uint64_t total_data_size) const;
 
   // Memtable Garbage Collection algorithm: a MemPurge takes the list
   // of immutable memtables and filters out (or "purge") the outdated bytes
@@ -182,6 +193,10 @@ class FlushJob {
 
   // Variables below are set by PickMemTable():
   FileMetaData meta_;
+  // Set by WriteLevel0Table(), see GetPartitionFileMetaData()
+  std::vector<FileMetaData> partition_meta_;
+  // Table properties of partition_meta_, reported by GetFlushJobInfo()
+  std::vector<TableProperties> partition_table_properties_;
   autovector<MemTable*> mems_;
   VersionEdit* edit_;
   Version* base_;
@@ -299,6 +299,8 @@ static const std::string num_running_flushes = "num-running-flushes";
 static const std::string actual_delayed_write_rate =
     "actual-delayed-write-rate";
 static const std::string is_write_stopped = "is-write-stopped";
+static const std::string write_controller_policy_stats =
+    "write-controller-policy-stats";
 static const std::string estimate_oldest_key_time = "estimate-oldest-key-time";
 static const std::string block_cache_capacity = "block-cache-capacity";
 static const std::string block_cache_usage = "block-cache-usage";
@@ -396,6 +398,8 @@ const std::string DB::Properties::kActualDelayedWriteRate =
     rocksdb_prefix + actual_delayed_write_rate;
 const std::string DB::Properties::kIsWriteStopped =
     rocksdb_prefix + is_write_stopped;
+const std::string DB::Properties::kWriteControllerPolicyStats =
+    rocksdb_prefix + write_controller_policy_stats;
 const std::string DB::Properties::kEstimateOldestKeyTime =
     rocksdb_prefix + estimate_oldest_key_time;
 const std::string DB::Properties::kBlockCacheCapacity =
@@ -565,6 +569,9 @@ const UnorderedMap<std::string, DBPropertyInfo>
         {DB::Properties::kIsWriteStopped,
          {false, nullptr, &InternalStats::HandleIsWriteStopped, nullptr,
           nullptr}},
+        {DB::Properties::kWriteControllerPolicyStats,
+         {false, nullptr, nullptr, nullptr,
+          &DBImpl::GetPropertyHandleWriteControllerPolicyStats}},
         {DB::Properties::kEstimateOldestKeyTime,
          {false, nullptr, &InternalStats::HandleEstimateOldestKeyTime, nullptr,
           nullptr}},
@@ -1830,6 +1837,18 @@ void InternalStats::DumpCFStatsNoFileHistogram(bool is_periodic,
            blob_st.total_garbage_size / kGB, blob_st.space_amp);
   value->append(buf);
 
+  const auto& separation_policy = cfd_->ioptions()->blob_separation_policy;
+  if (separation_policy) {
+    const std::string policy_stats = separation_policy->GetPrintableStats();
+    if (!policy_stats.empty()) {
+      value->append("Blob separation policy ");
+      value->append(separation_policy->Name());
+      value->append(":\n");
+      value->append(policy_stats);
+      value->append("\n");
+    }
+  }
+
   uint64_t now_micros = clock_->NowMicros();
   double seconds_up = (now_micros - started_at_) / kMicrosInSec;
   double interval_seconds_up = seconds_up - cf_stats_snapshot_.seconds_up;
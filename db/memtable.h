@@ -154,6 +154,11 @@ class MemTable {
            arena_.MemoryAllocatedBytes();
   }
 
+  // False if the memtable representation can't UniqueRandomSample()
+  bool SupportUniqueRandomSample() const {
+    return table_->SupportUniqueRandomSample();
+  }
+
   // Returns a vector of unique random memtable entries of size 'sample_size'.
   //
   // Note: the entries are stored in the unordered_set as length-prefixed keys,
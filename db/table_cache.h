@@ -190,6 +190,14 @@ class TableCache {
                                const FileMetaData& file_meta,
                                std::vector<TableReader::Anchor>& anchors);
 
+  // Append up to num internal keys sampled uniformly from the file, see
+  // TableReader::GetRandomInternalKeysAppend(). Returns NotSupported if the
+  // table does not implement it.
+  Status GetRandomInternalKeysAppend(
+      const ReadOptions& ro, const InternalKeyComparator& internal_comparator,
+      const FileMetaData& file_meta, size_t num,
+      std::vector<std::string>* output);
+
   // Return total memory usage of the table reader of the file.
   // 0 if table reader of the file is not loaded.
   size_t GetMemoryUsageByTableReader(
@@ -2482,6 +2482,57 @@ void Version::MultiGetBlob(
   }
 }
 
+void Version::MultiGetBlob(const ReadOptions& read_options, size_t num_keys,
+                           const Slice* user_keys,
+                           PinnableSlice* const* values,
+                           Status* const* statuses) {
+  std::unordered_map<uint64_t, autovector<BlobReadRequest>> reqs_by_file;
+  for (size_t i = 0; i < num_keys; ++i) {
+    BlobIndex blob_index;
+    Status s = blob_index.DecodeFrom(*values[i]);
+    if (!s.ok()) {
+      *statuses[i] = s;
+      continue;
+    }
+    if (blob_index.HasTTL() || blob_index.IsInlined()) {
+      *statuses[i] = Status::Corruption("Unexpected TTL/inlined blob index");
+      continue;
+    }
+    if (!storage_info_.GetBlobFileMetaData(blob_index.file_number())) {
+      *statuses[i] = Status::Corruption("Invalid blob file number");
+      continue;
+    }
+    values[i]->Reset();
+    reqs_by_file[blob_index.file_number()].emplace_back(
+        user_keys[i], blob_index.offset(), blob_index.size(),
+        blob_index.compression(), values[i], statuses[i]);
+  }
+  if (reqs_by_file.empty()) {
+    return;
+  }
+
+  // BlobSource reads at most MAX_BATCH_SIZE blobs of a file at once
+  autovector<BlobFileReadRequests> blob_reqs;
+  for (auto& [file_number, reqs] : reqs_by_file) {
+    const auto file_size =
+        storage_info_.GetBlobFileMetaData(file_number)->GetBlobFileSize();
+    std::sort(reqs.begin(), reqs.end(),
+              [](const BlobReadRequest& x, const BlobReadRequest& y) {
+                return x.offset < y.offset;
+              });
+    for (size_t beg = 0; beg < reqs.size();
+         beg += MultiGetContext::MAX_BATCH_SIZE) {
+      size_t end = std::min(reqs.size(), beg + MultiGetContext::MAX_BATCH_SIZE);
+      autovector<BlobReadRequest> chunk;
+      for (size_t k = beg; k < end; ++k) {
+        chunk.push_back(reqs[k]);
+      }
+      blob_reqs.emplace_back(file_number, file_size, std::move(chunk));
+    }
+  }
+  blob_source_->MultiGetBlob(read_options, blob_reqs, /*bytes_read=*/nullptr);
+}
+
 void Version::Get(const ReadOptions& read_options, const LookupKey& k,
                   PinnableSlice* value, PinnableWideColumns* columns,
                   std::string* timestamp, Status* status,
@@ -3447,6 +3498,26 @@ uint32_t GetExpiredTtlFilesCount(const ImmutableOptions& ioptions,
   }
   return ttl_expired_files_count;
 }
+
+// The L0 files written by one flush split by DBOptions::max_flush_partitions
+// share an epoch number and have disjoint key ranges, they are one sorted
+// run. L0 files are ordered by epoch number, so such files are adjacent.
+int CountL0SortedRuns(const std::vector<FileMetaData*>& files,
+                      bool skip_being_compacted) {
+  int num_sorted_runs = 0;
+  uint64_t prev_epoch_number = kUnknownEpochNumber;
+  for (auto* f : files) {
+    if (skip_being_compacted && f->being_compacted) {
+      continue;
+    }
+    if (f->epoch_number == kUnknownEpochNumber ||
+        f->epoch_number != prev_epoch_number) {
+      num_sorted_runs++;
+    }
+    prev_epoch_number = f->epoch_number;
+  }
+  return num_sorted_runs;
+}
 }  // anonymous namespace
 
 void VersionStorageInfo::ComputeCompactionScore(
@@ -3476,13 +3547,13 @@ void VersionStorageInfo::ComputeCompactionScore(
       // file size is small (perhaps because of a small write-buffer
       // setting, or very high compression ratios, or lots of
       // overwrites/deletions).
-      int num_sorted_runs = 0;
+      int num_sorted_runs =
+          CountL0SortedRuns(files_[level], true /* skip_being_compacted */);
       uint64_t total_size = 0;
       for (auto* f : files_[level]) {
         total_downcompact_bytes += static_cast<double>(f->fd.GetFileSize());
         if (!f->being_compacted) {
           total_size += f->compensated_file_size;
-          num_sorted_runs++;
         }
       }
       if (compaction_style_ == kCompactionStyleUniversal) {
@@ -3952,7 +4023,8 @@ void VersionStorageInfo::UpdateNumNonEmptyLevels() {
 }
 
 namespace {
-// Sort `temp` based on ratio of overlapping size over file size
+// Sort `temp` based on ratio of overlapping size over file size, or on
+// overlapping bytes for kMinOverlappingBytes
 void SortFileByOverlapping(CompactionPri pri,
     const InternalKeyComparator& icmp, const std::vector<FileMetaData*>& files,
     const std::vector<FileMetaData*>& next_level_files, SystemClock* clock,
@@ -3972,6 +4044,21 @@ void SortFileByOverlapping(CompactionPri pri,
   FileTtlBooster ttl_booster(static_cast<uint64_t>(curr_time), ttl,
                              num_non_empty_levels, level);
 
+  // For kReadHeatOverlappingRatio, the average read density of the level
+  double level_read_density = 0;
+  if (pri == kReadHeatOverlappingRatio) {
+    uint64_t level_reads = 0;
+    uint64_t level_size = 0;
+    for (auto& file : files) {
+      level_reads +=
+          file->stats.num_reads_sampled.load(std::memory_order_relaxed);
+      level_size += file->compensated_file_size;
+    }
+    if (level_size > 0) {
+      level_read_density = double(level_reads) / level_size;
+    }
+  }
+
   for (auto& file : files) {
     uint64_t overlapping_bytes = 0;
     // Skip files in next level that is smaller than current file
@@ -3994,9 +4081,16 @@ void SortFileByOverlapping(CompactionPri pri,
     uint64_t ttl_boost_score = (ttl > 0) ? ttl_booster.GetBoostScore(file) : 1;
     assert(ttl_boost_score > 0);
     assert(file->compensated_file_size != 0);
-    file_to_order[file->fd.GetNumber()] = overlapping_bytes * 1024U /
+    uint64_t score = overlapping_bytes * 1024U /
        (pri == kMinOverlappingBytes ? 1 : file->compensated_file_size) /
                                           ttl_boost_score;
+    if (level_read_density > 0) {
+      uint64_t reads =
+          file->stats.num_reads_sampled.load(std::memory_order_relaxed);
+      double read_density = double(reads) / file->compensated_file_size;
+      score = uint64_t(score / (1 + read_density / level_read_density));
+    }
+    file_to_order[file->fd.GetNumber()] = score;
   }
 
   size_t num_to_sort = temp->size() > VersionStorageInfo::kNumberFilesToSort
@@ -4036,6 +4130,16 @@ void SortFileByOverlappingBytes(
                         clock, level, num_non_empty_levels, ttl, temp);
 }
 
+void SortFileByReadHeatOverlappingRatio(
+    const InternalKeyComparator& icmp, const std::vector<FileMetaData*>& files,
+    const std::vector<FileMetaData*>& next_level_files, SystemClock* clock,
+    int level, int num_non_empty_levels, uint64_t ttl,
+    std::vector<Fsize>* temp) {
+  SortFileByOverlapping(kReadHeatOverlappingRatio, icmp, files,
+                        next_level_files, clock, level, num_non_empty_levels,
+                        ttl, temp);
+}
+
 void SortFileByRoundRobin(const InternalKeyComparator& icmp,
                           std::vector<InternalKey>* compact_cursor,
                           bool level0_non_overlapping, int level,
@@ -4151,6 +4255,11 @@ void VersionStorageInfo::UpdateFilesByCompactionPri(
                                    files_[level + 1], ioptions.clock, level,
                                    num_non_empty_levels_, options.ttl, &temp);
         break;
+      case kReadHeatOverlappingRatio:
+        SortFileByReadHeatOverlappingRatio(
+            *internal_comparator_, files_[level], files_[level + 1],
+            ioptions.clock, level, num_non_empty_levels_, options.ttl, &temp);
+        break;
       default:
         assert(false);
     }
@@ -4675,7 +4784,8 @@ void VersionStorageInfo::CalculateBaseBytes(const ImmutableOptions& ioptions,
                                             const MutableCFOptions& options) {
   // Special logic to set number of sorted runs.
   // It is to match the previous behavior when all files are in L0.
-  int num_l0_count = static_cast<int>(files_[0].size());
+  int num_l0_count =
+      CountL0SortedRuns(files_[0], false /* skip_being_compacted */);
   if (compaction_style_ == kCompactionStyleUniversal) {
     // For universal compaction, we use level0 score to indicate
     // compaction score for the whole DB. Adding other levels as if
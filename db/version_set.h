@@ -897,6 +897,13 @@ class Version {
   void MultiGetBlob(const ReadOptions& read_options, MultiGetRange& range,
                     std::unordered_map<uint64_t, BlobReadContexts>& blob_ctxs);
 
+  // Resolves the blob indexes which Get() returned in `values` of keys for
+  // which it set `is_blob`, the blobs of all keys and files are read by one
+  // BlobSource::MultiGetBlob, used by the fiber MultiGet.
+  void MultiGetBlob(const ReadOptions& read_options, size_t num_keys,
+                    const Slice* user_keys, PinnableSlice* const* values,
+                    Status* const* statuses);
+
   // Loads some stats information from files (if update_stats is set) and
   // populates derived data structures. Call without mutex held. It needs to be
   // called before appending the version to the version set.
@@ -5,12 +5,23 @@
 
 #pragma once
 
+#include "rocksdb/slice.h"
 #include "rocksdb/status.h"
 
 namespace ROCKSDB_NAMESPACE {
 
 class DB;
 
+// The keys written by the writers which precede a writer in its write group
+// and passed their callbacks. Those writes are not in the memtable yet when
+// the callbacks of the write group are called.
+class WriteGroupKeys {
+ public:
+  virtual ~WriteGroupKeys() {}
+
+  virtual bool Contains(uint32_t cf_id, const Slice& key) const = 0;
+};
+
 class WriteCallback {
  public:
   virtual ~WriteCallback() {}
@@ -22,6 +33,16 @@ class WriteCallback {
 
   // return true if writes with this callback can be batched with other writes
   virtual bool AllowWriteBatching() = 0;
+
+  // return true if Callback(db, group_keys) should be called instead of
+  // Callback(db) when this write is batched behind other writes
+  virtual bool NeedWriteGroupKeys() { return false; }
+
+  // Like Callback(db), but also sees the keys of the preceding writes in the
+  // same write group, which is only called if NeedWriteGroupKeys()
+  virtual Status Callback(DB* db, const WriteGroupKeys& /*group_keys*/) {
+    return Callback(db);
+  }
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -9,11 +9,15 @@
 
 #include <atomic>
 #include <functional>
+#include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "db/db_impl/db_impl.h"
+#include "db/write_batch_internal.h"
+#include "db/write_thread.h"
 #include "port/port.h"
 #include "rocksdb/db.h"
 #include "rocksdb/write_batch.h"
@@ -445,6 +449,126 @@ TEST_F(WriteCallbackTest, WriteCallBackTest) {
   ASSERT_OK(DestroyDB(dbname, options));
 }
 
+TEST_F(WriteCallbackTest, WriteGroupKeyIndex) {
+  WriteBatch wb1, wb2;
+  ASSERT_OK(wb1.Put("a", "value.a"));
+  ASSERT_OK(wb1.Delete("b"));
+  ASSERT_OK(WriteBatchInternal::Merge(&wb1, 1, "c", "value.c"));
+  ASSERT_OK(WriteBatchInternal::DeleteRange(&wb2, 2, "x", "y"));
+
+  WriteThread::WriteGroupKeyIndex index;
+  ASSERT_FALSE(index.Contains(0, "a"));
+  index.Add(&wb1);
+  ASSERT_TRUE(index.Contains(0, "a"));
+  ASSERT_TRUE(index.Contains(0, "b"));
+  ASSERT_FALSE(index.Contains(0, "c"));
+  ASSERT_TRUE(index.Contains(1, "c"));
+  ASSERT_FALSE(index.Contains(2, "z"));
+
+  // a range deletion covers all keys of its column family
+  index.Add(&wb2);
+  ASSERT_TRUE(index.Contains(2, "z"));
+  ASSERT_FALSE(index.Contains(3, "z"));
+}
+
+TEST_F(WriteCallbackTest, WriteGroupKeysBefore) {
+  // Fails if a key was written by the preceding writes of the group
+  class GroupKeysCallback : public WriteCallback {
+   public:
+    explicit GroupKeysCallback(std::vector<std::string> keys)
+        : keys_(std::move(keys)) {}
+    Status Callback(DB* /*db*/) override { return Status::OK(); }
+    Status Callback(DB* /*db*/, const WriteGroupKeys& group_keys) override {
+      saw_group_keys_ = true;
+      for (const auto& key : keys_) {
+        if (group_keys.Contains(0, key)) {
+          return Status::Busy("Write Conflict");
+        }
+      }
+      return Status::OK();
+    }
+    bool AllowWriteBatching() override { return true; }
+    bool NeedWriteGroupKeys() override { return true; }
+
+    std::atomic<bool> saw_group_keys_{false};
+
+   private:
+    std::vector<std::string> keys_;
+  };
+
+  Options options;
+  options.create_if_missing = true;
+  ASSERT_OK(DestroyDB(dbname, options));
+  DB* db;
+  ASSERT_OK(DB::Open(options, dbname, &db));
+  DBImpl* db_impl = dynamic_cast<DBImpl*>(db);
+  ASSERT_TRUE(db_impl);
+
+  // The leader writes a, the 3rd writer conflicts with it. The 4th writer
+  // writes d like the 3rd, which is not a conflict as the 3rd failed.
+  const std::vector<std::vector<std::string>> keys = {
+      {"a"}, {"b"}, {"a", "d"}, {"d"}};
+  const size_t kWriters = keys.size();
+  std::vector<std::unique_ptr<GroupKeysCallback>> callbacks;
+  std::vector<WriteBatch> batches(kWriters);
+  for (size_t i = 0; i < kWriters; i++) {
+    callbacks.emplace_back(new GroupKeysCallback(keys[i]));
+    for (const auto& key : keys[i]) {
+      ASSERT_OK(batches[i].Put(key, "v" + std::to_string(i)));
+    }
+  }
+
+  // The writers are linked one by one, the leader waits for all of them
+  std::atomic<size_t> linked(0);
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "WriteThread::JoinBatchGroup:Wait", [&](void*) { linked++; });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::WriteImpl:BeforeLeaderEnters", [&](void*) {
+        while (linked.load() < kWriters) {
+          std::this_thread::yield();
+        }
+      });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  std::vector<Status> statuses(kWriters);
+  std::vector<port::Thread> threads;
+  for (size_t i = 0; i < kWriters; i++) {
+    threads.emplace_back([&, i]() {
+      statuses[i] =
+          db_impl->WriteWithCallback(WriteOptions(), &batches[i],
+                                     callbacks[i].get());
+    });
+    while (linked.load() < i + 1) {
+      std::this_thread::yield();
+    }
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  // All the followers were checked against the keys of the group
+  for (size_t i = 1; i < kWriters; i++) {
+    ASSERT_TRUE(callbacks[i]->saw_group_keys_.load());
+  }
+  ASSERT_OK(statuses[0]);
+  ASSERT_OK(statuses[1]);
+  ASSERT_TRUE(statuses[2].IsBusy());
+  ASSERT_OK(statuses[3]);
+
+  std::string value;
+  ASSERT_OK(db->Get(ReadOptions(), "a", &value));
+  ASSERT_EQ(value, "v0");
+  ASSERT_OK(db->Get(ReadOptions(), "b", &value));
+  ASSERT_EQ(value, "v1");
+  ASSERT_OK(db->Get(ReadOptions(), "d", &value));
+  ASSERT_EQ(value, "v3");
+
+  delete db;
+  ASSERT_OK(DestroyDB(dbname, options));
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -8,6 +8,8 @@
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <cinttypes>
+#include <cstdio>
 #include <ratio>
 
 #include "rocksdb/system_clock.h"
@@ -118,4 +120,128 @@ CompactionPressureToken::~CompactionPressureToken() {
   assert(controller_->total_compaction_pressure_ >= 0);
 }
 
+CompactionThroughputWriteControllerPolicy::
+    CompactionThroughputWriteControllerPolicy(
+        const CompactionThroughputWriteControllerOptions& opts)
+    : opts_(opts) {}
+
+double CompactionThroughputWriteControllerPolicy::Update(
+    const WriteStallFeedback& fb) {
+  if (!has_sample_ || fb.now_micros < last_micros_) {
+    has_sample_ = true;
+    last_micros_ = fb.now_micros;
+    last_pending_bytes_ = fb.pending_compaction_bytes;
+    last_compaction_bytes_ = fb.compaction_bytes;
+    last_remote_compaction_bytes_ = fb.remote_compaction_bytes;
+    return 1.0;
+  }
+  uint64_t elapsed = fb.now_micros - last_micros_;
+  if (elapsed < std::max(opts_.update_interval_micros, uint64_t{1})) {
+    return 1.0;
+  }
+  const double kMicrosPerSecond = 1000000.0;
+  double seconds = elapsed / kMicrosPerSecond;
+  double throughput = (fb.compaction_bytes - last_compaction_bytes_) / seconds;
+  double remote_throughput =
+      (fb.remote_compaction_bytes - last_remote_compaction_bytes_) / seconds;
+  double trend = (static_cast<double>(fb.pending_compaction_bytes) -
+                  static_cast<double>(last_pending_bytes_)) /
+                 seconds;
+  if (stats_.updates == 0) {
+    stats_.compaction_throughput = throughput;
+    stats_.remote_compaction_throughput = remote_throughput;
+    stats_.pending_bytes_trend = trend;
+  } else {
+    double w = std::min(std::max(opts_.smoothing, 0.0), 1.0);
+    stats_.compaction_throughput =
+        w * throughput + (1 - w) * stats_.compaction_throughput;
+    stats_.remote_compaction_throughput =
+        w * remote_throughput + (1 - w) * stats_.remote_compaction_throughput;
+    stats_.pending_bytes_trend =
+        w * trend + (1 - w) * stats_.pending_bytes_trend;
+  }
+  stats_.updates++;
+  last_micros_ = fb.now_micros;
+  last_pending_bytes_ = fb.pending_compaction_bytes;
+  last_compaction_bytes_ = fb.compaction_bytes;
+  last_remote_compaction_bytes_ = fb.remote_compaction_bytes;
+
+  double ratio = 1.0;
+  if (stats_.compaction_throughput > 0) {
+    // The debt added per admitted byte is (T + D) / rate, if it is not
+    // positive the debt is paid off at any rate.
+    double inflow = stats_.compaction_throughput + stats_.pending_bytes_trend;
+    ratio = inflow > 0 ? stats_.compaction_throughput / inflow
+                       : opts_.max_increase_ratio;
+    ratio = std::min(std::max(ratio, opts_.max_decrease_ratio),
+                     opts_.max_increase_ratio);
+  }
+  if (fb.near_stop) {
+    ratio *= opts_.near_stop_ratio;
+    stats_.near_stop_penalties++;
+  }
+  return ratio;
+}
+
+uint64_t CompactionThroughputWriteControllerPolicy::Apply(
+    const WriteStallFeedback& fb, double ratio) {
+  uint64_t rate = static_cast<uint64_t>(
+      static_cast<double>(fb.delayed_write_rate) * ratio);
+  rate = std::min(std::max(rate, uint64_t{1}), fb.max_delayed_write_rate);
+  if (rate > fb.delayed_write_rate) {
+    stats_.rate_increases++;
+  } else if (rate < fb.delayed_write_rate) {
+    stats_.rate_decreases++;
+  }
+  stats_.last_rate = rate;
+  return rate;
+}
+
+uint64_t CompactionThroughputWriteControllerPolicy::GetDelayedWriteRate(
+    const WriteStallFeedback& fb) {
+  if (!has_sample_ && fb.near_stop) {
+    // Nothing measured yet, only react to the stop
+    Update(fb);
+    stats_.near_stop_penalties++;
+    return Apply(fb, opts_.near_stop_ratio);
+  }
+  return Apply(fb, Update(fb));
+}
+
+uint64_t CompactionThroughputWriteControllerPolicy::GetRecoveredWriteRate(
+    const WriteStallFeedback& fb) {
+  // Keep the measured rate for the next delay, but never lower it because
+  // of a recovery.
+  return Apply(fb, std::max(Update(fb), 1.0));
+}
+
+std::string CompactionThroughputWriteControllerPolicy::GetPrintableStats()
+    const {
+  std::string ret;
+  ret.reserve(400);
+  const int kBufferSize = 200;
+  char buffer[kBufferSize];
+  snprintf(buffer, kBufferSize,
+           "updates: %" PRIu64 " increases: %" PRIu64 " decreases: %" PRIu64
+           " near stop: %" PRIu64 "\n",
+           stats_.updates, stats_.rate_increases, stats_.rate_decreases,
+           stats_.near_stop_penalties);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize,
+           "compaction MB/s: %.3f remote MB/s: %.3f pending trend MB/s: %.3f"
+           " rate MB/s: %.3f\n",
+           stats_.compaction_throughput / 1048576.0,
+           stats_.remote_compaction_throughput / 1048576.0,
+           stats_.pending_bytes_trend / 1048576.0,
+           stats_.last_rate / 1048576.0);
+  ret.append(buffer);
+  return ret;
+}
+
+std::shared_ptr<WriteControllerPolicy>
+NewCompactionThroughputWriteControllerPolicy(
+    const CompactionThroughputWriteControllerOptions& opts) {
+  return std::make_shared<CompactionThroughputWriteControllerPolicy>(opts);
+}
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -9,8 +9,11 @@
 
 #include <atomic>
 #include <memory>
+#include <string>
+#include <utility>
 
 #include "rocksdb/rate_limiter.h"
+#include "rocksdb/write_controller_policy.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -85,6 +88,23 @@ class WriteController {
 
   RateLimiter* low_pri_rate_limiter() { return low_pri_rate_limiter_.get(); }
 
+  // The policy setting the delayed write rate, nullptr for the fixed ratios
+  WriteControllerPolicy* policy() const { return policy_.get(); }
+  void set_policy(std::shared_ptr<WriteControllerPolicy> policy) {
+    policy_ = std::move(policy);
+  }
+
+  // Account the input bytes of a finished compaction, as the feedback of the
+  // policy.
+  void RecordCompaction(uint64_t input_bytes, bool remote) {
+    compaction_bytes_ += input_bytes;
+    if (remote) {
+      remote_compaction_bytes_ += input_bytes;
+    }
+  }
+  uint64_t compaction_bytes() const { return compaction_bytes_; }
+  uint64_t remote_compaction_bytes() const { return remote_compaction_bytes_; }
+
  private:
   uint64_t NowMicrosMonotonic(SystemClock* clock);
 
@@ -107,6 +127,10 @@ class WriteController {
   uint64_t delayed_write_rate_;
 
   std::unique_ptr<RateLimiter> low_pri_rate_limiter_;
+
+  std::shared_ptr<WriteControllerPolicy> policy_;
+  uint64_t compaction_bytes_ = 0;
+  uint64_t remote_compaction_bytes_ = 0;
 };
 
 class WriteControllerToken {
@@ -145,4 +169,52 @@ class CompactionPressureToken : public WriteControllerToken {
   virtual ~CompactionPressureToken();
 };
 
+// See NewCompactionThroughputWriteControllerPolicy()
+class CompactionThroughputWriteControllerPolicy : public WriteControllerPolicy {
+ public:
+  explicit CompactionThroughputWriteControllerPolicy(
+      const CompactionThroughputWriteControllerOptions& opts);
+
+  const char* Name() const override {
+    return "CompactionThroughputWriteControllerPolicy";
+  }
+
+  uint64_t GetDelayedWriteRate(const WriteStallFeedback& fb) override;
+
+  uint64_t GetRecoveredWriteRate(const WriteStallFeedback& fb) override;
+
+  std::string GetPrintableStats() const override;
+
+  struct Stats {
+    // Intervals folded into the measurements
+    uint64_t updates = 0;
+    uint64_t rate_increases = 0;
+    uint64_t rate_decreases = 0;
+    // Updates which were lowered by near_stop_ratio
+    uint64_t near_stop_penalties = 0;
+    // Smoothed measurements, in bytes per second
+    double compaction_throughput = 0;
+    double remote_compaction_throughput = 0;
+    // Negative while the pending compaction bytes are paid off
+    double pending_bytes_trend = 0;
+    uint64_t last_rate = 0;
+  };
+  const Stats& GetStats() const { return stats_; }
+
+ private:
+  // Fold the interval since the last sample into the measurements and
+  // return the ratio to apply to the admitted rate, 1.0 if the interval is
+  // not over yet.
+  double Update(const WriteStallFeedback& fb);
+  uint64_t Apply(const WriteStallFeedback& fb, double ratio);
+
+  const CompactionThroughputWriteControllerOptions opts_;
+  bool has_sample_ = false;
+  uint64_t last_micros_ = 0;
+  uint64_t last_pending_bytes_ = 0;
+  uint64_t last_compaction_bytes_ = 0;
+  uint64_t last_remote_compaction_bytes_ = 0;
+  Stats stats_;
+};
+
 }  // namespace ROCKSDB_NAMESPACE
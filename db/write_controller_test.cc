@@ -239,6 +239,104 @@ TEST_F(WriteControllerTest, CreditAccumulation) {
   ASSERT_EQ(10 SECS, controller.GetDelay(clock_.get(), 10 MB));
 }
 
+TEST_F(WriteControllerTest, CompactionThroughputPolicy) {
+  CompactionThroughputWriteControllerOptions opts;
+  opts.smoothing = 1.0;  // only the last interval
+  CompactionThroughputWriteControllerPolicy policy(opts);
+
+  WriteStallFeedback fb;
+  fb.now_micros = 10 SECS;
+  fb.delayed_write_rate = 10 MBPS;
+  fb.max_delayed_write_rate = 100 MBPS;
+  fb.pending_compaction_bytes = 100 MB;
+  // First feedback is the baseline
+  ASSERT_EQ(10 MBPS, policy.GetDelayedWriteRate(fb));
+
+  // Compaction ran at 20 MB/s, while the debt grew by 5 MB/s: the debt per
+  // admitted byte is 2.5, the sustainable rate is 8 MB/s
+  fb.now_micros += 1 SECS;
+  fb.compaction_bytes += 20 MB;
+  fb.remote_compaction_bytes += 5 MB;
+  fb.pending_compaction_bytes += 5 MB;
+  uint64_t rate = policy.GetDelayedWriteRate(fb);
+  ASSERT_NEAR(8.0 MBPS, static_cast<double>(rate), 1.0);
+  ASSERT_NEAR(20.0 MBPS, policy.GetStats().compaction_throughput, 1.0);
+  ASSERT_NEAR(5.0 MBPS, policy.GetStats().remote_compaction_throughput, 1.0);
+  ASSERT_NEAR(5.0 MBPS, policy.GetStats().pending_bytes_trend, 1.0);
+  fb.delayed_write_rate = rate;
+
+  // Not reconsidered within the update interval
+  fb.now_micros += 1 SECS / 2;
+  fb.pending_compaction_bytes += 50 MB;
+  ASSERT_EQ(rate, policy.GetDelayedWriteRate(fb));
+
+  // The debt is paid off, bounded by max_increase_ratio
+  fb.now_micros += 1 SECS / 2;
+  fb.compaction_bytes += 20 MB;
+  fb.pending_compaction_bytes -= 60 MB;
+  rate = policy.GetDelayedWriteRate(fb);
+  ASSERT_NEAR(12.0 MBPS, static_cast<double>(rate), 1.0);
+  fb.delayed_write_rate = rate;
+
+  // No progress but near stop
+  fb.now_micros += 1 SECS;
+  fb.near_stop = true;
+  rate = policy.GetDelayedWriteRate(fb);
+  ASSERT_NEAR(12.0 * 0.6 MBPS, static_cast<double>(rate), 1.0);
+  fb.delayed_write_rate = rate;
+
+  const auto& stats = policy.GetStats();
+  ASSERT_EQ(3U, stats.updates);
+  ASSERT_EQ(1U, stats.rate_increases);
+  ASSERT_EQ(2U, stats.rate_decreases);
+  ASSERT_EQ(1U, stats.near_stop_penalties);
+  ASSERT_EQ(rate, stats.last_rate);
+  ASSERT_NE(std::string::npos, policy.GetPrintableStats().find("updates: 3"));
+}
+
+TEST_F(WriteControllerTest, CompactionThroughputPolicyRecovery) {
+  CompactionThroughputWriteControllerOptions opts;
+  opts.smoothing = 1.0;
+  auto policy = NewCompactionThroughputWriteControllerPolicy(opts);
+
+  WriteStallFeedback fb;
+  fb.delayed_write_rate = 10 MBPS;
+  fb.max_delayed_write_rate = 12 MBPS;
+  fb.pending_compaction_bytes = 100 MB;
+  // Nothing measured yet, only the stop is penalized
+  fb.near_stop = true;
+  uint64_t rate = policy->GetDelayedWriteRate(fb);
+  ASSERT_NEAR(6.0 MBPS, static_cast<double>(rate), 1.0);
+  fb.delayed_write_rate = rate;
+  fb.near_stop = false;
+
+  // The debt grows, but a recovery does not lower the rate
+  fb.now_micros += 1 SECS;
+  fb.compaction_bytes += 10 MB;
+  fb.pending_compaction_bytes += 10 MB;
+  ASSERT_EQ(rate, policy->GetRecoveredWriteRate(fb));
+
+  // The debt is paid off, but never above max_delayed_write_rate
+  fb.now_micros += 1 SECS;
+  fb.delayed_write_rate = 11 MBPS;
+  fb.compaction_bytes += 10 MB;
+  fb.pending_compaction_bytes -= 20 MB;
+  ASSERT_EQ(12 MBPS, policy->GetRecoveredWriteRate(fb));
+}
+
+TEST_F(WriteControllerTest, PolicyCompactionFeedback) {
+  WriteController controller(10 MBPS);
+  ASSERT_EQ(nullptr, controller.policy());
+  controller.set_policy(NewCompactionThroughputWriteControllerPolicy());
+  ASSERT_STREQ("CompactionThroughputWriteControllerPolicy",
+               controller.policy()->Name());
+
+  controller.RecordCompaction(3 MB, false);
+  controller.RecordCompaction(2 MB, true);
+  ASSERT_EQ(5 MB, controller.compaction_bytes());
+  ASSERT_EQ(2 MB, controller.remote_compaction_bytes());
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
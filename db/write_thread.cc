@@ -12,6 +12,7 @@
 #include "monitoring/perf_context_imp.h"
 #include "port/port.h"
 #include "test_util/sync_point.h"
+#include "util/hash.h"
 #include "util/random.h"
 #ifdef OS_LINUX
   #include <linux/futex.h>
@@ -861,4 +862,74 @@ void WriteThread::WaitForMemTableWriters() {
   newest_memtable_writer_.store(nullptr);
 }
 
+size_t WriteThread::WriteGroupKeyIndex::CFKeyHash::operator()(
+    const CFKey& k) const {
+  return static_cast<size_t>(GetSliceNPHash64(k.key, k.cf_id));
+}
+
+bool WriteThread::WriteGroupKeyIndex::Contains(uint32_t cf_id,
+                                               const Slice& key) const {
+  if (unknown_) {
+    return true;
+  }
+  if (!range_deleted_cfs_.empty() && range_deleted_cfs_.count(cf_id)) {
+    return true;
+  }
+  return keys_.count(CFKey{cf_id, key}) != 0;
+}
+
+void WriteThread::WriteGroupKeyIndex::Add(WriteBatch* batch) {
+  struct Indexer : public WriteBatch::Handler {
+    WriteGroupKeyIndex* index;
+    explicit Indexer(WriteGroupKeyIndex* i) : index(i) {}
+    Status Add(uint32_t cf_id, const Slice& key) {
+      index->keys_.insert(CFKey{cf_id, key});
+      return Status::OK();
+    }
+    Status PutCF(uint32_t cf_id, const Slice& key, const Slice&) override {
+      return Add(cf_id, key);
+    }
+    Status PutEntityCF(uint32_t cf_id, const Slice& key,
+                       const Slice&) override {
+      return Add(cf_id, key);
+    }
+    Status DeleteCF(uint32_t cf_id, const Slice& key) override {
+      return Add(cf_id, key);
+    }
+    Status SingleDeleteCF(uint32_t cf_id, const Slice& key) override {
+      return Add(cf_id, key);
+    }
+    Status MergeCF(uint32_t cf_id, const Slice& key, const Slice&) override {
+      return Add(cf_id, key);
+    }
+    Status PutBlobIndexCF(uint32_t cf_id, const Slice& key,
+                          const Slice&) override {
+      return Add(cf_id, key);
+    }
+    Status DeleteRangeCF(uint32_t cf_id, const Slice&, const Slice&) override {
+      index->range_deleted_cfs_.insert(cf_id);
+      return Status::OK();
+    }
+  };
+  Indexer indexer(this);
+  if (!batch->Iterate(&indexer).ok()) {
+    unknown_ = true;
+  }
+}
+
+const WriteGroupKeys& WriteThread::WriteGroup::KeysBefore(Writer* w) {
+  if (!key_index_) {
+    key_index_.reset(new WriteGroupKeyIndex);
+    key_index_->next = leader;
+  }
+  for (Writer* x = key_index_->next; x != w; x = x->link_newer) {
+    assert(x != nullptr);
+    if (!x->CallbackFailed() && x->batch != nullptr) {
+      key_index_->Add(x->batch);
+    }
+  }
+  key_index_->next = w;
+  return *key_index_;
+}
+
 }  // namespace ROCKSDB_NAMESPACE
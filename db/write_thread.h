@@ -10,8 +10,10 @@
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <type_traits>
+#include <unordered_set>
 #include <vector>
 
 #include "db/dbformat.h"
@@ -75,6 +77,33 @@ class WriteThread {
 
   struct Writer;
 
+  // Keys written by the writers of a write group, see WriteGroupKeys
+  class WriteGroupKeyIndex : public WriteGroupKeys {
+   public:
+    bool Contains(uint32_t cf_id, const Slice& key) const override;
+
+    // Indexes the keys of `batch`, which must outlive the index
+    void Add(WriteBatch* batch);
+
+    Writer* next = nullptr;  // the first writer not indexed yet
+
+   private:
+    struct CFKey {
+      uint32_t cf_id;
+      Slice key;
+      bool operator==(const CFKey& y) const {
+        return cf_id == y.cf_id && key == y.key;
+      }
+    };
+    struct CFKeyHash {
+      size_t operator()(const CFKey& k) const;
+    };
+    std::unordered_set<CFKey, CFKeyHash> keys_;
+    // column families with range deletions, all of their keys are written
+    std::unordered_set<uint32_t> range_deleted_cfs_;
+    bool unknown_ = false;  // a batch could not be indexed
+  };
+
   struct WriteGroup {
     Writer* leader = nullptr;
     Writer* last_writer = nullptr;
@@ -110,6 +139,13 @@ class WriteThread {
 
     Iterator begin() const { return Iterator(leader, last_writer); }
     Iterator end() const { return Iterator(nullptr, nullptr); }
+
+    // Keys of the writers before `w` which passed their callbacks. Callbacks
+    // are checked in group order, so the index only grows.
+    const WriteGroupKeys& KeysBefore(Writer* w);
+
+   private:
+    std::unique_ptr<WriteGroupKeyIndex> key_index_;
   };
 
   // Information kept for every waiting writer.
@@ -204,7 +240,13 @@ class WriteThread {
 
     bool CheckCallback(DB* db) {
       if (callback != nullptr) {
-        callback_status = callback->Callback(db);
+        if (callback->NeedWriteGroupKeys() && write_group != nullptr &&
+            write_group->leader != this) {
+          callback_status =
+              callback->Callback(db, write_group->KeysBefore(this));
+        } else {
+          callback_status = callback->Callback(db);
+        }
       }
       return callback_status.ok();
     }
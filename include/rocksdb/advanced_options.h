@@ -67,7 +67,16 @@ ROCKSDB_ENUM_PLAIN(CompactionPri, unsigned char,
   // kMinOverlappingBytes ignore current file size, it is equivalent to we
   // assume all files in current level are same size, thus small files are
   // treated equally.
-  kMinOverlappingBytes = 0x5
+  kMinOverlappingBytes = 0x5,
+
+  // kMinOverlappingRatio weighted by where reads go: the overlapping ratio
+  // of a file is divided by 1 + its read density (sampled reads from Get()
+  // and iterators per byte, FileMetaData::stats.num_reads_sampled) relative
+  // to the average read density of its level. Read-hot ranges are compacted
+  // first, reducing the number of levels such reads have to look at, while
+  // cold ranges are deferred. Without sampled reads on a level, it is the
+  // same as kMinOverlappingRatio.
+  kReadHeatOverlappingRatio = 0x6
 );
 
 struct CompactionOptionsFIFO {
@@ -703,6 +712,24 @@ struct AdvancedColumnFamilyOptions {
   // safe.
   bool ignore_max_compaction_bytes_for_input = true;
 
+  // For level compaction, if non-zero, L0 is compacted as a tiered level
+  // while the write rate measured on L0 is at least this many bytes per
+  // second: when level0_file_num_compaction_trigger is reached, the newest
+  // L0 files (sorted runs) of similar sizes are merged into one L0 file
+  // instead of being compacted into the base level. L0 is compacted into the
+  // base level once its size reaches max_bytes_for_level_base, or when no
+  // such merge can be picked. When the write rate drops below this value,
+  // L0 is leveled as usual.
+  //
+  // This trades read amplification on L0 for lower write amplification
+  // during write bursts. The write rate is estimated from the sizes of the
+  // current L0 files and the oldest ancestor time among them.
+  //
+  // Default: 0 (L0 is always leveled)
+  //
+  // Dynamically changeable through SetOptions() API
+  uint64_t level0_tiered_write_rate = 0;
+
   // All writes will be slowed down to at least delayed_write_rate if estimated
   // bytes needed to be compaction exceed this threshold.
   //
@@ -0,0 +1,91 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "rocksdb/listener.h"
+#include "rocksdb/rocksdb_namespace.h"
+#include "rocksdb/slice.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class SliceTransform;
+
+// What a BlobSeparationPolicy knows about the value it is asked about.
+struct BlobSeparationContext {
+  // The column family wide threshold, MutableCFOptions::min_blob_size
+  uint64_t min_blob_size = 0;
+  // kFlush for values written since the last flush, kCompaction for values
+  // rewritten by compaction, including the ones relocated by blob GC
+  BlobFileCreationReason reason = BlobFileCreationReason::kFlush;
+};
+
+// Decides, value by value, whether flush and compaction write a value to a
+// blob file or keep it in the SST, replacing the single min_blob_size
+// threshold of the column family. Only used when enable_blob_files is true.
+//
+// Methods are called concurrently by the flushes and compactions of all
+// column families the policy is configured for.
+//
+// Compactions run by a compaction_executor_factory are not asked, the
+// worker separates the values it writes by min_blob_size.
+class BlobSeparationPolicy {
+ public:
+  virtual ~BlobSeparationPolicy() {}
+
+  virtual const char* Name() const = 0;
+
+  // Return true to write value to a blob file, false to keep it inline.
+  virtual bool ShouldSeparate(const Slice& user_key, const Slice& value,
+                              const BlobSeparationContext& ctx) = 0;
+
+  // Called when flush or compaction drops a value of user_key because a
+  // newer value of the same key hides it.
+  virtual void OnOverwritten(const Slice& /*user_key*/) {}
+
+  // Appended to the column family stats, see DB::Properties::kCFStats.
+  virtual std::string GetPrintableStats() const { return std::string(); }
+};
+
+struct AdaptiveBlobSeparationOptions {
+  // Keys with the same prefix share their statistics. If nullptr, the prefix
+  // is the first prefix_length bytes of the key.
+  std::shared_ptr<const SliceTransform> prefix_extractor = nullptr;
+  size_t prefix_length = 8;
+
+  // Once max_prefixes prefixes are tracked, values of new prefixes are
+  // separated by min_blob_size.
+  size_t max_prefixes = 65536;
+
+  // The statistics of a prefix are used once min_samples values of it were
+  // flushed, before that its values are separated by min_blob_size.
+  uint64_t min_samples = 32;
+
+  // A prefix is hot when the number of its overwritten values reaches
+  // hot_overwrite_ratio times the number of its flushed values. Values of
+  // hot prefixes are kept inline up to max_hot_inline_size, they would
+  // mostly become blob garbage before being read again.
+  double hot_overwrite_ratio = 0.5;
+  uint64_t max_hot_inline_size = 64 << 10;
+
+  // The counters of a prefix are halved after decay_samples flushed values,
+  // so a prefix whose update pattern changes is reclassified.
+  uint64_t decay_samples = 1 << 16;
+};
+
+// A policy learning, per key prefix, how many values are flushed and
+// overwritten. Frequently overwritten prefixes, e.g. small counters, are kept
+// inline to avoid blob GC churn, and values of stable prefixes are separated
+// by min_blob_size. GetPrintableStats() reports the counters, the average
+// value size and the separated ratio of the busiest prefixes.
+std::shared_ptr<BlobSeparationPolicy> NewAdaptiveBlobSeparationPolicy(
+    const AdaptiveBlobSeparationOptions& opts =
+        AdaptiveBlobSeparationOptions());
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -37,6 +37,7 @@ namespace ROCKSDB_NAMESPACE {
 
 class Cache;
 struct ConfigOptions;
+class FileSystem;
 class Logger;
 class SecondaryCache;
 
@@ -114,6 +115,66 @@ ROCKSDB_ENUM_PLAIN(CacheMetadataChargePolicy, int,
 const CacheMetadataChargePolicy kDefaultCacheMetadataChargePolicy =
     kFullChargeCacheMetadata;
 
+// EXPERIMENTAL
+// A CacheAdmissionPolicy decides whether a data block missing from a full
+// cache is worth inserting, at the cost of evicting other entries. Without
+// one, every inserted block is admitted, so a one-shot scan can flush the
+// working set of point lookups out of the block cache.
+//
+// The sharded caches (LRUCache and HyperClockCache) report every Lookup miss
+// to the policy, and consult it on Insert of CacheEntryRole::kDataBlock
+// entries once the target shard is at capacity. Entries of other roles, and
+// all entries while the shard still has room, are always admitted.
+//
+// A rejected Insert() with a handle returns Status::Incomplete() and the
+// caller keeps ownership of the value; without a handle, it behaves as if
+// the entry was inserted and immediately evicted.
+class CacheAdmissionPolicy {
+ public:
+  virtual ~CacheAdmissionPolicy() {}
+
+  virtual const char* Name() const = 0;
+
+  // Records a Lookup of `key_hash` which missed in the cache. Accesses which
+  // hit are not reported, only the history of non-resident entries matters
+  // for admission. Must be thread-safe.
+  virtual void RecordMiss(uint64_t key_hash) = 0;
+
+  // Returns whether a new entry should be inserted into a full cache.
+  // Must be thread-safe.
+  virtual bool Admit(uint64_t key_hash, size_t charge) = 0;
+
+  virtual std::string GetPrintableOptions() const { return ""; }
+};
+
+// EXPERIMENTAL
+// Options for the TinyLFU admission policy, which estimates the recent
+// access frequency of cache keys with a count-min sketch of 4-bit counters,
+// and admits a data block into a full cache only if it has been accessed
+// repeatedly. All counters are halved periodically, so that the frequencies
+// reflect recent history. See https://arxiv.org/abs/1512.00727
+struct TinyLFUAdmissionOptions {
+  // Number of distinct entries the cache is expected to hold, typically the
+  // block cache capacity divided by block_size. The sketch takes 4 bytes of
+  // memory per expected entry.
+  size_t expected_entries = size_t{1} << 18;
+
+  // A data block is admitted into a full cache only if its estimated
+  // frequency, counting the miss leading to the insertion, is at least this
+  // value. The default admits a block on its second miss within an aging
+  // period. Valid values are 1 (admit everything) to 15.
+  uint32_t admission_frequency = 2;
+
+  // The counters are halved after `aging_factor * expected_entries` misses
+  // are recorded.
+  uint32_t aging_factor = 10;
+};
+
+// EXPERIMENTAL
+// Create a TinyLFU admission policy, for ShardedCacheOptions::admission_policy
+extern std::shared_ptr<CacheAdmissionPolicy> NewTinyLFUAdmissionPolicy(
+    const TinyLFUAdmissionOptions& opts = TinyLFUAdmissionOptions());
+
 // Options shared betweeen various cache implementations that
 // divide the key space into shards using hashing.
 struct ShardedCacheOptions {
@@ -147,6 +208,11 @@ struct ShardedCacheOptions {
   CacheMetadataChargePolicy metadata_charge_policy =
       kDefaultCacheMetadataChargePolicy;
 
+  // EXPERIMENTAL
+  // If non-nullptr, decides whether new data blocks are inserted into a full
+  // cache. See CacheAdmissionPolicy. Not used by CompressedSecondaryCache.
+  std::shared_ptr<CacheAdmissionPolicy> admission_policy;
+
   ShardedCacheOptions() {}
   ShardedCacheOptions(
       size_t _capacity, int _num_shard_bits, bool _strict_capacity_limit,
@@ -288,6 +354,44 @@ extern std::shared_ptr<SecondaryCache> NewCompressedSecondaryCache(
 extern std::shared_ptr<SecondaryCache> NewCompressedSecondaryCache(
     const CompressedSecondaryCacheOptions& opts);
 
+// EXPERIMENTAL
+// Options for a SecondaryCache storing blocks evicted from the primary cache
+// in a local file, typically on NVMe flash, to serve block cache misses of
+// a DB on slower (e.g. network) storage.
+//
+// The file is written as a circular log of fixed size segments. New entries
+// are appended to an in-memory segment buffer, which is written to the file
+// in the background with a single large write once full. When the log wraps
+// around, the oldest segment is reused and all entries in it are evicted, so
+// the eviction policy is FIFO. The index from keys to file locations is kept
+// in memory, so the cache content does not survive a restart.
+//
+// Lookups with wait=false are served with asynchronous reads (using io_uring
+// where the FileSystem supports it), and are completed in batches by
+// Cache::WaitAll().
+struct FileSecondaryCacheOptions {
+  // Path of the cache file, it is truncated when the cache is created.
+  std::string path;
+
+  // Maximum size of the cache file, rounded down to a multiple of
+  // segment_size. Must be at least two segments.
+  size_t capacity = 0;
+
+  // Size of the segments of the log, and of each write to the file. Entries
+  // larger than a segment are not cached. While a full segment buffer is
+  // being written, entries are dropped rather than blocking the (foreground)
+  // thread evicting them from the primary cache.
+  size_t segment_size = 16 << 20;
+
+  // FileSystem for the cache file. If nullptr, FileSystem::Default() is used.
+  std::shared_ptr<FileSystem> file_system;
+};
+
+// EXPERIMENTAL
+// Create a SecondaryCache backed by a local file.
+extern Status NewFileSecondaryCache(const FileSecondaryCacheOptions& opts,
+                                    std::shared_ptr<SecondaryCache>* result);
+
 // HyperClockCache - A lock-free Cache alternative for RocksDB block cache
 // that offers much improved CPU efficiency vs. LRUCache under high parallel
 // load or high contention, with some caveats:
@@ -497,6 +601,10 @@ class Cache {
   // If handle is nullptr, it is as if Release is called immediately after
   // insert. In case of error value will be cleanup.
   //
+  // If the cache has an admission policy which rejects the entry, returns
+  // Status::Incomplete() when handle is not nullptr, see
+  // CacheAdmissionPolicy.
+  //
   // When the inserted entry is no longer needed, the key and
   // value will be passed to "deleter" which must delete the value.
   // (The Cache is responsible for copying and reclaiming space for
@@ -104,6 +104,13 @@ struct CompactionJobStats {
   // number of single-deletes which meet something other than a put
   uint64_t num_single_del_mismatch;
 
+  // the number of subcompactions, and the largest input (raw key and value
+  // bytes) and elapsed time of one of them. Compared with the totals, they
+  // show how evenly the compaction was split.
+  uint64_t num_subcompactions;
+  uint64_t max_subcompaction_input_bytes;
+  uint64_t max_subcompaction_micros;
+
   // TODO: Add output_to_penultimate_level output information
 };
 }  // namespace ROCKSDB_NAMESPACE
@@ -1057,6 +1057,11 @@ class DB {
     //  "rocksdb.is-write-stopped" - Return 1 if write has been stopped.
     static const std::string kIsWriteStopped;
 
+    //  "rocksdb.write-controller-policy-stats" - returns a multi-line string
+    //      with the statistics of DBOptions::write_controller_policy. Not
+    //      available if no policy is set.
+    static const std::string kWriteControllerPolicyStats;
+
     //  "rocksdb.estimate-oldest-key-time" - returns an estimation of
     //      oldest key timestamp in the DB. Currently only available for
     //      FIFO compaction with
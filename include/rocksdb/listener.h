@@ -321,6 +321,23 @@ struct BlobFileGarbageInfo : public BlobFileInfo {
   uint64_t garbage_blob_bytes;
 };
 
+// An L0 file of a flush split by DBOptions::max_flush_partitions, other
+// than the one described by FlushJobInfo::file_path.
+struct FlushPartitionFileInfo {
+  // the path to the file
+  std::string file_path;
+  // the file number of the file
+  uint64_t file_number;
+  // the oldest blob file referenced by the file
+  uint64_t oldest_blob_file_number;
+  // The smallest sequence number in the file
+  SequenceNumber smallest_seqno;
+  // The largest sequence number in the file
+  SequenceNumber largest_seqno;
+  // Table properties of the file
+  TableProperties table_properties;
+};
+
 struct FlushJobInfo {
   // the id of the column family
   uint32_t cf_id;
@@ -360,6 +377,10 @@ struct FlushJobInfo {
 
   // Information about blob files created during flush in Integrated BlobDB.
   std::vector<BlobFileAdditionInfo> blob_file_addition_infos;
+
+  // When the flush was split into several L0 files, the files other than
+  // file_path. They share its epoch and cover disjoint key ranges.
+  std::vector<FlushPartitionFileInfo> partition_file_infos;
 };
 
 struct CompactionFileInfo {
@@ -245,6 +245,9 @@ class MemTableRep {
     return 0;
   }
 
+  // Whether UniqueRandomSample() is implemented
+  virtual bool SupportUniqueRandomSample() const { return false; }
+
   // Returns a vector of unique random memtable entries of approximate
   // size 'target_sample_size' (this size is not strictly enforced).
   virtual void UniqueRandomSample(const uint64_t num_entries,
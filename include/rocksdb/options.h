@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "rocksdb/advanced_options.h"
+#include "rocksdb/blob_separation_policy.h"
 #include "rocksdb/comparator.h"
 #include "rocksdb/compression_type.h"
 #include "rocksdb/customizable.h"
@@ -30,6 +31,7 @@
 #include "rocksdb/universal_compaction.h"
 #include "rocksdb/version.h"
 #include "rocksdb/write_buffer_manager.h"
+#include "rocksdb/write_controller_policy.h"
 
 #ifdef max
 #undef max
@@ -335,6 +337,17 @@ struct ColumnFamilyOptions : public AdvancedColumnFamilyOptions {
   // Default: nullptr
   std::shared_ptr<SstPartitionerFactory> sst_partitioner_factory = nullptr;
 
+  // If non-nullptr and enable_blob_files is true, flush and compaction ask
+  // this policy whether to write each value to a blob file, instead of
+  // comparing its size with min_blob_size. See
+  // NewAdaptiveBlobSeparationPolicy().
+  //
+  // The policy is not forwarded to remote compaction workers, see
+  // compaction_executor_factory, they keep using min_blob_size.
+  //
+  // Default: nullptr
+  std::shared_ptr<BlobSeparationPolicy> blob_separation_policy = nullptr;
+
   std::shared_ptr<class CompactionExecutorFactory> compaction_executor_factory;
   std::shared_ptr<class AnyPlugin> html_user_key_coder;
 
@@ -504,6 +517,17 @@ struct DBOptions {
   // Default: true
   bool flush_verify_memtable_count = true;
 
+  // A flush whose memtables hold more than target_file_size_base bytes is
+  // split into up to this many L0 files over disjoint key ranges, built
+  // concurrently by the flush thread and other threads of its Env pool
+  // (HIGH, or LOW if the flush runs there). The ranges are cut at quantiles of keys sampled from the
+  // memtables, so a large write buffer drains in about the time of one
+  // target file. Only done when the memtable representation supports
+  // sampling (the skiplist does), the memtables hold no range tombstones
+  // and user-defined timestamps are not enabled.
+  // Default 0 or 1 means one file per flush
+  uint32_t max_flush_partitions = 0;
+
   // If true, the log numbers and sizes of the synced WALs are tracked
   // in MANIFEST. During DB recovery, if a synced WAL is missing
   // from disk, or the WAL's size does not match the recorded size in
@@ -738,6 +762,69 @@ struct DBOptions {
   // max_level1_subcompactions and fall back to use max_subcompactions
   uint32_t max_level1_subcompactions = 0;
 
+  // When L0 of a level-style column family piles up to twice
+  // level0_file_num_compaction_trigger, an L0 -> base level compaction is
+  // split into up to this many subcompactions over disjoint key ranges of
+  // the base level, cut at the boundaries of its base level input files.
+  // Each of them reads the overlapping slices of all L0 input files, so L0
+  // drains in parallel without intra-L0 compaction. With a
+  // compaction_executor_factory, the split is passed to the worker as
+  // CompactionParams::max_subcompactions.
+  // Default 0 or 1 means don't split beyond max_level1_subcompactions
+  //
+  // Dynamically changeable through SetDBOptions() API.
+  uint32_t max_level0_range_splits = 0;
+
+  // For a level-style compaction from L1 or a deeper level, input files
+  // which overlap no input file of the other level are not rewritten: the
+  // ones of the start level are moved to the output level, the ones of the
+  // output level stay where they are, and the outputs are cut around them.
+  // Only done when the compaction is triggered by level size and none of its
+  // rewritten inputs has range tombstones. A compaction run by a
+  // compaction_executor_factory is only pruned if the factory supports it,
+  // the worker then only gets the rewritten inputs.
+  // Default false
+  //
+  // Dynamically changeable through SetDBOptions() API.
+  bool partial_trivial_move = false;
+
+  // If true, the background flush and compaction threads serve the column
+  // family closest to a write stall first instead of in the order in which
+  // the column families became pending. For compactions, the closeness is
+  // the larger of L0 files vs level0_slowdown_writes_trigger and pending
+  // compaction bytes vs soft_pending_compaction_bytes_limit, for flushes it
+  // is immutable memtables vs max_write_buffer_number. Atomic flushes are
+  // always served in order.
+  // Default false
+  //
+  // Dynamically changeable through SetDBOptions() API.
+  bool stall_aware_scheduling = false;
+
+  // A compaction run by a compaction_executor_factory holds its thread of
+  // the LOW (or BOTTOM) pool while it waits for the remote worker. Up to
+  // this many of such waiting compactions are not counted in
+  // max_background_compactions, and the pool is grown by as many threads,
+  // so that local compactions keep running meanwhile. A wait ends, and the
+  // added thread is removed, as soon as the executor returns, also when the
+  // compaction then falls back to a local run. The added threads are
+  // counted per Env, whose pools are shared by all DBs on it, and the pool
+  // is never shrunk below a size set by SetBackgroundThreads() meanwhile.
+  // Default 0 means remote compactions count as local ones
+  //
+  // Dynamically changeable through SetDBOptions() API.
+  int max_background_remote_compactions = 0;
+
+  // The blocks of each compressed compaction output file are built, compressed
+  // and written by a pipeline: the compaction thread emits the raw blocks,
+  // this many threads compress them, and a writer thread appends them in
+  // order together with their index and filter entries. Overrides
+  // compression_opts.parallel_threads (and bottommost_compression_opts) for
+  // compactions, including the ones run by a compaction_executor_factory.
+  // Default 0 means use the parallel_threads of the column family
+  //
+  // Dynamically changeable through SetDBOptions() API.
+  uint32_t compaction_compression_threads = 0;
+
   // NOT SUPPORTED ANYMORE: RocksDB automatically decides this based on the
   // DEPRECATED: RocksDB automatically decides this based on the
   // value of max_background_jobs. For backwards compatibility we will set
@@ -950,6 +1037,21 @@ struct DBOptions {
   // Dynamically changeable through SetDBOptions() API.
   size_t compaction_readahead_size = 0;
 
+  // If true and compaction_readahead_size is non-zero, compaction input
+  // files are read ahead asynchronously through FileSystem::ReadAsync (which
+  // is io_uring for the posix file system if it is available): each input
+  // file keeps its next compaction_readahead_size/2 bytes in flight while
+  // the blocks already read are being compacted, instead of blocking on each
+  // read-ahead.
+  //
+  // A FileSystem without ReadAsync support reads synchronously, as if this
+  // option was false. The same holds when rate_limiter is set: asynchronous
+  // reads are not charged to the RateLimiter, so rate limited compactions
+  // keep reading ahead synchronously, with each read-ahead charged.
+  //
+  // Default: false
+  bool compaction_async_readahead = false;
+
   // This is a maximum buffer size that is used by WinMmapReadableFile in
   // unbuffered disk I/O mode. We need to maintain an aligned buffer for
   // reads. We allow the buffer to grow until the specified value and then
@@ -1066,6 +1168,14 @@ struct DBOptions {
   // Dynamically changeable through SetDBOptions() API.
   uint64_t delayed_write_rate = 0;
 
+  // If set, the delayed write rate is set by this policy, within
+  // delayed_write_rate, instead of the fixed slowdown and speedup ratios.
+  // See NewCompactionThroughputWriteControllerPolicy(). It must not be shared
+  // by multiple DBs.
+  //
+  // Default: nullptr
+  std::shared_ptr<WriteControllerPolicy> write_controller_policy = nullptr;
+
   // By default, a single write thread queue is maintained. The thread gets
   // to the head of the queue becomes write batch group leader and responsible
   // for writing to WAL and memtable for the batch group.
@@ -1732,6 +1842,14 @@ struct ReadOptions {
   // Default: true
   bool optimize_multiget_for_io;
 
+  // If non-zero, iterators read a blob file ahead by this size while the
+  // blobs they read from it have increasing offsets, as in forward scans,
+  // since flush and compaction write blob files in key order. If async_io is
+  // also set, the second half of each readahead is read asynchronously.
+  //
+  // Default: 0
+  size_t blob_readahead_size = 0;
+
   int async_queue_depth = 16;
 
   // used for ToplingDB fiber MultiGet
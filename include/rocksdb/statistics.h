@@ -459,6 +459,10 @@ enum Tickers : uint32_t {
   LCOMPACT_WRITE_BYTES_RAW,
   DCOMPACT_WRITE_BYTES_RAW,
 
+  // WriteBatchWithIndex reused or created by a pooled WBWIFactory
+  WBWI_POOL_HIT,
+  WBWI_POOL_MISS,
+
   TICKER_ENUM_MAX
 };
 
@@ -602,6 +606,14 @@ enum Histograms : uint32_t {
 
   READ_ZBS_RECORD_MICROS, // toplingdb ZipTable
 
+  // Time from scheduling a background job to its start on a pool thread
+  FLUSH_QUEUE_WAIT_MICROS,
+  COMPACTION_QUEUE_WAIT_MICROS,
+  BOTTOM_COMPACTION_QUEUE_WAIT_MICROS,
+
+  // Time a pessimistic transaction waited for a key lock held by others
+  KEY_LOCK_WAIT_MICROS,
+
   HISTOGRAM_ENUM_MAX,
 };
 
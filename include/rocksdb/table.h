@@ -237,13 +237,17 @@ struct BlockBasedTableOptions {
   // The index type that will be used for the data block.
   ROCKSDB_ENUM_PLAIN_INCLASS(DataBlockIndexType, char,
     kDataBlockBinarySearch = 0,   // traditional block type
-    kDataBlockBinaryAndHash = 1  // additional hash index
+    kDataBlockBinaryAndHash = 1,  // additional hash index
+    // additional hash index with 16 bit buckets, which supports blocks larger
+    // than 64KiB and up to 65533 restart intervals, instead of 253. Blocks of
+    // this type are not readable by versions which do not know it.
+    kDataBlockBinaryAndWideHash = 2
   );
 
   DataBlockIndexType data_block_index_type = kDataBlockBinarySearch;
 
   // #entries/#buckets. It is valid only when data_block_hash_index_type is
-  // kDataBlockBinaryAndHash.
+  // kDataBlockBinaryAndHash or kDataBlockBinaryAndWideHash.
   double data_block_hash_table_util_ratio = 0.75;
 
   // Option hash_index_allow_collision is now deleted.
@@ -298,6 +302,16 @@ struct BlockBasedTableOptions {
   // Same as block_restart_interval but used for the index block.
   int index_block_restart_interval = 1;
 
+  // If true, index blocks are prefixed with a dense array of the first 8
+  // bytes of every restart key, so index seek can binary search the fixed
+  // size array and only decode full keys to break ties. It costs 8 bytes
+  // per restart point, and is ignored unless the comparator is the forward
+  // bytewise comparator without timestamp. Files written with this option
+  // remain readable by versions unaware of it.
+  //
+  // Default: false
+  bool index_restart_prefix_array = false;
+
   // Block size for partitioned metadata. Currently applied to indexes when
   // kTwoLevelIndexSearch is used and to filters when partition_filters is used.
   // Note: Since in the current implementation the filters and index partitions
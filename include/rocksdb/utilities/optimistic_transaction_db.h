@@ -41,7 +41,14 @@ ROCKSDB_ENUM_CLASS(OccValidationPolicy, int,
   // Validate parallelly before commit stage, BEFORE entering the write-group to
   // reduce mutex contention. Each txn acquires locks for its write-set
   // records in some well-defined order.
-  kValidateParallel = 1
+  kValidateParallel = 1,
+  // Validate serially in the write-group like kValidateSerial, but txns are
+  // batched into one write-group: the leader validates each txn against the
+  // db and the keys written by the txns before it in the same group, drops
+  // the conflicting ones and commits the rest with one WAL write.
+  // Falls back to kValidateSerial if enable_pipelined_write or
+  // unordered_write is set.
+  kValidateGroupCommit = 2
 );
 
 struct OptimisticTransactionDBOptions {
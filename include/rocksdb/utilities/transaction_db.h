@@ -174,6 +174,15 @@ struct TransactionDBOptions {
   // separate mutex.
   size_t num_stripes = 16;
 
+  // If true, a shared lock (GetForUpdate with exclusive=false) of a
+  // transaction without expiration is granted without the stripe mutex while
+  // no other key of its hash bucket is locked through the lock table and no
+  // exclusive lock is requested on it. A few dozen such locks are held per
+  // stripe, beyond that and on conflicts shared locks use the lock table.
+  // Deadlock detection and max_num_locks cover these locks too, but
+  // GetLockStatusData() does not report them.
+  bool lock_free_shared_locks = false;
+
   // If positive, specifies the default wait timeout in milliseconds when
   // a transaction attempts to lock a key if not specified by
   // TransactionOptions::lock_timeout.
@@ -29,6 +29,7 @@ class ColumnFamilyHandle;
 class Comparator;
 class DB;
 class ReadCallback;
+class Statistics;
 class MergeContext;
 struct ReadOptions;
 struct DBOptions;
@@ -207,6 +208,18 @@ class WriteBatchWithIndex : public WriteBatchBase {
   using WriteBatchBase::Clear;
   void Clear() override;
 
+  // topling: Clear() for reusing this object in another transaction, the
+  // comparators of column families and the limit of SetMaxBytes() are
+  // forgotten too. Up to
+  // max_retained_bytes of the index memory is kept for the next updates.
+  // Returns false, and leaves this object as is, if it can not be reused:
+  // a derived class with an index of its own must override it to support it.
+  virtual bool Recycle(size_t max_retained_bytes);
+
+  // topling: overwrite_key given to the constructor, only called if
+  // Recycle() returned true
+  virtual bool IsOverwriteKey() const;
+
   using WriteBatchBase::GetWriteBatch;
   WriteBatch* GetWriteBatch() override;
 
@@ -367,9 +380,37 @@ public:
       const Comparator* default_comparator = BytewiseComparator(),
       bool overwrite_key = false,
       size_t protection_bytes_per_key = 0) = 0;
+
+  // Called instead of deleting a WriteBatchWithIndex returned by
+  // NewWriteBatchWithIndex(), so the factory may reuse it. Deletes it by
+  // default.
+  virtual void ReleaseWriteBatchWithIndex(WriteBatchWithIndex* wbwi);
 };
 std::shared_ptr<WBWIFactory> SingleSkipListWBWIFactory();
 
+struct PooledWBWIFactoryOptions {
+  // Creates the batches, SingleSkipListWBWIFactory() if null
+  std::shared_ptr<WBWIFactory> base;
+
+  // Max number of released batches kept for each CPU core
+  size_t max_pooled_per_core = 8;
+
+  // Max bytes of index memory kept by each released batch. The WriteBatch of
+  // a released batch keeps its buffer if it is not larger than 512KB.
+  size_t max_retained_bytes = 64 << 10;
+
+  // If not null, WBWI_POOL_HIT and WBWI_POOL_MISS are recorded here
+  std::shared_ptr<Statistics> statistics;
+};
+
+// A WBWIFactory keeping the released batches in per-core pools, to hand them
+// out again to NewWriteBatchWithIndex() with the same arguments. This saves
+// allocating and freeing the batch, its index and its buffers for each
+// short transaction. Can be used as DBOptions::wbwi_factory. Batches whose
+// Recycle() returns false are not pooled, but released to the base factory.
+std::shared_ptr<WBWIFactory> NewPooledWBWIFactory(
+    const PooledWBWIFactoryOptions& opts = PooledWBWIFactoryOptions());
+
 }  // namespace ROCKSDB_NAMESPACE
 
 #endif  // !ROCKSDB_LITE
@@ -0,0 +1,94 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "rocksdb/rocksdb_namespace.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// What the DB knows about its write stall at the time a
+// WriteControllerPolicy is asked for a write rate.
+struct WriteStallFeedback {
+  uint64_t now_micros = 0;
+  // The rate currently admitted while writes are delayed, bytes per second
+  uint64_t delayed_write_rate = 0;
+  // DBOptions::delayed_write_rate, the admitted rate is never above it
+  uint64_t max_delayed_write_rate = 0;
+  // Estimated pending compaction bytes, summed over all column families
+  uint64_t pending_compaction_bytes = 0;
+  // Input bytes of all compactions finished since the DB was opened,
+  // including the ones run by a CompactionExecutorFactory
+  uint64_t compaction_bytes = 0;
+  // The part of compaction_bytes which was compacted remotely
+  uint64_t remote_compaction_bytes = 0;
+  // Writes were stopped or a column family is close to a stop condition
+  bool near_stop = false;
+};
+
+// Decides the rate at which writes are admitted while a column family is in
+// the delayed write stall condition. Without a policy, the rate is adjusted
+// by fixed ratios according to the compaction debt of one column family.
+//
+// All methods are called with the DB mutex held. A policy keeps the history
+// of one DB, so it must not be shared by multiple DBs.
+class WriteControllerPolicy {
+ public:
+  virtual ~WriteControllerPolicy() {}
+
+  virtual const char* Name() const = 0;
+
+  // Return the rate to admit, called each time the write stall conditions of
+  // a column family are recalculated and the column family needs a delay.
+  virtual uint64_t GetDelayedWriteRate(const WriteStallFeedback& fb) = 0;
+
+  // Return the rate to start from at the next delay, called when a column
+  // family leaves the delayed condition.
+  virtual uint64_t GetRecoveredWriteRate(const WriteStallFeedback& fb) = 0;
+
+  // Reported by the "rocksdb.write-controller-policy-stats" DB property and
+  // in the periodic stats dump. Called with the DB mutex held.
+  virtual std::string GetPrintableStats() const { return std::string(); }
+};
+
+struct CompactionThroughputWriteControllerOptions {
+  // The admitted rate is reconsidered at most once in this interval, with
+  // the compaction progress made in the interval.
+  uint64_t update_interval_micros = 1000000;
+
+  // Weight of the newest interval in the smoothed compaction throughput and
+  // pending bytes trend, in (0, 1]. Compactions finish in bursts, a lower
+  // weight averages them over more intervals.
+  double smoothing = 0.2;
+
+  // Bounds of the change of the admitted rate in one update, to keep a
+  // noisy measurement from making the rate oscillate.
+  double max_increase_ratio = 1.5;
+  double max_decrease_ratio = 0.5;
+
+  // Applied on top of the measured rate when writes were stopped or are
+  // close to a stop condition.
+  double near_stop_ratio = 0.6;
+};
+
+// A policy admitting the write rate which compaction can sustain. It
+// measures the compaction throughput T, local and remote, and the trend D of
+// the pending compaction bytes summed over all column families, both in
+// bytes per second. While writes are delayed, each admitted byte adds
+// (T + D) / rate bytes of compaction debt, so the rate which keeps the debt
+// stable is rate * T / (T + D).
+//
+// Until the first compaction finishes, the rate is only lowered by
+// near_stop_ratio.
+std::shared_ptr<WriteControllerPolicy>
+NewCompactionThroughputWriteControllerPolicy(
+    const CompactionThroughputWriteControllerOptions& opts =
+        CompactionThroughputWriteControllerOptions());
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -6643,6 +6643,9 @@ class DataBlockIndexTypeJni {
       case ROCKSDB_NAMESPACE::BlockBasedTableOptions::DataBlockIndexType::
           kDataBlockBinaryAndHash:
         return 0x1;
+      case ROCKSDB_NAMESPACE::BlockBasedTableOptions::DataBlockIndexType::
+          kDataBlockBinaryAndWideHash:
+        return 0x2;
       default:
         return 0x7F;  // undefined
     }
@@ -6659,6 +6662,9 @@ class DataBlockIndexTypeJni {
       case 0x1:
         return ROCKSDB_NAMESPACE::BlockBasedTableOptions::DataBlockIndexType::
             kDataBlockBinaryAndHash;
+      case 0x2:
+        return ROCKSDB_NAMESPACE::BlockBasedTableOptions::DataBlockIndexType::
+            kDataBlockBinaryAndWideHash;
       default:
         // undefined/default
         return ROCKSDB_NAMESPACE::BlockBasedTableOptions::DataBlockIndexType::
@@ -18,7 +18,13 @@ public enum DataBlockIndexType {
   /**
    * additional hash index
    */
-  kDataBlockBinaryAndHash((byte)0x1);
+  kDataBlockBinaryAndHash((byte)0x1),
+
+  /**
+   * additional hash index for blocks larger than 64KiB or with more than
+   * 253 restart intervals
+   */
+  kDataBlockBinaryAndWideHash((byte)0x2);
 
   private final byte value;
 
@@ -65,7 +65,7 @@ char* Arena::AllocateFallback(size_t bytes, bool aligned) {
     ++irregular_block_num;
     // Object is more than a quarter of our block size.  Allocate it separately
     // to avoid wasting too much space in leftover bytes.
-    return AllocateNewBlock(bytes);
+    return AllocateNewBlock(bytes, &irregular_blocks_);
   }
 
   // We waste the remaining space in the current block.
@@ -77,7 +77,13 @@ char* Arena::AllocateFallback(size_t bytes, bool aligned) {
   }
   if (!block_head) {
     size = kBlockSize;
-    block_head = AllocateNewBlock(size);
+    if (!spare_blocks_.empty()) {
+      block_head = spare_blocks_.back().get();
+      blocks_.push_back(std::move(spare_blocks_.back()));
+      spare_blocks_.pop_back();
+    } else {
+      block_head = AllocateNewBlock(size, &blocks_);
+    }
   }
   alloc_bytes_remaining_ = size - bytes;
 
@@ -142,11 +148,12 @@ char* Arena::AllocateAligned(size_t bytes, size_t huge_page_size,
   return result;
 }
 
-char* Arena::AllocateNewBlock(size_t block_bytes) {
+char* Arena::AllocateNewBlock(size_t block_bytes,
+                              std::deque<std::unique_ptr<char[]>>* blocks) {
   // NOTE: std::make_unique zero-initializes the block so is not appropriate
   // here
   char* block = new char[block_bytes];
-  blocks_.push_back(std::unique_ptr<char[]>(block));
+  blocks->push_back(std::unique_ptr<char[]>(block));
 
   size_t allocated_size;
 #ifdef ROCKSDB_MALLOC_USABLE_SIZE
@@ -167,4 +174,22 @@ char* Arena::AllocateNewBlock(size_t block_bytes) {
   return block;
 }
 
+void Arena::Reset(size_t max_retained_bytes) {
+  assert(tracker_ == nullptr);
+  size_t max_spare = max_retained_bytes / kBlockSize;
+  while (!blocks_.empty() && spare_blocks_.size() < max_spare) {
+    spare_blocks_.push_back(std::move(blocks_.back()));
+    blocks_.pop_back();
+  }
+  blocks_.clear();
+  irregular_blocks_.clear();
+  huge_blocks_.clear();
+  irregular_block_num = 0;
+  // Spare blocks are still allocated
+  blocks_memory_ = kInlineSize + spare_blocks_.size() * kBlockSize;
+  alloc_bytes_remaining_ = sizeof(inline_block_);
+  aligned_alloc_ptr_ = inline_block_;
+  unaligned_alloc_ptr_ = inline_block_ + alloc_bytes_remaining_;
+}
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -15,6 +15,8 @@
 
 #include <cstddef>
 #include <deque>
+#include <memory>
+#include <vector>
 
 #include "memory/allocator.h"
 #include "port/mmap.h"
@@ -64,8 +66,9 @@ class Arena : public Allocator {
   // by the arena (exclude the space allocated but not yet used for future
   // allocations).
   size_t ApproximateMemoryUsage() const {
-    return blocks_memory_ + blocks_.size() * sizeof(char*) -
-           alloc_bytes_remaining_;
+    return blocks_memory_ +
+           (blocks_.size() + irregular_blocks_.size()) * sizeof(char*) -
+           alloc_bytes_remaining_ - spare_blocks_.size() * kBlockSize;
   }
 
   size_t MemoryAllocatedBytes() const { return blocks_memory_; }
@@ -79,9 +82,15 @@ class Arena : public Allocator {
   size_t BlockSize() const override { return kBlockSize; }
 
   bool IsInInlineBlock() const {
-    return blocks_.empty() && huge_blocks_.empty();
+    return blocks_.empty() && irregular_blocks_.empty() &&
+           huge_blocks_.empty();
   }
 
+  // Make all the memory unused again, for reusing the arena. Up to
+  // max_retained_bytes of the regular blocks are kept for the following
+  // allocations, the other blocks are freed. Not supported with a tracker.
+  void Reset(size_t max_retained_bytes);
+
   // check and adjust the block_size so that the return value is
   //  1. in the range of [kMinBlockSize, kMaxBlockSize].
   //  2. the multiple of align unit.
@@ -91,8 +100,12 @@ class Arena : public Allocator {
   alignas(std::max_align_t) char inline_block_[kInlineSize];
   // Number of bytes allocated in one block
   const size_t kBlockSize;
-  // Allocated memory blocks
+  // Allocated memory blocks of kBlockSize
   std::deque<std::unique_ptr<char[]>> blocks_;
+  // Blocks for allocations larger than kBlockSize / 4
+  std::deque<std::unique_ptr<char[]>> irregular_blocks_;
+  // Blocks of kBlockSize kept by Reset(), used before allocating new ones
+  std::vector<std::unique_ptr<char[]>> spare_blocks_;
   // Huge page allocations
   std::deque<MemMapping> huge_blocks_;
   size_t irregular_block_num = 0;
@@ -111,7 +124,8 @@ class Arena : public Allocator {
 
   char* AllocateFromHugePage(size_t bytes);
   char* AllocateFallback(size_t bytes, bool aligned);
-  char* AllocateNewBlock(size_t block_bytes);
+  char* AllocateNewBlock(size_t block_bytes,
+                         std::deque<std::unique_ptr<char[]>>* blocks);
 
   // Bytes of memory in blocks allocated so far
   size_t blocks_memory_ = 0;
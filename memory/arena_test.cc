@@ -9,6 +9,9 @@
 
 #include "memory/arena.h"
 
+#include <algorithm>
+#include <vector>
+
 #ifndef OS_WIN
 #include <sys/resource.h>
 #endif
@@ -202,6 +205,38 @@ TEST_F(ArenaTest, Simple) {
   SimpleTest(kHugePageSize);
 }
 
+TEST_F(ArenaTest, Reset) {
+  const size_t kBlockSize = 4096;
+  const size_t kEntrySize = kBlockSize / 8;
+  Arena arena(kBlockSize);
+  std::vector<char*> allocated;
+  for (int i = 0; i < 40; i++) {
+    allocated.push_back(arena.Allocate(kEntrySize));
+  }
+  arena.Allocate(kBlockSize);  // irregular
+  ASSERT_FALSE(arena.IsInInlineBlock());
+
+  arena.Reset(3 * kBlockSize);
+  ASSERT_TRUE(arena.IsInInlineBlock());
+  ASSERT_EQ(arena.MemoryAllocatedBytes(), Arena::kInlineSize + 3 * kBlockSize);
+  ASSERT_EQ(arena.IrregularBlockNum(), 0u);
+
+  // The retained blocks are reused before allocating new ones
+  arena.Allocate(Arena::kInlineSize);
+  for (int i = 0; i < 3; i++) {
+    char* p = arena.Allocate(kEntrySize);
+    ASSERT_NE(std::find(allocated.begin(), allocated.end(), p),
+              allocated.end());
+    for (size_t j = 1; j < kBlockSize / kEntrySize; j++) {
+      arena.Allocate(kEntrySize);
+    }
+  }
+  ASSERT_EQ(arena.MemoryAllocatedBytes(), Arena::kInlineSize + 3 * kBlockSize);
+
+  arena.Reset(0);
+  ASSERT_EQ(arena.MemoryAllocatedBytes(), Arena::kInlineSize);
+}
+
 // Number of minor page faults since last call
 size_t PopMinorPageFaultCount() {
 #ifdef RUSAGE_SELF
@@ -239,6 +239,8 @@ const std::vector<std::pair<Tickers, std::string>> TickersNameMap = {
     {ASYNC_READ_ERROR_COUNT, "rocksdb.async.read.error.count"},
     {LCOMPACT_WRITE_BYTES_RAW, "rocksdb.lcompact.write.bytes.raw"},
     {DCOMPACT_WRITE_BYTES_RAW, "rocksdb.dcompact.write.bytes.raw"},
+    {WBWI_POOL_HIT, "rocksdb.wbwi.pool.hit"},
+    {WBWI_POOL_MISS, "rocksdb.wbwi.pool.miss"},
 };
 
 const std::vector<std::pair<Histograms, std::string>> HistogramsNameMap = {
@@ -321,6 +323,12 @@ const std::vector<std::pair<Histograms, std::string>> HistogramsNameMap = {
     {HISTOGRAM_COND_WAIT_NANOS, "rocksdb.cond.wait.nanos"},
 
     {READ_ZBS_RECORD_MICROS, "rocksdb.read.zbs.record.micros"},
+
+    {FLUSH_QUEUE_WAIT_MICROS, "rocksdb.flush.queue.wait.micros"},
+    {COMPACTION_QUEUE_WAIT_MICROS, "rocksdb.compaction.queue.wait.micros"},
+    {BOTTOM_COMPACTION_QUEUE_WAIT_MICROS,
+     "rocksdb.bottom.compaction.queue.wait.micros"},
+    {KEY_LOCK_WAIT_MICROS, "rocksdb.key.lock.wait.micros"},
 };
 
 std::shared_ptr<Statistics> CreateDBStatistics() {
@@ -275,6 +275,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
                    ignore_max_compaction_bytes_for_input),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"level0_tiered_write_rate",
+         {offsetof(struct MutableCFOptions, level0_tiered_write_rate),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
         {"expanded_compaction_factor",
          {0, OptionType::kInt, OptionVerificationType::kDeprecated,
           OptionTypeFlags::kMutable}},
@@ -921,6 +925,7 @@ ImmutableCFOptions::ImmutableCFOptions(const ColumnFamilyOptions& cf_options)
       compaction_executor_factory(cf_options.compaction_executor_factory),
       html_user_key_coder(cf_options.html_user_key_coder),
       sst_partitioner_factory(cf_options.sst_partitioner_factory),
+      blob_separation_policy(cf_options.blob_separation_policy),
       blob_cache(cf_options.blob_cache) {}
 
 ImmutableOptions::ImmutableOptions() : ImmutableOptions(Options()) {}
@@ -1043,6 +1048,8 @@ void MutableCFOptions::Dump(Logger* log) const {
                  max_compaction_bytes);
   ROCKS_LOG_INFO(log, "    ignore_max_compaction_bytes_for_input: %s",
                  ignore_max_compaction_bytes_for_input ? "true" : "false");
+  ROCKS_LOG_INFO(log, "                 level0_tiered_write_rate: %" PRIu64,
+                 level0_tiered_write_rate);
   ROCKS_LOG_INFO(log, "                    target_file_size_base: %" PRIu64,
                  target_file_size_base);
   ROCKS_LOG_INFO(log, "              target_file_size_multiplier: %d",
@@ -88,6 +88,8 @@ struct ImmutableCFOptions {
 
   std::shared_ptr<SstPartitionerFactory> sst_partitioner_factory;
 
+  std::shared_ptr<BlobSeparationPolicy> blob_separation_policy;
+
   std::shared_ptr<Cache> blob_cache;
 };
 
@@ -135,6 +137,7 @@ struct MutableCFOptions {
         max_compaction_bytes(options.max_compaction_bytes),
         ignore_max_compaction_bytes_for_input(
             options.ignore_max_compaction_bytes_for_input),
+        level0_tiered_write_rate(options.level0_tiered_write_rate),
         target_file_size_base(options.target_file_size_base),
         target_file_size_multiplier(options.target_file_size_multiplier),
         max_bytes_for_level_base(options.max_bytes_for_level_base),
@@ -198,6 +201,7 @@ struct MutableCFOptions {
         level0_stop_writes_trigger(0),
         max_compaction_bytes(0),
         ignore_max_compaction_bytes_for_input(true),
+        level0_tiered_write_rate(0),
         target_file_size_base(0),
         target_file_size_multiplier(0),
         max_bytes_for_level_base(0),
@@ -280,6 +284,7 @@ struct MutableCFOptions {
   int level0_stop_writes_trigger;
   uint64_t max_compaction_bytes;
   bool ignore_max_compaction_bytes_for_input;
+  uint64_t level0_tiered_write_rate;
   uint64_t target_file_size_base;
   int target_file_size_multiplier;
   uint64_t max_bytes_for_level_base;
@@ -78,6 +78,26 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct MutableDBOptions, max_level1_subcompactions),
           OptionType::kUInt32T, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"max_level0_range_splits",
+         {offsetof(struct MutableDBOptions, max_level0_range_splits),
+          OptionType::kUInt32T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+        {"partial_trivial_move",
+         {offsetof(struct MutableDBOptions, partial_trivial_move),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+        {"stall_aware_scheduling",
+         {offsetof(struct MutableDBOptions, stall_aware_scheduling),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+        {"max_background_remote_compactions",
+         {offsetof(struct MutableDBOptions, max_background_remote_compactions),
+          OptionType::kInt, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+        {"compaction_compression_threads",
+         {offsetof(struct MutableDBOptions, compaction_compression_threads),
+          OptionType::kUInt32T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
         {"avoid_flush_during_shutdown",
          {offsetof(struct MutableDBOptions, avoid_flush_during_shutdown),
           OptionType::kBoolean, OptionVerificationType::kNormal,
@@ -227,6 +247,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableDBOptions, flush_verify_memtable_count),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"max_flush_partitions",
+         {offsetof(struct ImmutableDBOptions, max_flush_partitions),
+          OptionType::kUInt32T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"track_and_verify_wals_in_manifest",
          {offsetof(struct ImmutableDBOptions,
                    track_and_verify_wals_in_manifest),
@@ -358,6 +382,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
              offsetof(struct ImmutableDBOptions,
                       access_hint_on_compaction_start),
              &access_hint_string_map)},
+        {"compaction_async_readahead",
+         {offsetof(struct ImmutableDBOptions, compaction_async_readahead),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"info_log_level",
          OptionTypeInfo::Enum<InfoLogLevel>(
              offsetof(struct ImmutableDBOptions, info_log_level),
@@ -685,6 +713,7 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       error_if_exists(options.error_if_exists),
       paranoid_checks(options.paranoid_checks),
       flush_verify_memtable_count(options.flush_verify_memtable_count),
+      max_flush_partitions(options.max_flush_partitions),
       track_and_verify_wals_in_manifest(
           options.track_and_verify_wals_in_manifest),
       verify_sst_unique_id_in_manifest(
@@ -722,7 +751,9 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       advise_random_on_open(options.advise_random_on_open),
       db_write_buffer_size(options.db_write_buffer_size),
       write_buffer_manager(options.write_buffer_manager),
+      write_controller_policy(options.write_controller_policy),
       access_hint_on_compaction_start(options.access_hint_on_compaction_start),
+      compaction_async_readahead(options.compaction_async_readahead),
       random_access_max_buffer_size(options.random_access_max_buffer_size),
       use_adaptive_mutex(options.use_adaptive_mutex),
       listeners(options.listeners),
@@ -780,6 +811,9 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    paranoid_checks);
   ROCKS_LOG_HEADER(log, "            Options.flush_verify_memtable_count: %d",
                    flush_verify_memtable_count);
+  ROCKS_LOG_HEADER(log,
+                   "                   Options.max_flush_partitions: %" PRIu32,
+                   max_flush_partitions);
   ROCKS_LOG_HEADER(log,
                    "                              "
                    "Options.track_and_verify_wals_in_manifest: %d",
@@ -855,8 +889,13 @@ void ImmutableDBOptions::Dump(Logger* log) const {
       db_write_buffer_size);
   ROCKS_LOG_HEADER(log, "                   Options.write_buffer_manager: %p",
                    write_buffer_manager.get());
+  ROCKS_LOG_HEADER(log, "                Options.write_controller_policy: %s",
+                   write_controller_policy ? write_controller_policy->Name()
+                                           : "None");
   ROCKS_LOG_HEADER(log, "        Options.access_hint_on_compaction_start: %d",
                    static_cast<int>(access_hint_on_compaction_start));
+  ROCKS_LOG_HEADER(log, "             Options.compaction_async_readahead: %d",
+                   compaction_async_readahead);
   ROCKS_LOG_HEADER(
       log, "          Options.random_access_max_buffer_size: %" ROCKSDB_PRIszt,
       random_access_max_buffer_size);
@@ -978,6 +1017,11 @@ MutableDBOptions::MutableDBOptions()
       max_background_compactions(-1),
       max_subcompactions(0),
       max_level1_subcompactions(0),
+      max_level0_range_splits(0),
+      partial_trivial_move(false),
+      stall_aware_scheduling(false),
+      max_background_remote_compactions(0),
+      compaction_compression_threads(0),
       avoid_flush_during_shutdown(false),
       writable_file_max_buffer_size(1024 * 1024),
       delayed_write_rate(2 * 1024U * 1024U),
@@ -998,6 +1042,12 @@ MutableDBOptions::MutableDBOptions(const DBOptions& options)
       max_background_compactions(options.max_background_compactions),
       max_subcompactions(options.max_subcompactions),
       max_level1_subcompactions(options.max_level1_subcompactions),
+      max_level0_range_splits(options.max_level0_range_splits),
+      partial_trivial_move(options.partial_trivial_move),
+      stall_aware_scheduling(options.stall_aware_scheduling),
+      max_background_remote_compactions(
+          options.max_background_remote_compactions),
+      compaction_compression_threads(options.compaction_compression_threads),
       avoid_flush_during_shutdown(options.avoid_flush_during_shutdown),
       writable_file_max_buffer_size(options.writable_file_max_buffer_size),
       delayed_write_rate(options.delayed_write_rate),
@@ -1025,6 +1075,18 @@ void MutableDBOptions::Dump(Logger* log) const {
   ROCKS_LOG_HEADER(
       log, "            Options.max_level1_subcompactions: %" PRIu32,
       max_level1_subcompactions);
+  ROCKS_LOG_HEADER(log, "            Options.max_level0_range_splits: %" PRIu32,
+                   max_level0_range_splits);
+  ROCKS_LOG_HEADER(log, "            Options.partial_trivial_move: %d",
+                   partial_trivial_move);
+  ROCKS_LOG_HEADER(log, "            Options.stall_aware_scheduling: %d",
+                   stall_aware_scheduling);
+  ROCKS_LOG_HEADER(log,
+                   "            Options.max_background_remote_compactions: %d",
+                   max_background_remote_compactions);
+  ROCKS_LOG_HEADER(
+      log, "            Options.compaction_compression_threads: %" PRIu32,
+      compaction_compression_threads);
   ROCKS_LOG_HEADER(log, "            Options.avoid_flush_during_shutdown: %d",
                    avoid_flush_during_shutdown);
   ROCKS_LOG_HEADER(
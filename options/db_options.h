@@ -25,6 +25,7 @@ struct ImmutableDBOptions {
   bool error_if_exists;
   bool paranoid_checks;
   bool flush_verify_memtable_count;
+  uint32_t max_flush_partitions;
   bool track_and_verify_wals_in_manifest;
   bool verify_sst_unique_id_in_manifest;
   Env* env;
@@ -61,7 +62,9 @@ struct ImmutableDBOptions {
   bool advise_random_on_open;
   size_t db_write_buffer_size;
   std::shared_ptr<WriteBufferManager> write_buffer_manager;
+  std::shared_ptr<WriteControllerPolicy> write_controller_policy;
   DBOptions::AccessHint access_hint_on_compaction_start;
+  bool compaction_async_readahead;
   size_t random_access_max_buffer_size;
   bool use_adaptive_mutex;
   std::vector<std::shared_ptr<EventListener>> listeners;
@@ -125,6 +128,11 @@ struct MutableDBOptions {
   int max_background_compactions;
   uint32_t max_subcompactions;
   uint32_t max_level1_subcompactions;
+  uint32_t max_level0_range_splits;
+  bool partial_trivial_move;
+  bool stall_aware_scheduling;
+  int max_background_remote_compactions;
+  uint32_t compaction_compression_threads;
   bool avoid_flush_during_shutdown;
   size_t writable_file_max_buffer_size;
   uint64_t delayed_write_rate;
@@ -75,6 +75,7 @@ AdvancedColumnFamilyOptions::AdvancedColumnFamilyOptions(const Options& options)
       max_compaction_bytes(options.max_compaction_bytes),
       ignore_max_compaction_bytes_for_input(
           options.ignore_max_compaction_bytes_for_input),
+      level0_tiered_write_rate(options.level0_tiered_write_rate),
       soft_pending_compaction_bytes_limit(
           options.soft_pending_compaction_bytes_limit),
       hard_pending_compaction_bytes_limit(
@@ -296,6 +297,9 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
         max_compaction_bytes);
     ROCKS_LOG_HEADER(log, "  Options.ignore_max_compaction_bytes_for_input: %s",
                      ignore_max_compaction_bytes_for_input ? "true" : "false");
+    ROCKS_LOG_HEADER(
+        log, "               Options.level0_tiered_write_rate: %" PRIu64,
+        level0_tiered_write_rate);
     ROCKS_LOG_HEADER(
         log,
         "                       Options.arena_block_size: %" ROCKSDB_PRIszt,
@@ -442,6 +446,9 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
         blob_compaction_readahead_size);
     ROCKS_LOG_HEADER(log, "               Options.blob_file_starting_level: %d",
                      blob_file_starting_level);
+    ROCKS_LOG_HEADER(log, "                 Options.blob_separation_policy: %s",
+                     blob_separation_policy ? blob_separation_policy->Name()
+                                            : "None");
     if (blob_cache) {
       ROCKS_LOG_HEADER(log, "                          Options.blob_cache: %s",
                        blob_cache->Name());
@@ -192,6 +192,7 @@ TEST_F(OptionsSettableTest, BlockBasedTableOptionsAllFieldsSettable) {
       "partition_filters=false;"
       "optimize_filters_for_memory=true;"
       "index_block_restart_interval=4;"
+      "index_restart_prefix_array=true;"
       "filter_policy=bloomfilter:4:true;whole_key_filtering=1;detect_filter_"
       "construct_corruption=false;"
       "format_version=1;"
@@ -244,6 +245,8 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
        sizeof(std::shared_ptr<WriteBufferManager>)},
       {offsetof(struct DBOptions, listeners),
        sizeof(std::vector<std::shared_ptr<EventListener>>)},
+      {offsetof(struct DBOptions, write_controller_policy),
+       sizeof(std::shared_ptr<WriteControllerPolicy>)},
       {offsetof(struct DBOptions, row_cache), sizeof(std::shared_ptr<Cache>)},
       {offsetof(struct DBOptions, wal_filter), sizeof(const WalFilter*)},
       {offsetof(struct DBOptions, file_checksum_gen_factory),
@@ -293,6 +296,11 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
                              "db_write_buffer_size=2587;"
                              "max_subcompactions=64330;"
                              "max_level1_subcompactions=64330;"
+                             "max_level0_range_splits=64330;"
+                             "partial_trivial_move=true;"
+                             "stall_aware_scheduling=true;"
+                             "max_background_remote_compactions=4;"
+                             "compaction_compression_threads=4;"
                              "table_cache_numshardbits=28;"
                              "max_open_files=72;"
                              "max_file_opening_threads=35;"
@@ -310,6 +318,7 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
                              "writable_file_max_buffer_size=1048576;"
                              "paranoid_checks=true;"
                              "flush_verify_memtable_count=true;"
+                             "max_flush_partitions=4;"
                              "track_and_verify_wals_in_manifest=true;"
                              "verify_sst_unique_id_in_manifest=true;"
                              "is_fd_close_on_exec=false;"
@@ -345,6 +354,7 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
                              "write_thread_slow_yield_usec=5;"
                              "write_thread_max_yield_usec=1000;"
                              "access_hint_on_compaction_start=NONE;"
+                             "compaction_async_readahead=true;"
                              "info_log_level=DEBUG_LEVEL;"
                              "dump_malloc_stats=false;"
                              "allow_2pc=false;"
@@ -432,6 +442,8 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
        sizeof(std::shared_ptr<ConcurrentTaskLimiter>)},
       {offsetof(struct ColumnFamilyOptions, sst_partitioner_factory),
        sizeof(std::shared_ptr<SstPartitionerFactory>)},
+      {offsetof(struct ColumnFamilyOptions, blob_separation_policy),
+       sizeof(std::shared_ptr<BlobSeparationPolicy>)},
       {offsetof(struct ColumnFamilyOptions, compaction_executor_factory),
        sizeof(std::shared_ptr<class CompactionExecutorFactory>)},
       {offsetof(struct ColumnFamilyOptions, html_user_key_coder),
@@ -467,6 +479,7 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
   options->num_levels = 42;  // Initialize options for MutableCF
   options->compaction_filter = nullptr;
   options->sst_partitioner_factory = nullptr;
+  options->blob_separation_policy = nullptr;
   options->compaction_executor_factory = nullptr; // ToplingDB specific
   options->html_user_key_coder = nullptr; // ToplingDB specific
 
@@ -499,6 +512,7 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
       "write_buffer_size=1653;"
       "max_compaction_bytes=64;"
       "ignore_max_compaction_bytes_for_input=true;"
+      "level0_tiered_write_rate=1048576;"
       "max_bytes_for_level_multiplier=60;"
       "memtable_factory=SkipListFactory;"
       "compression=kNoCompression;"
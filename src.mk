@@ -13,14 +13,17 @@ LIB_SOURCES =                                                   \
   sideplugin/rockside/src/topling/web/CivetServer.cc            \
   cache/cache.cc                                                \
   cache/cache_entry_roles.cc                                    \
+  cache/cache_helpers.cc                                        \
   cache/cache_key.cc                                            \
   cache/cache_reservation_manager.cc                            \
   cache/charged_cache.cc                                        \
   cache/clock_cache.cc                                          \
   cache/lru_cache.cc                                            \
   cache/compressed_secondary_cache.cc                           \
+  cache/file_secondary_cache.cc                                 \
   cache/secondary_cache.cc                                      \
   cache/sharded_cache.cc                                        \
+  cache/tiny_lfu.cc                                             \
   db/arena_wrapped_db_iter.cc                                   \
   db/blob/blob_contents.cc                                      \
   db/blob/blob_fetcher.cc                                       \
@@ -34,6 +37,7 @@ LIB_SOURCES =                                                   \
   db/blob/blob_log_format.cc                                    \
   db/blob/blob_log_sequential_reader.cc                         \
   db/blob/blob_log_writer.cc                                    \
+  db/blob/blob_separation_policy.cc                             \
   db/blob/blob_source.cc                                        \
   db/blob/prefetch_buffer_collection.cc                         \
   db/builder.cc                                                 \
@@ -430,6 +434,7 @@ BENCH_MAIN_SOURCES =                                                    \
   tools/db_bench.cc                                                     \
   util/filter_bench.cc                                                  \
   utilities/persistent_cache/persistent_cache_bench.cc                  \
+  utilities/transactions/lock/point/point_lock_manager_bench.cc         \
   #util/log_write_bench.cc                                               \
 
 TEST_MAIN_SOURCES =                                                     \
@@ -437,6 +442,7 @@ TEST_MAIN_SOURCES =                                                     \
   cache/cache_reservation_manager_test.cc                               \
   cache/lru_cache_test.cc                                               \
   cache/compressed_secondary_cache_test.cc                              \
+  cache/file_secondary_cache_test.cc                                    \
   db/blob/blob_counting_iterator_test.cc                                \
   db/blob/blob_file_addition_test.cc                                    \
   db/blob/blob_file_builder_test.cc                                     \
@@ -327,19 +327,67 @@ void MetaBlockIter::SeekImpl(const Slice& target) {
 //    than the seek_user_key, or the block ends with a matching user_key but
 //    with a smaller [ type | seqno ] (i.e. a larger seqno, or the same seqno
 //    but larger type).
+// SeekForPrev() by the hash index, for the case the user key of `target`
+// exists in this block. All entries of a user key are in the same restart
+// interval when its hash bucket is neither kNoEntry nor kCollision, so a
+// linear seek inside that interval positions the iter at the first key
+// >= target, and the entry before it (if not an exact match) is the result.
+//
+// Returns false if the user key is not found, the iter location is undefined
+// then and the caller should fall back to the binary search.
+bool DataBlockIter::SeekForPrevByHashIndex(const Slice& target) {
+  if (icmp_->user_comparator()->timestamp_size() != 0) {
+    return false;
+  }
+  Slice target_user_key = ExtractUserKey(target);
+  uint32_t map_offset = restarts_ + num_restarts_ * sizeof(uint32_t);
+  uint32_t restart_index = data_block_hash_index_->LookupRestartIndex(
+      data_, map_offset, target_user_key);
+  if (restart_index >= num_restarts_) {
+    // kNoEntry or kCollision
+    return false;
+  }
+
+  SeekToRestartPoint(restart_index);
+  current_ = GetRestartPoint(restart_index);
+  uint32_t limit = restarts_;
+  if (restart_index + 1 < num_restarts_) {
+    limit = GetRestartPoint(restart_index + 1);
+  }
+  while (current_ < limit) {
+    bool shared;
+    if (!ParseNextDataKey(&shared) || CompareCurrentKey(target) >= 0) {
+      break;
+    }
+  }
+  if (!Valid() ||
+      icmp_->user_comparator()->Compare(raw_key_.GetUserKey(),
+                                        target_user_key) != 0 ||
+      CompareCurrentKey(target) < 0) {
+    // Hash index false positive, or every entry of the user key is less than
+    // `target`, the result is not known to be in this restart interval.
+    return false;
+  }
+  if (CompareCurrentKey(target) > 0) {
+    PrevImpl();
+  }
+  TEST_SYNC_POINT("DataBlockIter::SeekForPrevByHashIndex:Hit");
+  return true;
+}
+
 bool DataBlockIter::SeekForGetImpl(const Slice& target) {
   Slice target_user_key = ExtractUserKey(target);
   uint32_t map_offset = restarts_ + num_restarts_ * sizeof(uint32_t);
-  uint8_t entry =
-      data_block_hash_index_->Lookup(data_, map_offset, target_user_key);
+  uint32_t entry = data_block_hash_index_->LookupRestartIndex(
+      data_, map_offset, target_user_key);
 
-  if (entry == kCollision) {
+  if (entry == kWideCollision) {
     // HashSeek not effective, falling back
     SeekImpl(target);
     return true;
   }
 
-  if (entry == kNoEntry) {
+  if (entry == kWideNoEntry) {
     // Even if we cannot find the user_key in this block, the result may
     // exist in the next block. Consider this example:
     //
@@ -355,7 +403,7 @@ bool DataBlockIter::SeekForGetImpl(const Slice& target) {
     // The while-loop below will search the last restart interval for the
     // key. It will stop at the first key that is larger than the seek_key,
     // or to the end of the block if no one is larger.
-    entry = static_cast<uint8_t>(num_restarts_ - 1);
+    entry = num_restarts_ - 1;
   }
 
   uint32_t restart_index = entry;
@@ -450,10 +498,29 @@ void IndexBlockIter::SeekImpl(const Slice& target) {
     // restart interval must be one when hash search is enabled so the binary
     // search simply lands at the right place.
     skip_linear_scan = true;
-  } else if (value_delta_encoded_) {
-    ok = BinarySeek<DecodeKeyV4>(seek_key, &index, &skip_linear_scan);
   } else {
-    ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
+    uint32_t begin = 0;
+    uint32_t end = num_restarts_;
+    if (restart_prefixes_) {
+      // Only restarts whose key prefix equals the target's need a full key
+      // comparison, all others are ordered by the prefix array alone.
+      uint64_t target_prefix = RestartKeyPrefix(ExtractUserKey(target));
+      begin = RestartPrefixBound(restart_prefixes_, num_restarts_,
+                                 target_prefix, false /* upper_bound */);
+      if (begin < num_restarts_) {
+        end = begin + RestartPrefixBound(
+                          restart_prefixes_ + begin * kRestartPrefixSize,
+                          num_restarts_ - begin, target_prefix,
+                          true /* upper_bound */);
+      }
+    }
+    if (value_delta_encoded_) {
+      ok = BinarySeek<DecodeKeyV4>(seek_key, &index, &skip_linear_scan, begin,
+                                   end);
+    } else {
+      ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan, begin,
+                                 end);
+    }
   }
 
   if (!ok) {
@@ -468,6 +535,9 @@ void DataBlockIter::SeekForPrevImpl(const Slice& target) {
   if (data_ == nullptr) {  // Not init yet
     return;
   }
+  if (data_block_hash_index_ && SeekForPrevByHashIndex(target)) {
+    return;
+  }
   uint32_t index = 0;
   bool skip_linear_scan = false;
   bool ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
@@ -751,7 +821,8 @@ void BlockIter<TValue>::FindKeyAfterBinarySeek(const Slice& target,
 template <class TValue>
 template <typename DecodeKeyFunc>
 bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
-                                   bool* skip_linear_scan) {
+                                   bool* skip_linear_scan, uint32_t begin,
+                                   uint32_t end) {
   if (restarts_ == 0) {
     // SST files dedicated to range tombstones are written with index blocks
     // that have no keys while also having `num_restarts_ == 1`. This would
@@ -769,7 +840,9 @@ bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
   //   keys.
   // - Any restart keys after index `right` are strictly greater than the target
   //   key.
-  int64_t left = -1, right = num_restarts_ - 1;
+  assert(begin <= end);
+  int64_t left = int64_t(begin) - 1;
+  int64_t right = int64_t(std::min(end, num_restarts_)) - 1;
   while (left != right) {
     // The `mid` is computed by rounding up so it lands in (`left`, `right`].
     int64_t mid = left + (right - left + 1) / 2;
@@ -941,7 +1014,8 @@ uint32_t Block::NumRestarts() const {
   assert(size_ >= 2 * sizeof(uint32_t));
   uint32_t block_footer = DecodeFixed32(data_ + size_ - sizeof(uint32_t));
   uint32_t num_restarts = block_footer;
-  if (size_ > kMaxBlockSizeSupportedByHashIndex) {
+  if (size_ > kMaxBlockSizeSupportedByHashIndex &&
+      !IsWideHashIndexFooter(block_footer)) {
     // In BlockBuilder, we have ensured a block with HashIndex is less than
     // kMaxBlockSizeSupportedByHashIndex (64KiB).
     //
@@ -952,6 +1026,9 @@ uint32_t Block::NumRestarts() const {
     // Such check is for backward compatibility. We can ensure legacy block
     // with a vary large num_restarts i.e. >= 0x80000000 can be interpreted
     // correctly as no HashIndex even if the MSB of num_restarts is set.
+    //
+    // The wide HashIndex, which has no block size limit, sets both of the two
+    // MSBs, which requires num_restarts >= 0xC0000000 for a legacy block.
     return num_restarts;
   }
   BlockBasedTableOptions::DataBlockIndexType index_type;
@@ -961,11 +1038,12 @@ uint32_t Block::NumRestarts() const {
 
 BlockBasedTableOptions::DataBlockIndexType Block::IndexType() const {
   assert(size_ >= 2 * sizeof(uint32_t));
-  if (size_ > kMaxBlockSizeSupportedByHashIndex) {
+  uint32_t block_footer = DecodeFixed32(data_ + size_ - sizeof(uint32_t));
+  if (size_ > kMaxBlockSizeSupportedByHashIndex &&
+      !IsWideHashIndexFooter(block_footer)) {
     // The check is for the same reason as that in NumRestarts()
     return BlockBasedTableOptions::kDataBlockBinarySearch;
   }
-  uint32_t block_footer = DecodeFixed32(data_ + size_ - sizeof(uint32_t));
   uint32_t num_restarts = block_footer;
   BlockBasedTableOptions::DataBlockIndexType index_type;
   UnPackIndexTypeAndNumRestarts(block_footer, &index_type, &num_restarts);
@@ -1025,6 +1103,20 @@ Block::Block(BlockContents&& contents, size_t read_amp_bytes_per_bit,
           break;
         }
         break;
+      case BlockBasedTableOptions::kDataBlockBinaryAndWideHash: {
+        uint32_t wide_map_offset;
+        data_block_hash_index_.InitializeWide(
+            data_, static_cast<uint32_t>(size_ - sizeof(uint32_t)),
+            &wide_map_offset);
+        restart_offset_ = wide_map_offset - num_restarts_ * sizeof(uint32_t);
+        if (!data_block_hash_index_.Valid() ||
+            restart_offset_ > wide_map_offset) {
+          // Corrupted hash index, or wide_map_offset is too small for
+          // NumRestarts() and therefore restart_offset_ wrapped around.
+          size_ = 0;
+        }
+        break;
+      }
       default:
         size_ = 0;  // Error marker
     }
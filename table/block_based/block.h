@@ -22,6 +22,7 @@
 #include "rocksdb/table.h"
 #include "table/block_based/block_prefix_index.h"
 #include "table/block_based/data_block_hash_index.h"
+#include "table/block_based/index_restart_prefix.h"
 #include "table/format.h"
 #include "table/internal_iterator.h"
 #include "test_util/sync_point.h"
@@ -478,9 +479,13 @@ class BlockIter : public InternalIteratorBase<TValue> {
   void CorruptionError();
 
  protected:
+  // Restart keys in [0, begin) are known to be less than `target` and
+  // restart keys in [end, num_restarts_) are known to be greater than it, so
+  // only keys in [begin, end) need to be decoded and compared.
   template <typename DecodeKeyFunc>
   inline bool BinarySeek(const Slice& target, uint32_t* index,
-                         bool* is_index_key_result);
+                         bool* is_index_key_result, uint32_t begin = 0,
+                         uint32_t end = UINT32_MAX);
 
   void FindKeyAfterBinarySeek(const Slice& target, uint32_t index,
                               bool is_index_key_result);
@@ -584,6 +589,7 @@ class DataBlockIter final : public BlockIter<Slice> {
   DataBlockHashIndex* data_block_hash_index_;
 
   bool SeekForGetImpl(const Slice& target);
+  bool SeekForPrevByHashIndex(const Slice& target);
 };
 
 // Iterator over MetaBlocks.  MetaBlocks are similar to Data Blocks and
@@ -634,6 +640,12 @@ class IndexBlockIter final : public BlockIter<IndexValue> {
                    kDisableGlobalSequenceNumber, block_contents_pinned);
     raw_key_.SetIsUserKey(!key_includes_seq);
     prefix_index_ = prefix_index;
+    if (GetRestartPoint(0) == num_restarts * kRestartPrefixSize &&
+        raw_ucmp->IsForwardBytewise() && raw_ucmp->timestamp_size() == 0) {
+      restart_prefixes_ = data;
+    } else {
+      restart_prefixes_ = nullptr;
+    }
     value_delta_encoded_ = !value_is_full;
     have_first_key_ = have_first_key;
     if (have_first_key_ && global_seqno != kDisableGlobalSequenceNumber) {
@@ -699,6 +711,8 @@ class IndexBlockIter final : public BlockIter<IndexValue> {
   bool value_delta_encoded_;
   bool have_first_key_;  // value includes first_internal_key
   BlockPrefixIndex* prefix_index_;
+  // Restart key prefix array, see index_restart_prefix.h
+  const char* restart_prefixes_ = nullptr;
   // Whether the value is delta encoded. In that case the value is assumed to be
   // BlockHandle. The first value in each restart interval is the full encoded
   // BlockHandle; the restart of encoded size part of the BlockHandle. The
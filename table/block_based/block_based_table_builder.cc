@@ -772,14 +772,20 @@ struct BlockBasedTableBuilder::ParallelCompressionRep {
   std::condition_variable first_block_cond;
   std::mutex first_block_mutex;
 
+  // Blocks in flight per compression thread. With more than one, the
+  // building thread emits the next blocks while each compression thread
+  // holds one and the write thread appends another, instead of waiting for
+  // the slowest stage on each block.
+  static constexpr uint32_t kBlocksPerThread = 2;
+
   explicit ParallelCompressionRep(uint32_t parallel_threads)
       : curr_block_keys(new Keys()),
-        block_rep_buf(parallel_threads),
-        block_rep_pool(parallel_threads),
-        compress_queue(parallel_threads),
-        write_queue(parallel_threads),
+        block_rep_buf(parallel_threads * kBlocksPerThread),
+        block_rep_pool(parallel_threads * kBlocksPerThread),
+        compress_queue(parallel_threads * kBlocksPerThread),
+        write_queue(parallel_threads * kBlocksPerThread),
         first_block_processed(false) {
-    for (uint32_t i = 0; i < parallel_threads; i++) {
+    for (uint32_t i = 0; i < block_rep_buf.size(); i++) {
       block_rep_buf[i].contents = Slice();
       block_rep_buf[i].compressed_contents = Slice();
       block_rep_buf[i].data.reset(new std::string());
@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "cache/cache_entry_roles.h"
+#include "cache/cache_helpers.h"
 #include "cache/cache_key.h"
 #include "db/compaction/compaction_picker.h"
 #include "db/dbformat.h"
@@ -70,6 +71,7 @@
 #include "test_util/sync_point.h"
 #include "util/coding.h"
 #include "util/crc32c.h"
+#include "util/random.h"
 #include "util/stop_watch.h"
 #include "util/string_util.h"
 
@@ -384,8 +386,17 @@ Cache::Handle* BlockBasedTable::GetEntryFromCache(
     const Cache::CreateCallback& create_cb, Cache::Priority priority) const {
   Cache::Handle* cache_handle = nullptr;
   if (cache_tier == CacheTier::kNonVolatileBlockTier) {
-    cache_handle = block_cache->Lookup(key, cache_helper, create_cb, priority,
-                                       wait, rep_->ioptions.statistics.get());
+    if (wait) {
+      // Yields to the other fibers of a fiber MultiGet on a pending
+      // secondary cache lookup
+      cache_handle =
+          LookupWithYield(block_cache, key, cache_helper, create_cb, priority,
+                          rep_->ioptions.statistics.get());
+    } else {
+      cache_handle = block_cache->Lookup(key, cache_helper, create_cb,
+                                         priority, /*wait=*/false,
+                                         rep_->ioptions.statistics.get());
+    }
   } else {
     cache_handle = block_cache->Lookup(key, rep_->ioptions.statistics.get());
   }
@@ -1385,6 +1396,10 @@ Status BlockBasedTable::GetDataBlockFromCache(
 
         UpdateCacheInsertionMetrics(block_type, get_context, charge,
                                     s.IsOkOverwritten(), rep_->ioptions.stats);
+      } else if (s.IsIncomplete()) {
+        // Rejected by the admission policy of the cache, use it uncached
+        out_parsed_block->SetOwnedValue(std::move(block_holder));
+        s = Status::OK();
       } else {
         RecordTick(statistics, BLOCK_CACHE_ADD_FAILURES);
       }
@@ -1491,6 +1506,10 @@ Status BlockBasedTable::PutDataBlockToCache(
 
       UpdateCacheInsertionMetrics(block_type, get_context, charge,
                                   s.IsOkOverwritten(), rep_->ioptions.stats);
+    } else if (s.IsIncomplete()) {
+      // Rejected by the admission policy of the cache, use it uncached
+      out_parsed_block->SetOwnedValue(std::move(block_holder));
+      s = Status::OK();
     } else {
       RecordTick(statistics, BLOCK_CACHE_ADD_FAILURES);
     }
@@ -3132,31 +3151,31 @@ bool BlockBasedTable::GetRandomInternalKeysAppend(
   std::unique_ptr<InternalIteratorBase<IndexValue>> index_iter(NewIndexIterator(
       ReadOptions(), disable_prefix_seek,
       /*input_iter=*/nullptr, /*get_context=*/nullptr, &lookup_context));
-  index_iter->SeekToFirst();
-  while (index_iter->Valid()) {
-    if (index_key_includes_seq) {
-      Slice internal_key = index_iter->key();
-      output->push_back(internal_key.ToString());
-    }
-    else {
-      std::string internal_key = index_iter->key().ToString();
-      internal_key.append("\0\0\0\0\0\0\0\0", 8); // seq + type
-      output->push_back(std::move(internal_key));
-    }
-    index_iter->Next();
-  }
-  auto beg = output->begin() + oldsize;
-  auto end = output->end();
-  if (size_t(end - beg) > num) {
-    // set seed as a random number
-    size_t seed = output->size() + size_t(rep_)
-                + size_t(rep_->file_size)
-                + size_t(rep_->file->file_name().data())
-                + size_t(beg->data()) + size_t(end[-1].data());
-    std::shuffle(beg, end, std::mt19937(seed));
-    output->resize(oldsize + num);
-  }
-  return beg != end;
+  // Reservoir sampling over the index keys, only num keys are materialized
+  Random64 rnd(reinterpret_cast<uintptr_t>(rep_) ^ rep_->file_size ^
+               oldsize);
+  uint64_t seen = 0;
+  for (index_iter->SeekToFirst(); index_iter->Valid(); index_iter->Next()) {
+    std::string* dest;
+    if (seen < num) {
+      output->emplace_back();
+      dest = &output->back();
+    } else {
+      uint64_t j = rnd.Uniform(seen + 1);
+      if (j >= num) {
+        seen++;
+        continue;
+      }
+      dest = &(*output)[oldsize + j];
+    }
+    seen++;
+    Slice key = index_iter->key();
+    dest->assign(key.data(), key.size());
+    if (!index_key_includes_seq) {
+      dest->append("\0\0\0\0\0\0\0\0", 8); // seq + type
+    }
+  }
+  return output->size() != oldsize;
 }
 
 }  // namespace ROCKSDB_NAMESPACE
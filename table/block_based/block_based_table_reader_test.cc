@@ -7,6 +7,7 @@
 
 #include <cmath>
 #include <memory>
+#include <set>
 #include <string>
 
 #include "cache/cache_reservation_manager.h"
@@ -285,6 +286,54 @@ TEST_P(BlockBasedTableReaderTest, MultiGet) {
   }
 }
 
+// GetRandomInternalKeysAppend samples the index keys, so at most one key per
+// data block is returned, and the keys already in the output are kept.
+TEST_P(BlockBasedTableReaderTest, GetRandomInternalKeys) {
+  std::map<std::string, std::string> kv =
+      BlockBasedTableReaderBaseTest::GenerateKVMap(100 /* num_block */);
+  std::string table_name = "BlockBasedTableReaderTestRandomKeys" +
+                           CompressionTypeToString(compression_type_);
+  CreateTable(table_name, compression_type_, kv);
+
+  std::unique_ptr<BlockBasedTable> table;
+  Options options;
+  ImmutableOptions ioptions(options);
+  FileOptions foptions;
+  foptions.use_direct_reads = use_direct_reads_;
+  InternalKeyComparator comparator(options.comparator);
+
+  // Disabled by default
+  NewBlockBasedTableReader(foptions, ioptions, comparator, table_name, &table);
+  std::vector<std::string> keys;
+  ASSERT_FALSE(table->GetRandomInternalKeysAppend(10, &keys));
+  ASSERT_TRUE(keys.empty());
+
+  auto opts = *options_.table_factory->GetOptions<BlockBasedTableOptions>();
+  opts.enable_get_random_keys = true;
+  options_.table_factory.reset(NewBlockBasedTableFactory(opts));
+  NewBlockBasedTableReader(foptions, ioptions, comparator, table_name, &table);
+
+  keys.emplace_back("existing");
+  ASSERT_TRUE(table->GetRandomInternalKeysAppend(10, &keys));
+  ASSERT_EQ(11U, keys.size());
+  ASSERT_EQ("existing", keys[0]);
+  std::set<std::string> distinct(keys.begin() + 1, keys.end());
+  ASSERT_EQ(10U, distinct.size());
+  for (const auto& key : distinct) {
+    ParsedInternalKey ikey;
+    ASSERT_OK(ParseInternalKey(key, &ikey, true /* log_err_key */));
+  }
+
+  // Asking for more keys than there are blocks returns all index keys
+  keys.clear();
+  ASSERT_TRUE(table->GetRandomInternalKeysAppend(kv.size(), &keys));
+  ASSERT_GE(keys.size(), 100U);
+  ASSERT_LT(keys.size(), kv.size());
+  distinct.clear();
+  distinct.insert(keys.begin(), keys.end());
+  ASSERT_EQ(keys.size(), distinct.size());
+}
+
 class ChargeTableReaderTest
     : public BlockBasedTableReaderBaseTest,
       public testing::WithParamInterface<
@@ -30,6 +30,9 @@
 //     restarts: uint32[num_restarts]
 //     num_restarts: uint32
 // restarts[i] contains the offset within the block of the ith restart point.
+//
+// If restart_prefix_mode is not kNone, the restart key prefix array described
+// in index_restart_prefix.h is prepended to the block.
 
 #include "table/block_based/block_builder.h"
 
@@ -40,6 +43,7 @@
 #include "db/dbformat.h"
 #include "rocksdb/comparator.h"
 #include "table/block_based/data_block_footer.h"
+#include "table/block_based/index_restart_prefix.h"
 #include "util/coding.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -48,10 +52,12 @@ BlockBuilder::BlockBuilder(
     int block_restart_interval, bool use_delta_encoding,
     bool use_value_delta_encoding,
     BlockBasedTableOptions::DataBlockIndexType index_type,
-    double data_block_hash_table_util_ratio)
+    double data_block_hash_table_util_ratio,
+    RestartPrefixMode restart_prefix_mode)
     : block_restart_interval_(block_restart_interval),
       use_delta_encoding_(use_delta_encoding),
       use_value_delta_encoding_(use_value_delta_encoding),
+      restart_prefix_mode_(restart_prefix_mode),
       restarts_(1, 0),  // First restart point is at offset 0
       counter_(0),
       finished_(false) {
@@ -62,6 +68,10 @@ BlockBuilder::BlockBuilder(
       data_block_hash_index_builder_.Initialize(
           data_block_hash_table_util_ratio);
       break;
+    case BlockBasedTableOptions::kDataBlockBinaryAndWideHash:
+      data_block_hash_index_builder_.Initialize(
+          data_block_hash_table_util_ratio, true /* wide */);
+      break;
     default:
       assert(0);
   }
@@ -73,6 +83,7 @@ void BlockBuilder::Reset() {
   buffer_.clear();
   restarts_.resize(1);  // First restart point is at offset 0
   assert(restarts_[0] == 0);
+  restart_prefixes_.clear();
   estimate_ = sizeof(uint32_t) + sizeof(uint32_t);
   counter_ = 0;
   finished_ = false;
@@ -105,6 +116,9 @@ size_t BlockBuilder::EstimateSizeAfterKV(const Slice& key,
 
   if (counter_ >= block_restart_interval_) {
     estimate += sizeof(uint32_t);  // a new restart entry.
+    if (restart_prefix_mode_ != RestartPrefixMode::kNone) {
+      estimate += kRestartPrefixSize;
+    }
   }
 
   estimate += sizeof(int32_t);  // varint for shared prefix length.
@@ -119,6 +133,25 @@ size_t BlockBuilder::EstimateSizeAfterKV(const Slice& key,
 }
 
 Slice BlockBuilder::Finish() {
+  if (!restart_prefixes_.empty()) {
+    // Prepend the restart key prefix array, entries are shifted right behind
+    // it, so is every restart point.
+    assert(restart_prefixes_.size() == restarts_.size());
+    const size_t prefix_array_size =
+        restart_prefixes_.size() * kRestartPrefixSize;
+    std::string prefix_array;
+    prefix_array.reserve(prefix_array_size + buffer_.size() +
+                         (restarts_.size() + 1) * sizeof(uint32_t));
+    for (uint64_t prefix : restart_prefixes_) {
+      PutFixed64(&prefix_array, prefix);
+    }
+    prefix_array.append(buffer_);
+    buffer_.swap(prefix_array);
+    for (auto& restart : restarts_) {
+      restart += static_cast<uint32_t>(prefix_array_size);
+    }
+  }
+
   // Append restart array
   for (size_t i = 0; i < restarts_.size(); i++) {
     PutFixed32(&buffer_, restarts_[i]);
@@ -128,9 +161,12 @@ Slice BlockBuilder::Finish() {
   BlockBasedTableOptions::DataBlockIndexType index_type =
       BlockBasedTableOptions::kDataBlockBinarySearch;
   if (data_block_hash_index_builder_.Valid() &&
-      CurrentSizeEstimate() <= kMaxBlockSizeSupportedByHashIndex) {
+      (data_block_hash_index_builder_.Wide() ||
+       CurrentSizeEstimate() <= kMaxBlockSizeSupportedByHashIndex)) {
     data_block_hash_index_builder_.Finish(buffer_);
-    index_type = BlockBasedTableOptions::kDataBlockBinaryAndHash;
+    index_type = data_block_hash_index_builder_.Wide()
+                     ? BlockBasedTableOptions::kDataBlockBinaryAndWideHash
+                     : BlockBasedTableOptions::kDataBlockBinaryAndHash;
   }
 
   // footer is a packed format of data_block_index_type and num_restarts
@@ -198,6 +234,14 @@ inline void BlockBuilder::AddWithLastKeyImpl(const Slice& key,
     shared = key.difference_offset(last_key);
   }
 
+  if (restart_prefix_mode_ != RestartPrefixMode::kNone && counter_ == 0) {
+    // This entry is a restart point, including the first entry of the block
+    restart_prefixes_.push_back(RestartKeyPrefix(
+        restart_prefix_mode_ == RestartPrefixMode::kInternalKey
+            ? ExtractUserKey(key)
+            : key));
+  }
+
   const size_t non_shared = key.size() - shared;
 
   if (use_value_delta_encoding_) {
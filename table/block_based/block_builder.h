@@ -20,6 +20,15 @@ namespace ROCKSDB_NAMESPACE {
 
 class BlockBuilder {
  public:
+  // Whether to prepend the restart key prefix array (index blocks only, see
+  // index_restart_prefix.h), and if so, whether the added keys are internal
+  // keys or user keys.
+  enum class RestartPrefixMode : uint8_t {
+    kNone,
+    kUserKey,
+    kInternalKey,
+  };
+
   BlockBuilder(const BlockBuilder&) = delete;
   void operator=(const BlockBuilder&) = delete;
 
@@ -28,7 +37,9 @@ class BlockBuilder {
                         bool use_value_delta_encoding = false,
                         BlockBasedTableOptions::DataBlockIndexType index_type =
                             BlockBasedTableOptions::kDataBlockBinarySearch,
-                        double data_block_hash_table_util_ratio = 0.75);
+                        double data_block_hash_table_util_ratio = 0.75,
+                        RestartPrefixMode restart_prefix_mode =
+                            RestartPrefixMode::kNone);
 
   // Reset the contents as if the BlockBuilder was just constructed.
   void Reset();
@@ -64,9 +75,11 @@ class BlockBuilder {
   // Returns an estimate of the current (uncompressed) size of the block
   // we are building.
   inline size_t CurrentSizeEstimate() const {
-    return estimate_ + (data_block_hash_index_builder_.Valid()
-                            ? data_block_hash_index_builder_.EstimateSize()
-                            : 0);
+    return estimate_ +
+           (data_block_hash_index_builder_.Valid()
+                ? data_block_hash_index_builder_.EstimateSize()
+                : 0) +
+           restart_prefixes_.size() * sizeof(uint64_t);
   }
 
   // Returns an estimated block size after appending key and value.
@@ -86,9 +99,11 @@ class BlockBuilder {
   const bool use_delta_encoding_;
   // Refer to BlockIter::DecodeCurrentValue for format of delta encoded values
   const bool use_value_delta_encoding_;
+  const RestartPrefixMode restart_prefix_mode_;
 
   std::string buffer_;              // Destination buffer
   std::vector<uint32_t> restarts_;  // Restart points
+  std::vector<uint64_t> restart_prefixes_;  // Restart key prefixes
   size_t estimate_;
   int counter_;    // Number of entries emitted since restart
   bool finished_;  // Has Finish() been called?
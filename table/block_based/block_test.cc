@@ -494,12 +494,13 @@ TEST_F(BlockTest, ReadAmpBitmapPow2) {
 
 class IndexBlockTest
     : public testing::Test,
-      public testing::WithParamInterface<std::tuple<bool, bool>> {
+      public testing::WithParamInterface<std::tuple<bool, bool, bool>> {
  public:
   IndexBlockTest() = default;
 
   bool useValueDeltaEncoding() const { return std::get<0>(GetParam()); }
   bool includeFirstKey() const { return std::get<1>(GetParam()); }
+  bool restartPrefixArray() const { return std::get<2>(GetParam()); }
 };
 
 // Similar to GenerateRandomKVs but for index block contents.
@@ -536,7 +537,12 @@ TEST_P(IndexBlockTest, IndexValueEncodingTest) {
   std::vector<BlockHandle> block_handles;
   std::vector<std::string> first_keys;
   const bool kUseDeltaEncoding = true;
-  BlockBuilder builder(16, kUseDeltaEncoding, useValueDeltaEncoding());
+  BlockBuilder builder(16, kUseDeltaEncoding, useValueDeltaEncoding(),
+                       BlockBasedTableOptions::kDataBlockBinarySearch,
+                       0.75 /* data_block_hash_table_util_ratio */,
+                       restartPrefixArray()
+                           ? BlockBuilder::RestartPrefixMode::kInternalKey
+                           : BlockBuilder::RestartPrefixMode::kNone);
   int num_records = 100;
 
   GenerateRandomIndexEntries(&separators, &block_handles, &first_keys,
@@ -609,14 +615,35 @@ TEST_P(IndexBlockTest, IndexValueEncodingTest) {
     EXPECT_EQ(includeFirstKey() ? first_keys[index] : "",
               v.first_internal_key.ToString());
   }
+
+  // seek to keys which are not in the block
+  InternalKeyComparator icmp(options.comparator);
+  for (int i = 0; i < num_records * 2; i++) {
+    std::string target = test::RandomKey(&rnd, 12);
+    int index = static_cast<int>(
+        std::lower_bound(separators.begin(), separators.end(), target,
+                         [&icmp](const std::string &a, const std::string &b) {
+                           return icmp.Compare(a, b) < 0;
+                         }) -
+        separators.begin());
+
+    iter->Seek(target);
+    if (index == num_records) {
+      ASSERT_FALSE(iter->Valid());
+      ASSERT_OK(iter->status());
+      continue;
+    }
+    ASSERT_TRUE(iter->Valid());
+    EXPECT_EQ(separators[index], iter->key().ToString());
+    EXPECT_EQ(block_handles[index].offset(), iter->value().handle.offset());
+  }
   delete iter;
 }
 
 INSTANTIATE_TEST_CASE_P(P, IndexBlockTest,
-                        ::testing::Values(std::make_tuple(false, false),
-                                          std::make_tuple(false, true),
-                                          std::make_tuple(true, false),
-                                          std::make_tuple(true, true)));
+                        ::testing::Combine(::testing::Bool(),
+                                           ::testing::Bool(),
+                                           ::testing::Bool()));
 
 }  // namespace ROCKSDB_NAMESPACE
 
@@ -15,12 +15,26 @@ namespace ROCKSDB_NAMESPACE {
 
 const int kDataBlockIndexTypeBitShift = 31;
 
+// Set together with the index type bit for kDataBlockBinaryAndWideHash
+const int kDataBlockWideHashBitShift = 30;
+
 // 0x7FFFFFFF
 const uint32_t kMaxNumRestarts = (1u << kDataBlockIndexTypeBitShift) - 1u;
 
 // 0x7FFFFFFF
 const uint32_t kNumRestartsMask = (1u << kDataBlockIndexTypeBitShift) - 1u;
 
+// 0x3FFFFFFF
+const uint32_t kWideHashNumRestartsMask =
+    (1u << kDataBlockWideHashBitShift) - 1u;
+
+// 0xC0000000
+const uint32_t kWideHashFooterMask = ~kWideHashNumRestartsMask;
+
+bool IsWideHashIndexFooter(uint32_t block_footer) {
+  return (block_footer & kWideHashFooterMask) == kWideHashFooterMask;
+}
+
 uint32_t PackIndexTypeAndNumRestarts(
     BlockBasedTableOptions::DataBlockIndexType index_type,
     uint32_t num_restarts) {
@@ -31,6 +45,10 @@ uint32_t PackIndexTypeAndNumRestarts(
   uint32_t block_footer = num_restarts;
   if (index_type == BlockBasedTableOptions::kDataBlockBinaryAndHash) {
     block_footer |= 1u << kDataBlockIndexTypeBitShift;
+  } else if (index_type ==
+             BlockBasedTableOptions::kDataBlockBinaryAndWideHash) {
+    assert(num_restarts <= kWideHashNumRestartsMask);
+    block_footer |= kWideHashFooterMask;
   } else if (index_type != BlockBasedTableOptions::kDataBlockBinarySearch) {
     assert(0);
   }
@@ -42,6 +60,16 @@ void UnPackIndexTypeAndNumRestarts(
     uint32_t block_footer,
     BlockBasedTableOptions::DataBlockIndexType* index_type,
     uint32_t* num_restarts) {
+  if (IsWideHashIndexFooter(block_footer)) {
+    if (index_type) {
+      *index_type = BlockBasedTableOptions::kDataBlockBinaryAndWideHash;
+    }
+    if (num_restarts) {
+      *num_restarts = block_footer & kWideHashNumRestartsMask;
+    }
+    return;
+  }
+
   if (index_type) {
     if (block_footer & 1u << kDataBlockIndexTypeBitShift) {
       *index_type = BlockBasedTableOptions::kDataBlockBinaryAndHash;
@@ -17,6 +17,10 @@ uint32_t PackIndexTypeAndNumRestarts(
     BlockBasedTableOptions::DataBlockIndexType index_type,
     uint32_t num_restarts);
 
+// Whether the footer is of a kDataBlockBinaryAndWideHash block, which is
+// recognized regardless of the block size.
+bool IsWideHashIndexFooter(uint32_t block_footer);
+
 void UnPackIndexTypeAndNumRestarts(
     uint32_t block_footer,
     BlockBasedTableOptions::DataBlockIndexType* index_type,
@@ -16,19 +16,41 @@ namespace ROCKSDB_NAMESPACE {
 void DataBlockHashIndexBuilder::Add(const Slice& key,
                                     const size_t restart_index) {
   assert(Valid());
-  if (restart_index > kMaxRestartSupportedByHashIndex) {
+  if (restart_index > (wide_ ? kMaxRestartSupportedByWideHashIndex
+                             : kMaxRestartSupportedByHashIndex)) {
     valid_ = false;
     return;
   }
 
   uint32_t hash_value = GetSliceHash(key);
   hash_and_restart_pairs_.emplace_back(hash_value,
-                                       static_cast<uint8_t>(restart_index));
+                                       static_cast<uint16_t>(restart_index));
   estimated_num_buckets_ += bucket_per_key_;
 }
 
 void DataBlockHashIndexBuilder::Finish(std::string& buffer) {
   assert(Valid());
+  if (wide_) {
+    uint32_t num_buckets = static_cast<uint32_t>(estimated_num_buckets_);
+    // Odd number of buckets, for the same reason as the narrow format
+    num_buckets |= 1;
+
+    std::vector<uint16_t> buckets(num_buckets, kWideNoEntry);
+    for (auto& entry : hash_and_restart_pairs_) {
+      uint32_t buck_idx = entry.first % num_buckets;
+      if (buckets[buck_idx] == kWideNoEntry) {
+        buckets[buck_idx] = entry.second;
+      } else if (buckets[buck_idx] != entry.second) {
+        buckets[buck_idx] = kWideCollision;
+      }
+    }
+    for (uint16_t restart_index : buckets) {
+      PutFixed16(&buffer, restart_index);
+    }
+    PutFixed32(&buffer, num_buckets);
+    return;
+  }
+
   uint16_t num_buckets = static_cast<uint16_t>(estimated_num_buckets_);
 
   if (num_buckets == 0) {
@@ -45,7 +67,7 @@ void DataBlockHashIndexBuilder::Finish(std::string& buffer) {
   // write the restart_index array
   for (auto& entry : hash_and_restart_pairs_) {
     uint32_t hash_value = entry.first;
-    uint8_t restart_index = entry.second;
+    uint8_t restart_index = static_cast<uint8_t>(entry.second);
     uint16_t buck_idx = static_cast<uint16_t>(hash_value % num_buckets);
     if (buckets[buck_idx] == kNoEntry) {
       buckets[buck_idx] = restart_index;
@@ -76,6 +98,7 @@ void DataBlockHashIndexBuilder::Reset() {
 void DataBlockHashIndex::Initialize(const char* data, uint16_t size,
                                     uint16_t* map_offset) {
   assert(size >= sizeof(uint16_t));  // NUM_BUCKETS
+  wide_ = false;
   num_buckets_ = DecodeFixed16(data + size - sizeof(uint16_t));
   assert(num_buckets_ > 0);
   assert(size > num_buckets_ * sizeof(uint8_t));
@@ -83,8 +106,43 @@ void DataBlockHashIndex::Initialize(const char* data, uint16_t size,
                                       num_buckets_ * sizeof(uint8_t));
 }
 
+void DataBlockHashIndex::InitializeWide(const char* data, uint32_t size,
+                                        uint32_t* map_offset) {
+  wide_ = true;
+  num_buckets_ = 0;
+  *map_offset = 0;
+  if (size < sizeof(uint32_t)) {  // NUM_BUCKETS
+    return;
+  }
+  uint32_t num_buckets = DecodeFixed32(data + size - sizeof(uint32_t));
+  uint64_t index_size = sizeof(uint32_t) + uint64_t(num_buckets) * 2;
+  if (num_buckets == 0 || index_size > size) {
+    return;
+  }
+  num_buckets_ = num_buckets;
+  *map_offset = static_cast<uint32_t>(size - index_size);
+}
+
+uint32_t DataBlockHashIndex::LookupRestartIndex(const char* data,
+                                                uint32_t map_offset,
+                                                const Slice& key) const {
+  if (!wide_) {
+    uint8_t entry = Lookup(data, map_offset, key);
+    if (entry == kNoEntry) {
+      return kWideNoEntry;
+    } else if (entry == kCollision) {
+      return kWideCollision;
+    }
+    return entry;
+  }
+  uint32_t hash_value = GetSliceHash(key);
+  uint32_t idx = hash_value % num_buckets_;
+  return DecodeFixed16(data + map_offset + idx * sizeof(uint16_t));
+}
+
 uint8_t DataBlockHashIndex::Lookup(const char* data, uint32_t map_offset,
                                    const Slice& key) const {
+  assert(!wide_);
   uint32_t hash_value = GetSliceHash(key);
   uint16_t idx = static_cast<uint16_t>(hash_value % num_buckets_);
   const char* bucket_table = data + map_offset;
@@ -61,11 +61,28 @@ namespace ROCKSDB_NAMESPACE {
 //
 // Note that we only support blocks with #restart_interval < 254. If a block
 // has more restart interval than that, hash index will not be create for it.
+//
+// kDataBlockBinaryAndWideHash lifts both limits of the format above, for
+// large blocks with many restart intervals:
+//
+// HASH_IDX: [B16 B16 ... B16 NUM_BUCK32]
+//
+// B16:        bucket, a uint16_t restart index, with kWideNoEntry=0xFFFF and
+//             kWideCollision=0xFFFE reserved, so up to 65533 restarts.
+// NUM_BUCK32: uint32_t number of buckets.
+//
+// The block FOOTER has both of its two MSBs set, the 3rd MSB is never used
+// by legacy blocks, and all offsets are uint32_t, so the block size is not
+// limited to 64KiB. This format is not readable by versions unaware of it.
 
 const uint8_t kNoEntry = 255;
 const uint8_t kCollision = 254;
 const uint8_t kMaxRestartSupportedByHashIndex = 253;
 
+const uint16_t kWideNoEntry = 0xFFFF;
+const uint16_t kWideCollision = 0xFFFE;
+const uint16_t kMaxRestartSupportedByWideHashIndex = 0xFFFD;
+
 // Because we use uint16_t address, we only support block no more than 64KB
 const size_t kMaxBlockSizeSupportedByHashIndex = 1u << 16;
 const double kDefaultUtilRatio = 0.75;
@@ -75,21 +92,30 @@ class DataBlockHashIndexBuilder {
   DataBlockHashIndexBuilder()
       : bucket_per_key_(-1 /*uninitialized marker*/),
         estimated_num_buckets_(0),
-        valid_(false) {}
+        valid_(false),
+        wide_(false) {}
 
-  void Initialize(double util_ratio) {
+  void Initialize(double util_ratio, bool wide = false) {
     if (util_ratio <= 0) {
       util_ratio = kDefaultUtilRatio;  // sanity check
     }
     bucket_per_key_ = 1 / util_ratio;
     valid_ = true;
+    wide_ = wide;
   }
 
   inline bool Valid() const { return valid_ && bucket_per_key_ > 0; }
+  inline bool Wide() const { return wide_; }
   void Add(const Slice& key, const size_t restart_index);
   void Finish(std::string& buffer);
   void Reset();
   inline size_t EstimateSize() const {
+    if (wide_) {
+      uint32_t estimated_num_buckets =
+          static_cast<uint32_t>(estimated_num_buckets_) | 1;
+      return sizeof(uint32_t) +
+             static_cast<size_t>(estimated_num_buckets) * sizeof(uint16_t);
+    }
     uint16_t estimated_num_buckets =
         static_cast<uint16_t>(estimated_num_buckets_);
 
@@ -108,19 +134,31 @@ class DataBlockHashIndexBuilder {
   // restart_index is larger than supported. In this case HashIndex is not
   // appended to the block content.
   bool valid_;
+  // Use the wide format, see kDataBlockBinaryAndWideHash
+  bool wide_;
 
-  std::vector<std::pair<uint32_t, uint8_t>> hash_and_restart_pairs_;
+  std::vector<std::pair<uint32_t, uint16_t>> hash_and_restart_pairs_;
   friend class DataBlockHashIndex_DataBlockHashTestSmall_Test;
 };
 
 class DataBlockHashIndex {
  public:
-  DataBlockHashIndex() : num_buckets_(0) {}
+  DataBlockHashIndex() : num_buckets_(0), wide_(false) {}
 
   void Initialize(const char* data, uint16_t size, uint16_t* map_offset);
 
+  // Initialize from the wide format. On corruption, the index is left
+  // invalid and `*map_offset` is set to 0.
+  void InitializeWide(const char* data, uint32_t size, uint32_t* map_offset);
+
+  // REQUIRES: the index is not in the wide format
   uint8_t Lookup(const char* data, uint32_t map_offset, const Slice& key) const;
 
+  // Lookup for either format, returns the restart index, kWideNoEntry or
+  // kWideCollision.
+  uint32_t LookupRestartIndex(const char* data, uint32_t map_offset,
+                              const Slice& key) const;
+
   inline bool Valid() { return num_buckets_ != 0; }
 
  private:
@@ -130,7 +168,9 @@ class DataBlockHashIndex {
   // block.
   // So in other words, DataBlockHashIndex does not support block size equal
   // or greater then 64KiB.
-  uint16_t num_buckets_;
+  // The wide format uses uint16 buckets and uint32 offsets instead.
+  uint32_t num_buckets_;
+  bool wide_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -16,6 +16,7 @@
 #include "table/block_based/block_builder.h"
 #include "table/get_context.h"
 #include "table/table_builder.h"
+#include "test_util/sync_point.h"
 #include "test_util/testharness.h"
 #include "test_util/testutil.h"
 #include "util/random.h"
@@ -529,6 +530,124 @@ TEST(DataBlockHashIndex, BlockTestLarge) {
   }
 }
 
+TEST(DataBlockHashIndex, WideHashIndexLargeBlock) {
+  Random rnd(1019);
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+
+  // #restarts > 253 and block size > 64KiB, narrow HashIndex is not usable.
+  // Each user key has two versions, so every user key has a restart interval
+  // of its own and is not a collision in the HashIndex.
+  BlockBuilder builder(2 /* block_restart_interval */,
+                       true /* use_delta_encoding */,
+                       false /* use_value_delta_encoding */,
+                       BlockBasedTableOptions::kDataBlockBinaryAndWideHash);
+  int num_records = 1000;
+
+  GenerateRandomKVs(&keys, &values, 0, num_records);
+
+  // The existing key marker is "1"
+  for (int i = 0; i < num_records; i++) {
+    std::string ukey(keys[i] + "1" /* existing key marker */);
+    builder.Add(InternalKey(ukey, 20, kTypeValue).Encode().ToString(),
+                values[i]);
+    builder.Add(InternalKey(ukey, 10, kTypeValue).Encode().ToString(),
+                values[i]);
+  }
+
+  Slice rawblock = builder.Finish();
+  ASSERT_GT(rawblock.size(), kMaxBlockSizeSupportedByHashIndex);
+
+  // Probe the HashIndex directly: user key i is in restart interval i unless
+  // its bucket is a collision
+  DataBlockHashIndex hash_index;
+  uint32_t map_offset;
+  hash_index.InitializeWide(
+      rawblock.data(),
+      static_cast<uint32_t>(rawblock.size() - sizeof(uint32_t)), &map_offset);
+  ASSERT_TRUE(hash_index.Valid());
+  std::vector<bool> hash_hit(num_records);
+  int num_hash_hits = 0;
+  for (int i = 0; i < num_records; i++) {
+    uint32_t restart_index = hash_index.LookupRestartIndex(
+        rawblock.data(), map_offset, keys[i] + "1");
+    if (restart_index != kWideCollision) {
+      ASSERT_EQ(restart_index, static_cast<uint32_t>(i));
+      hash_hit[i] = true;
+      num_hash_hits++;
+    }
+  }
+  // util_ratio 0.75 leaves most of the keys in a bucket of their own
+  ASSERT_GT(num_hash_hits, num_records / 2);
+
+  BlockContents contents;
+  contents.data = rawblock;
+  Block reader(std::move(contents));
+  ASSERT_EQ(reader.IndexType(),
+            BlockBasedTableOptions::kDataBlockBinaryAndWideHash);
+  ASSERT_EQ(reader.NumRestarts(), static_cast<uint32_t>(num_records));
+  const InternalKeyComparator icmp(BytewiseComparator());
+
+  int num_seek_for_prev_hits = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "DataBlockIter::SeekForPrevByHashIndex:Hit",
+      [&](void*) { num_seek_for_prev_hits++; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  std::unique_ptr<DataBlockIter> iter(reader.NewDataIterator(
+      icmp.user_comparator(), kDisableGlobalSequenceNumber));
+  for (int i = 0; i < num_records; i++) {
+    int index = rnd.Uniform(num_records);
+    std::string ukey(keys[index] + "1" /* existing key marker */);
+
+    ASSERT_TRUE(iter->SeekForGet(InternalKey(ukey, 30, kTypeValue).Encode()));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(InternalKey(ukey, 20, kTypeValue).Encode(), iter->key());
+    ASSERT_EQ(values[index], iter->value());
+
+    // SeekForPrev on exact hit
+    num_seek_for_prev_hits = 0;
+    iter->SeekForPrev(InternalKey(ukey, 10, kTypeValue).Encode());
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(InternalKey(ukey, 10, kTypeValue).Encode(), iter->key());
+    ASSERT_EQ(num_seek_for_prev_hits, hash_hit[index] ? 1 : 0);
+
+    // SeekForPrev between the two versions of a user key
+    num_seek_for_prev_hits = 0;
+    iter->SeekForPrev(InternalKey(ukey, 15, kTypeValue).Encode());
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(InternalKey(ukey, 20, kTypeValue).Encode(), iter->key());
+    ASSERT_EQ(num_seek_for_prev_hits, hash_hit[index] ? 1 : 0);
+
+    // SeekForPrev before all versions of a user key lands on the previous
+    // user key
+    num_seek_for_prev_hits = 0;
+    iter->SeekForPrev(InternalKey(ukey, 30, kTypeValue).Encode());
+    if (index == 0) {
+      ASSERT_FALSE(iter->Valid());
+    } else {
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(InternalKey(keys[index - 1] + "1", 10, kTypeValue).Encode(),
+                iter->key());
+    }
+    ASSERT_EQ(num_seek_for_prev_hits, hash_hit[index] ? 1 : 0);
+
+    // SeekForPrev non-existent user key
+    std::string non_existent(keys[index] + "0" /* non-existing key marker */);
+    iter->SeekForPrev(InternalKey(non_existent, 10, kTypeValue).Encode());
+    if (index == 0) {
+      ASSERT_FALSE(iter->Valid());
+    } else {
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(InternalKey(keys[index - 1] + "1", 10, kTypeValue).Encode(),
+                iter->key());
+    }
+  }
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 // helper routine for DataBlockHashIndex.BlockBoundary
 void TestBoundary(InternalKey& ik1, std::string& v1, InternalKey& ik2,
                   std::string& v2, InternalKey& seek_ikey,
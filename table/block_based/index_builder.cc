@@ -31,12 +31,15 @@ IndexBuilder* IndexBuilder::CreateIndexBuilder(
     const bool use_value_delta_encoding,
     const BlockBasedTableOptions& table_opt) {
   IndexBuilder* result = nullptr;
+  const bool restart_prefix_array =
+      UseRestartPrefixArray(comparator, table_opt);
   switch (index_type) {
     case BlockBasedTableOptions::kBinarySearch: {
       result = new ShortenedIndexBuilder(
           comparator, table_opt.index_block_restart_interval,
           table_opt.format_version, use_value_delta_encoding,
-          table_opt.index_shortening, /* include_first_key */ false);
+          table_opt.index_shortening, /* include_first_key */ false,
+          restart_prefix_array);
       break;
     }
     case BlockBasedTableOptions::kHashSearch: {
@@ -46,7 +49,8 @@ IndexBuilder* IndexBuilder::CreateIndexBuilder(
       result = new HashIndexBuilder(
           comparator, int_key_slice_transform,
           table_opt.index_block_restart_interval, table_opt.format_version,
-          use_value_delta_encoding, table_opt.index_shortening);
+          use_value_delta_encoding, table_opt.index_shortening,
+          restart_prefix_array);
       break;
     }
     case BlockBasedTableOptions::kTwoLevelIndexSearch: {
@@ -58,7 +62,8 @@ IndexBuilder* IndexBuilder::CreateIndexBuilder(
       result = new ShortenedIndexBuilder(
           comparator, table_opt.index_block_restart_interval,
           table_opt.format_version, use_value_delta_encoding,
-          table_opt.index_shortening, /* include_first_key */ true);
+          table_opt.index_shortening, /* include_first_key */ true,
+          restart_prefix_array);
       break;
     }
     default: {
@@ -116,12 +121,20 @@ PartitionedIndexBuilder::PartitionedIndexBuilder(
     const BlockBasedTableOptions& table_opt,
     const bool use_value_delta_encoding)
     : IndexBuilder(comparator),
-      index_block_builder_(table_opt.index_block_restart_interval,
-                           true /*use_delta_encoding*/,
-                           use_value_delta_encoding),
-      index_block_builder_without_seq_(table_opt.index_block_restart_interval,
-                                       true /*use_delta_encoding*/,
-                                       use_value_delta_encoding),
+      index_block_builder_(
+          table_opt.index_block_restart_interval, true /*use_delta_encoding*/,
+          use_value_delta_encoding,
+          BlockBasedTableOptions::kDataBlockBinarySearch,
+          0.75 /*data_block_hash_table_util_ratio*/,
+          RestartPrefixMode(UseRestartPrefixArray(comparator, table_opt),
+                            true /*key_includes_seq*/)),
+      index_block_builder_without_seq_(
+          table_opt.index_block_restart_interval, true /*use_delta_encoding*/,
+          use_value_delta_encoding,
+          BlockBasedTableOptions::kDataBlockBinarySearch,
+          0.75 /*data_block_hash_table_util_ratio*/,
+          RestartPrefixMode(UseRestartPrefixArray(comparator, table_opt),
+                            false /*key_includes_seq*/)),
       sub_index_builder_(nullptr),
       table_opt_(table_opt),
       // We start by false. After each partition we revise the value based on
@@ -142,7 +155,8 @@ void PartitionedIndexBuilder::MakeNewSubIndexBuilder() {
   sub_index_builder_ = new ShortenedIndexBuilder(
       comparator_, table_opt_.index_block_restart_interval,
       table_opt_.format_version, use_value_delta_encoding_,
-      table_opt_.index_shortening, /* include_first_key */ false);
+      table_opt_.index_shortening, /* include_first_key */ false,
+      UseRestartPrefixArray(comparator_, table_opt_));
 
   // Set sub_index_builder_->seperator_is_key_plus_seq_ to true if
   // seperator_is_key_plus_seq_ is true (internal-key mode) (set to false by
@@ -103,6 +103,25 @@ class IndexBuilder {
 
   virtual bool seperator_is_key_plus_seq() { return true; }
 
+  // Whether index blocks should carry the restart key prefix array, which is
+  // only meaningful for the forward bytewise comparator without timestamp.
+  static bool UseRestartPrefixArray(const InternalKeyComparator* comparator,
+                                    const BlockBasedTableOptions& table_opt) {
+    const Comparator* ucmp = comparator->user_comparator();
+    return table_opt.index_restart_prefix_array &&
+           ucmp->IsForwardBytewise() && ucmp->timestamp_size() == 0;
+  }
+
+  // BlockBuilder::RestartPrefixMode for the index block builders
+  static BlockBuilder::RestartPrefixMode RestartPrefixMode(
+      bool restart_prefix_array, bool key_includes_seq) {
+    if (!restart_prefix_array) {
+      return BlockBuilder::RestartPrefixMode::kNone;
+    }
+    return key_includes_seq ? BlockBuilder::RestartPrefixMode::kInternalKey
+                            : BlockBuilder::RestartPrefixMode::kUserKey;
+  }
+
  protected:
   const InternalKeyComparator* comparator_;
   // Set after ::Finish is called
@@ -125,14 +144,20 @@ class ShortenedIndexBuilder : public IndexBuilder {
       const int index_block_restart_interval, const uint32_t format_version,
       const bool use_value_delta_encoding,
       BlockBasedTableOptions::IndexShorteningMode shortening_mode,
-      bool include_first_key)
+      bool include_first_key, bool restart_prefix_array = false)
       : IndexBuilder(comparator),
-        index_block_builder_(index_block_restart_interval,
-                             true /*use_delta_encoding*/,
-                             use_value_delta_encoding),
-        index_block_builder_without_seq_(index_block_restart_interval,
-                                         true /*use_delta_encoding*/,
-                                         use_value_delta_encoding),
+        index_block_builder_(
+            index_block_restart_interval, true /*use_delta_encoding*/,
+            use_value_delta_encoding,
+            BlockBasedTableOptions::kDataBlockBinarySearch,
+            0.75 /*data_block_hash_table_util_ratio*/,
+            RestartPrefixMode(restart_prefix_array, true /*key_includes_seq*/)),
+        index_block_builder_without_seq_(
+            index_block_restart_interval, true /*use_delta_encoding*/,
+            use_value_delta_encoding,
+            BlockBasedTableOptions::kDataBlockBinarySearch,
+            0.75 /*data_block_hash_table_util_ratio*/,
+            RestartPrefixMode(restart_prefix_array, false /*key_includes_seq*/)),
         use_value_delta_encoding_(use_value_delta_encoding),
         include_first_key_(include_first_key),
         shortening_mode_(shortening_mode) {
@@ -270,11 +295,13 @@ class HashIndexBuilder : public IndexBuilder {
       const SliceTransform* hash_key_extractor,
       int index_block_restart_interval, int format_version,
       bool use_value_delta_encoding,
-      BlockBasedTableOptions::IndexShorteningMode shortening_mode)
+      BlockBasedTableOptions::IndexShorteningMode shortening_mode,
+      bool restart_prefix_array)
       : IndexBuilder(comparator),
         primary_index_builder_(comparator, index_block_restart_interval,
                                format_version, use_value_delta_encoding,
-                               shortening_mode, /* include_first_key */ false),
+                               shortening_mode, /* include_first_key */ false,
+                               restart_prefix_array),
         hash_key_extractor_(hash_key_extractor) {}
 
   virtual void AddIndexEntry(std::string* last_key_in_current_block,
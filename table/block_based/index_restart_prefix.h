@@ -0,0 +1,81 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <stdint.h>
+
+#include "rocksdb/slice.h"
+#include "util/coding.h"
+#include "util/math.h"
+
+namespace ROCKSDB_NAMESPACE {
+// Restart key prefix array for index blocks, enabled by
+// BlockBasedTableOptions::index_restart_prefix_array.
+//
+// Index block seeks spend most of their time in BinarySeek() decoding the
+// varint header of a restart key, whose address is only known after loading
+// the restart array, so the cache misses of every probe chain on each other.
+// The prefix array stores the first 8 bytes of the user key of every restart
+// entry as a dense fixed-size array, so the binary search can first narrow
+// down the candidate restart range without touching the entries at all, and
+// only compare full keys for restarts whose prefix equals the target's.
+//
+// INDEX_BLOCK: [PREFIX PREFIX ... PREFIX RI RI ... RI RI_IDX FOOTER]
+//
+// PREFIX:  uint64 (fixed64), one for each restart point, holding the first 8
+//          bytes of the restart user key as a big endian number, padded with
+//          zeros. The array starts at block offset 0, so it shares the
+//          alignment of the block buffer.
+// RI, RI_IDX, FOOTER: the same as the default block format.
+//
+// Since the first restart of a legacy block is always at offset 0, a block
+// with the prefix array is recognized by restart[0] == 8 * num_restarts, and
+// readers unaware of the prefix array simply start iterating at restart[0].
+//
+// Prefix order is consistent with key order only for the forward bytewise
+// comparator without timestamps:
+//   prefix(a) < prefix(b)  ==>  a < b
+//   a <= b                 ==>  prefix(a) <= prefix(b)
+// so the prefix array is neither written nor used for other comparators.
+
+constexpr size_t kRestartPrefixSize = sizeof(uint64_t);
+
+inline uint64_t RestartKeyPrefix(const Slice& user_key) {
+  const unsigned char* p =
+      reinterpret_cast<const unsigned char*>(user_key.data());
+  if (user_key.size() >= kRestartPrefixSize) {
+    return EndianSwapValue(DecodeFixed64(user_key.data()));
+  }
+  uint64_t prefix = 0;
+  for (size_t i = 0; i < user_key.size(); ++i) {
+    prefix |= uint64_t(p[i]) << (56 - 8 * i);
+  }
+  return prefix;
+}
+
+// Branchless search on the prefix array, returns the number of prefixes
+// which are less than `target` (or less than or equal to `target` if
+// `upper_bound` is true). `n` must be greater than 0.
+inline uint32_t RestartPrefixBound(const char* prefixes, uint32_t n,
+                                   uint64_t target, bool upper_bound) {
+  assert(n > 0);
+  const char* base = prefixes;
+  uint32_t len = n;
+  // Each iteration halves `len` by a conditional move rather than a branch,
+  // so the loads of successive iterations do not wait on branch resolution.
+  while (len > 1) {
+    uint32_t half = len / 2;
+    uint64_t mid = DecodeFixed64(base + (half - 1) * kRestartPrefixSize);
+    bool go_right = upper_bound ? mid <= target : mid < target;
+    base += go_right ? half * kRestartPrefixSize : 0;
+    len -= half;
+  }
+  uint64_t last = DecodeFixed64(base);
+  bool past = upper_bound ? last <= target : last < target;
+  return uint32_t((base - prefixes) / kRestartPrefixSize) + past;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
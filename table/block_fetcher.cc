@@ -73,7 +73,13 @@ inline bool BlockFetcher::TryGetFromPrefetchBuffer() {
     IOStatus io_s = file_->PrepareIOOptions(read_options_, opts);
     if (io_s.ok()) {
       bool read_from_prefetch_buffer = false;
-      if (read_options_.async_io && !for_compaction_) {
+      // Compaction reads ahead a fixed compaction_readahead_size, which
+      // can be double buffered as well if compaction_async_readahead.
+      // ReadAsync is not charged to the rate limiter, so rate limited
+      // compactions read ahead synchronously.
+      if (for_compaction_ ? ioptions_.compaction_async_readahead &&
+                                ioptions_.rate_limiter == nullptr
+                          : read_options_.async_io) {
         read_from_prefetch_buffer = prefetch_buffer_->TryReadFromCacheAsync(
             opts, file_, handle_.offset(), block_size_with_trailer_, &slice_,
             &io_s, read_options_.rate_limiter_priority);
@@ -684,6 +684,12 @@ DEFINE_int32(
     "Number of keys between restart points "
     "for delta encoding of keys in index block.");
 
+DEFINE_bool(index_restart_prefix_array,
+            ROCKSDB_NAMESPACE::BlockBasedTableOptions()
+                .index_restart_prefix_array,
+            "Prefix index blocks with a fixed size array of restart key "
+            "prefixes to speed up index seek.");
+
 DEFINE_int32(read_amp_bytes_per_bit,
              ROCKSDB_NAMESPACE::BlockBasedTableOptions().read_amp_bytes_per_bit,
              "Number of bytes per bit to be used in block read-amp bitmap");
@@ -706,6 +712,11 @@ DEFINE_bool(use_data_block_hash_index, false,
             "instead of kDataBlockBinarySearch. "
             "This is valid if only we use BlockTable");
 
+DEFINE_bool(use_data_block_wide_hash_index, false,
+            "if use kDataBlockBinaryAndWideHash, which also works for blocks "
+            "larger than 64KiB or with more than 253 restart intervals. "
+            "Overrides use_data_block_hash_index");
+
 DEFINE_double(data_block_hash_table_util_ratio, 0.75,
               "util ratio for data block hash index table. "
               "This is only valid if use_data_block_hash_index is "
@@ -877,6 +888,13 @@ DEFINE_int32(level0_file_num_compaction_trigger,
              ROCKSDB_NAMESPACE::Options().level0_file_num_compaction_trigger,
              "Number of files in level-0 when compactions start.");
 
+DEFINE_uint64(level0_tiered_write_rate,
+              ROCKSDB_NAMESPACE::Options().level0_tiered_write_rate,
+              "Compact level-0 as a tiered level while the write rate is at "
+              "least this many bytes per second, 0 to disable. Compare "
+              "the compaction stats with and without it for the write, read "
+              "and space amplification of the hybrid layout.");
+
 DEFINE_uint64(periodic_compaction_seconds,
               ROCKSDB_NAMESPACE::Options().periodic_compaction_seconds,
               "Files older than this will be picked up for compaction and"
@@ -4391,6 +4409,8 @@ class Benchmark {
       block_based_options.block_restart_interval = FLAGS_block_restart_interval;
       block_based_options.index_block_restart_interval =
           FLAGS_index_block_restart_interval;
+      block_based_options.index_restart_prefix_array =
+          FLAGS_index_restart_prefix_array;
       block_based_options.format_version =
           static_cast<uint32_t>(FLAGS_format_version);
       block_based_options.read_amp_bytes_per_bit = FLAGS_read_amp_bytes_per_bit;
@@ -4419,7 +4439,10 @@ class Benchmark {
           fprintf(stderr, "Unknown prepopulate block cache mode\n");
       }
       block_based_options.prepopulate_block_cache = prepopulate_block_cache;
-      if (FLAGS_use_data_block_hash_index) {
+      if (FLAGS_use_data_block_wide_hash_index) {
+        block_based_options.data_block_index_type = ROCKSDB_NAMESPACE::
+            BlockBasedTableOptions::kDataBlockBinaryAndWideHash;
+      } else if (FLAGS_use_data_block_hash_index) {
         block_based_options.data_block_index_type =
             ROCKSDB_NAMESPACE::BlockBasedTableOptions::kDataBlockBinaryAndHash;
       } else {
@@ -4532,6 +4555,7 @@ class Benchmark {
     options.level0_stop_writes_trigger = FLAGS_level0_stop_writes_trigger;
     options.level0_file_num_compaction_trigger =
         FLAGS_level0_file_num_compaction_trigger;
+    options.level0_tiered_write_rate = FLAGS_level0_tiered_write_rate;
     options.level0_slowdown_writes_trigger =
         FLAGS_level0_slowdown_writes_trigger;
     options.compression = FLAGS_compression_type_e;
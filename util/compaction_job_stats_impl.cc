@@ -3,6 +3,8 @@
 //  COPYING file in the root directory) and Apache 2.0 License
 //  (found in the LICENSE.Apache file in the root directory).
 
+#include <algorithm>
+
 #include "rocksdb/compaction_job_stats.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -50,6 +52,10 @@ void CompactionJobStats::Reset() {
 
   num_single_del_fallthru = 0;
   num_single_del_mismatch = 0;
+
+  num_subcompactions = 0;
+  max_subcompaction_input_bytes = 0;
+  max_subcompaction_micros = 0;
 }
 
 void CompactionJobStats::Add(const CompactionJobStats& stats) {
@@ -87,6 +93,13 @@ void CompactionJobStats::Add(const CompactionJobStats& stats) {
 
   num_single_del_fallthru += stats.num_single_del_fallthru;
   num_single_del_mismatch += stats.num_single_del_mismatch;
+
+  num_subcompactions += stats.num_subcompactions;
+  max_subcompaction_input_bytes =
+      std::max(max_subcompaction_input_bytes,
+               stats.max_subcompaction_input_bytes);
+  max_subcompaction_micros =
+      std::max(max_subcompaction_micros, stats.max_subcompaction_micros);
 }
 
 #else
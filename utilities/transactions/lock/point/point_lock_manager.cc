@@ -11,7 +11,9 @@
 #include <cinttypes>
 #include <mutex>
 
+#include "db/db_impl/db_impl.h"
 #include "monitoring/perf_context_imp.h"
+#include "monitoring/statistics.h"
 #include "rocksdb/slice.h"
 #include "rocksdb/utilities/transaction_db_mutex.h"
 #include "test_util/sync_point.h"
@@ -25,6 +27,19 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+// A transaction waiting in AcquireWithTimeout() for a locked key. It lives on
+// the stack of the waiting thread and is only accessed with the stripe mutex
+// held.
+struct KeyLockWaiter {
+  TransactionID txn_id;
+  bool exclusive;
+  // Set when the lock was handed over to this waiter by UnLockKey()
+  bool granted = false;
+  uint64_t expiration_time;
+  KeyLockWaiter* next = nullptr;
+  std::shared_ptr<TransactionDBCondVar> cv;
+};
+
 struct LockInfo {
   bool exclusive;
   autovector<TransactionID> txn_ids;
@@ -32,6 +47,13 @@ struct LockInfo {
   // Transaction locks are not valid after this time in us
   uint64_t expiration_time;
 
+  // FIFO of the transactions waiting for this key. A key with waiters is not
+  // unlocked, it is handed over to the first waiter (or to all the leading
+  // waiters for a shared lock). The others stay queued and are woken up to
+  // wait for the new holders, see HandOver().
+  KeyLockWaiter* waiters_head = nullptr;
+  KeyLockWaiter* waiters_tail = nullptr;
+
   LockInfo(TransactionID id, uint64_t time, bool ex)
       : exclusive(ex), expiration_time(time) {
     txn_ids.push_back(id);
@@ -39,28 +61,187 @@ struct LockInfo {
   LockInfo(const LockInfo& lock_info)
       : exclusive(lock_info.exclusive),
         txn_ids(lock_info.txn_ids),
-        expiration_time(lock_info.expiration_time) {}
+        expiration_time(lock_info.expiration_time),
+        waiters_head(lock_info.waiters_head),
+        waiters_tail(lock_info.waiters_tail) {}
   void operator=(const LockInfo& lock_info) {
     exclusive = lock_info.exclusive;
     txn_ids = lock_info.txn_ids;
     expiration_time = lock_info.expiration_time;
+    waiters_head = lock_info.waiters_head;
+    waiters_tail = lock_info.waiters_tail;
   }
   DECLARE_DEFAULT_MOVES(LockInfo);
+
+  void AddWaiter(KeyLockWaiter* waiter) {
+    waiter->next = nullptr;
+    if (waiters_tail) {
+      waiters_tail->next = waiter;
+    } else {
+      waiters_head = waiter;
+    }
+    waiters_tail = waiter;
+  }
+
+  void RemoveWaiter(KeyLockWaiter* waiter) {
+    KeyLockWaiter* prev = nullptr;
+    for (KeyLockWaiter* w = waiters_head; w; prev = w, w = w->next) {
+      if (w == waiter) {
+        (prev ? prev->next : waiters_head) = w->next;
+        if (waiters_tail == w) {
+          waiters_tail = prev;
+        }
+        return;
+      }
+    }
+    assert(false);
+  }
+
+  void Grant(KeyLockWaiter* waiter) {
+    RemoveWaiter(waiter);
+    txn_ids.push_back(waiter->txn_id);
+    expiration_time = std::max(expiration_time, waiter->expiration_time);
+    waiter->granted = true;
+    waiter->cv->Notify();
+  }
+
+  // Called when some holders released the lock, the caller holds the stripe
+  // mutex. The waiters left in the queue registered their wait on the former
+  // holders for deadlock detection, they are woken up to register it again
+  // on the new ones.
+  void HandOver() {
+    if (txn_ids.empty()) {
+      // Grant the first waiter and the shared waiters following it
+      exclusive = waiters_head->exclusive;
+      expiration_time = 0;
+      do {
+        Grant(waiters_head);
+      } while (!exclusive && waiters_head && !waiters_head->exclusive);
+    } else if (txn_ids.size() == 1) {
+      // The remaining holder may be waiting to upgrade its shared lock
+      for (KeyLockWaiter* w = waiters_head; w; w = w->next) {
+        if (w->txn_id == txn_ids[0]) {
+          assert(w->exclusive);
+          txn_ids.clear();
+          exclusive = true;
+          expiration_time = 0;
+          Grant(w);
+          break;
+        }
+      }
+    }
+    for (KeyLockWaiter* w = waiters_head; w; w = w->next) {
+      w->cv->Notify();
+    }
+  }
+};
+
+// Shared locks granted without the stripe mutex, see
+// TransactionDBOptions::lock_free_shared_locks. A holder claims a slot with
+// its txn id and the hash of the key. A key is only locked this way while
+// its bucket is not busy: no key of the bucket is in LockMapStripe::keys and
+// no exclusive lock is being requested on it. An exclusive request first
+// makes the bucket busy and then looks for holders in the slots, while a
+// shared request first fills its slot and then checks the bucket. Both use
+// seq_cst, so at least one of them sees the other.
+struct FastSharedLocks {
+  static constexpr size_t kBuckets = 64;
+  static constexpr size_t kSlots = 32;
+
+  struct Slot {
+    std::atomic<TransactionID> txn_id{0};
+    std::atomic<uint64_t> key_hash{0};
+  };
+
+  // Keys in LockMapStripe::keys plus pending exclusive requests, per bucket.
+  // Only modified with the stripe mutex held.
+  std::atomic<uint32_t> busy[kBuckets] = {};
+  Slot slots[kSlots];
+
+  template <class Str>
+  static uint64_t Hash(const Str& key) {
+    uint64_t h = GetSliceHash64(Slice(key.data(), key.size()));
+    return h ? h : 1;  // 0 is a free slot
+  }
+
+  std::atomic<uint32_t>& Busy(uint64_t key_hash) {
+    return busy[key_hash % kBuckets];
+  }
+
+  // Returns true if the lock was granted. On false, the caller must wake up
+  // the exclusive requests which may have seen the slot before it was
+  // released.
+  bool TryLock(TransactionID txn_id, uint64_t key_hash, bool* released) {
+    for (Slot& slot : slots) {
+      TransactionID expected = 0;
+      if (slot.txn_id.load(std::memory_order_relaxed) == 0 &&
+          slot.txn_id.compare_exchange_strong(expected, txn_id)) {
+        slot.key_hash.store(key_hash);
+        if (Busy(key_hash).load() == 0) {
+          return true;
+        }
+        Release(slot);
+        *released = true;
+        return false;
+      }
+    }
+    return false;  // all slots are used
+  }
+
+  // Returns true if txn_id held a lock on the key
+  bool UnLock(TransactionID txn_id, uint64_t key_hash) {
+    for (Slot& slot : slots) {
+      if (slot.txn_id.load(std::memory_order_relaxed) == txn_id &&
+          slot.key_hash.load(std::memory_order_relaxed) == key_hash) {
+        Release(slot);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Append the holders of the key other than txn_id to *txn_ids
+  void GetHolders(TransactionID txn_id, uint64_t key_hash,
+                  autovector<TransactionID>* txn_ids) const {
+    for (const Slot& slot : slots) {
+      // A slot may be released and claimed again while we read it
+      TransactionID id = slot.txn_id.load();
+      if (id != 0 && id != txn_id && slot.key_hash.load() == key_hash &&
+          slot.txn_id.load() == id) {
+        txn_ids->push_back(id);
+      }
+    }
+  }
+
+  static void Release(Slot& slot) {
+    slot.key_hash.store(0);
+    slot.txn_id.store(0);
+  }
 };
 
 struct LockMapStripe {
-  explicit LockMapStripe(TransactionDBMutexFactory* factory) {
+  LockMapStripe(TransactionDBMutexFactory* factory, bool lock_free_shared) {
     stripe_mutex = factory->AllocateMutex();
     stripe_cv = factory->AllocateCondVar();
     assert(stripe_mutex);
     assert(stripe_cv);
+    if (lock_free_shared) {
+      fast_shared.reset(new FastSharedLocks);
+    }
   }
 
   // Mutex must be held before modifying keys map
   std::shared_ptr<TransactionDBMutex> stripe_mutex;
 
-  // Condition Variable per stripe for waiting on a lock
+  // Condition Variable per stripe for waiting on a lock which can not be
+  // inserted into keys because of max_num_locks, or for the lock-free shared
+  // holders of a key. Waiters for a key locked in keys wait on the condition
+  // variable of their KeyLockWaiter.
   std::shared_ptr<TransactionDBCondVar> stripe_cv;
+  int stripe_cv_waiters = 0;
+
+  // Condition variables for KeyLockWaiter, reused across waits
+  std::vector<std::shared_ptr<TransactionDBCondVar>> waiter_cvs;
 
   // Locked keys mapped to the info about the transactions that locked them.
   // TODO(agiardullo): Explore performance of other data structures.
@@ -77,12 +258,16 @@ struct LockMapStripe {
   };
   KeyStrMap keys;
 #endif
+
+  // nullptr unless TransactionDBOptions::lock_free_shared_locks
+  std::unique_ptr<FastSharedLocks> fast_shared;
 };
 
 // Map of #num_stripes LockMapStripes
 struct LockMap {
   explicit LockMap(uint16_t key_prefix_len, uint16_t super_stripes,
-                   size_t num_stripes, TransactionDBMutexFactory* factory) {
+                   size_t num_stripes, TransactionDBMutexFactory* factory,
+                   bool lock_free_shared) {
     key_prefix_len_ = std::min<uint16_t>(8, key_prefix_len);
     if (0 == key_prefix_len)
       super_stripes_ = 1;
@@ -91,7 +276,7 @@ struct LockMap {
     num_stripes_ = uint32_t(std::max<size_t>(1, num_stripes));
     lock_map_stripes_.reserve(num_stripes);
     for (size_t i = 0; i < num_stripes * super_stripes; i++) {
-      LockMapStripe* stripe = new LockMapStripe(factory);
+      LockMapStripe* stripe = new LockMapStripe(factory, lock_free_shared);
       lock_map_stripes_.push_back(stripe);
     }
   }
@@ -135,9 +320,14 @@ PointLockManager::PointLockManager(PessimisticTransactionDB* txn_db,
       super_stripes_(opt.super_stripes),
       default_num_stripes_(opt.num_stripes),
       max_num_locks_(opt.max_num_locks),
+      lock_free_shared_locks_(opt.lock_free_shared_locks),
 #if defined(ROCKSDB_DYNAMIC_CREATE_CF)
       lock_maps_cache_(&UnrefLockMapsCache),
 #endif
+      stats_(txn_db ? static_cast_with_check<DBImpl>(txn_db->GetRootDB())
+                          ->immutable_db_options()
+                          .statistics.get()
+                    : nullptr),
       dlock_buffer_(opt.max_num_deadlocks),
       mutex_factory_(opt.custom_mutex_factory
                          ? opt.custom_mutex_factory
@@ -163,7 +353,8 @@ void PointLockManager::AddColumnFamily(const ColumnFamilyHandle* cf) {
   auto& lock_map = lock_maps_[cf->GetID()];
   if (!lock_map) {
     lock_map = std::make_shared<LockMap>(key_prefix_len_,
-        super_stripes_, default_num_stripes_, mutex_factory_.get());
+        super_stripes_, default_num_stripes_, mutex_factory_.get(),
+        lock_free_shared_locks_);
   } else {
     // column_family already exists in lock map
     assert(false);
@@ -290,6 +481,12 @@ Status PointLockManager::TryLock(PessimisticTransaction* txn,
   assert(lock_map->lock_map_stripes_.size() > stripe_num);
   LockMapStripe* stripe = lock_map->lock_map_stripes_[stripe_num];
 
+  // An expiring lock must be in keys to be stolen
+  if (!exclusive && stripe->fast_shared && txn->GetExpirationTime() == 0 &&
+      TryLockFastShared(txn->GetID(), lock_map, stripe, key)) {
+    return Status::OK();
+  }
+
   LockInfo lock_info(txn->GetID(), txn->GetExpirationTime(), exclusive);
   int64_t timeout = txn->GetLockTimeout();
 
@@ -297,6 +494,63 @@ Status PointLockManager::TryLock(PessimisticTransaction* txn,
                             timeout, std::move(lock_info));
 }
 
+bool PointLockManager::TryLockFastShared(TransactionID txn_id,
+                                         LockMap* lock_map,
+                                         LockMapStripe* stripe,
+                                         const Slice& key) {
+  FastSharedLocks* fast = stripe->fast_shared.get();
+  uint64_t key_hash = FastSharedLocks::Hash(key);
+  if (fast->Busy(key_hash).load(std::memory_order_relaxed) != 0) {
+    return false;
+  }
+  if (max_num_locks_ > 0 &&
+      lock_map->lock_cnt.load(std::memory_order_acquire) >= max_num_locks_) {
+    return false;  // AcquireLocked() reports the limit
+  }
+  bool released = false;
+  if (fast->TryLock(txn_id, key_hash, &released)) {
+    if (max_num_locks_ > 0) {
+      lock_map->lock_cnt.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+  }
+  if (released) {
+    NotifyStripeWaiters(stripe);
+  }
+  return false;
+}
+
+// Returns true if the key has no lock left to release under the stripe mutex
+bool PointLockManager::UnLockFastShared(TransactionID txn_id,
+                                        LockMap* lock_map,
+                                        LockMapStripe* stripe,
+                                        const LockString& key) {
+  FastSharedLocks* fast = stripe->fast_shared.get();
+  if (!fast) {
+    return false;
+  }
+  uint64_t key_hash = FastSharedLocks::Hash(key);
+  if (!fast->UnLock(txn_id, key_hash)) {
+    return false;
+  }
+  if (max_num_locks_ > 0) {
+    assert(lock_map->lock_cnt.load(std::memory_order_relaxed) > 0);
+    lock_map->lock_cnt--;
+  }
+  // Otherwise the key may also be in keys, or an exclusive request may be
+  // waiting for us
+  return fast->Busy(key_hash).load() == 0;
+}
+
+void PointLockManager::NotifyStripeWaiters(LockMapStripe* stripe) {
+  stripe->stripe_mutex->Lock().PermitUncheckedError();
+  const bool notify_stripe = stripe->stripe_cv_waiters > 0;
+  stripe->stripe_mutex->UnLock();
+  if (notify_stripe) {
+    stripe->stripe_cv->NotifyAll();
+  }
+}
+
 // Helper function for TryLock().
 Status PointLockManager::AcquireWithTimeout(
     PessimisticTransaction* txn, LockMap* lock_map, LockMapStripe* stripe,
@@ -322,15 +576,44 @@ Status PointLockManager::AcquireWithTimeout(
     return result;
   }
 
+  // An exclusive request keeps new shared locks of the bucket in keys until
+  // it is done, and waits for the lock-free holders of the key first.
+  FastSharedLocks* fast = lock_info.exclusive ? stripe->fast_shared.get()
+                                              : nullptr;
+  uint64_t key_hash = 0;
+  if (fast) {
+    key_hash = FastSharedLocks::Hash(key);
+    fast->Busy(key_hash).fetch_add(1);
+  }
+  bool wait_fast_shared = false;
+
   // Acquire lock if we are able to
   uint64_t expire_time_hint = 0;
   autovector<TransactionID> wait_ids(0); // init to size and cap = 0
-  result = AcquireLocked(lock_map, stripe, key, env, std::move(lock_info),
+  auto acquire = [&]() {
+    if (fast) {
+      wait_ids.clear();
+      fast->GetHolders(txn->GetID(), key_hash, &wait_ids);
+      wait_fast_shared = !wait_ids.empty();
+      if (wait_fast_shared) {
+        expire_time_hint = 0;
+        return Status::TimedOut(Status::SubCode::kLockTimeout);
+      }
+    }
+    return AcquireLocked(lock_map, stripe, key, env, std::move(lock_info),
                          &expire_time_hint, &wait_ids);
+  };
+  result = acquire();
 
   if (!result.ok() && timeout != 0) {
     PERF_TIMER_GUARD(key_lock_wait_time);
     PERF_COUNTER_ADD(key_lock_wait_count, 1);
+    const uint64_t wait_start = env->NowMicros();
+    KeyLockWaiter waiter;
+    waiter.txn_id = lock_info.txn_ids[0];
+    waiter.exclusive = lock_info.exclusive;
+    waiter.expiration_time = lock_info.expiration_time;
+    bool queued = false;
     // If we weren't able to acquire the lock, we will keep retrying as long
     // as the timeout allows.
     bool timed_out = false;
@@ -354,6 +637,12 @@ Status PointLockManager::AcquireWithTimeout(
           if (IncrementWaiters(txn, wait_ids, key, column_family_id,
                                lock_info.exclusive, env)) {
             result = Status::Busy(Status::SubCode::kDeadlock);
+            if (queued) {
+              RemoveKeyLockWaiter(stripe, key, &waiter);
+            }
+            if (fast) {
+              fast->Busy(key_hash).fetch_sub(1);
+            }
             stripe->stripe_mutex->UnLock();
             return result;
           }
@@ -361,17 +650,43 @@ Status PointLockManager::AcquireWithTimeout(
         txn->SetWaitingTxn(wait_ids, column_family_id, &key);
       }
 
+      // Wait on the key if it is locked, or on the stripe if the lock could
+      // not be inserted because of max_num_locks or the key has lock-free
+      // shared holders. The lock must not be handed over to us before they
+      // are gone, new ones can't come while our request is pending.
+      std::shared_ptr<TransactionDBCondVar>* cv = &stripe->stripe_cv;
+      if (!queued && !wait_fast_shared) {
+        size_t idx = stripe->keys.find_i(key);
+        if (idx != stripe->keys.end_i()) {
+          if (stripe->waiter_cvs.empty()) {
+            waiter.cv = mutex_factory_->AllocateCondVar();
+          } else {
+            waiter.cv = std::move(stripe->waiter_cvs.back());
+            stripe->waiter_cvs.pop_back();
+          }
+          stripe->keys.val(idx).AddWaiter(&waiter);
+          queued = true;
+        }
+      }
+      if (queued) {
+        cv = &waiter.cv;
+      } else {
+        stripe->stripe_cv_waiters++;
+      }
+
       TEST_SYNC_POINT("PointLockManager::AcquireWithTimeout:WaitingTxn");
       if (cv_end_time < 0) {
         // Wait indefinitely
-        result = stripe->stripe_cv->Wait(stripe->stripe_mutex);
+        result = (*cv)->Wait(stripe->stripe_mutex);
       } else {
         uint64_t now = env->NowMicros();
         if (static_cast<uint64_t>(cv_end_time) > now) {
-          result = stripe->stripe_cv->WaitFor(stripe->stripe_mutex,
-                                              cv_end_time - now);
+          result = (*cv)->WaitFor(stripe->stripe_mutex, cv_end_time - now);
         }
       }
+      if (!queued) {
+        stripe->stripe_cv_waiters--;
+      }
 
       if (!wait_ids.empty()) {
         txn->ClearWaitingTxn();
@@ -380,6 +695,12 @@ Status PointLockManager::AcquireWithTimeout(
         }
       }
 
+      if (waiter.granted) {
+        // The lock was handed over by UnLockKey()
+        result = Status::OK();
+        break;
+      }
+
       if (result.IsTimedOut()) {
         timed_out = true;
         // Even though we timed out, we will still make one more attempt to
@@ -388,10 +709,28 @@ Status PointLockManager::AcquireWithTimeout(
       }
 
       if (result.ok() || result.IsTimedOut()) {
-        result = AcquireLocked(lock_map, stripe, key, env, std::move(lock_info),
-                               &expire_time_hint, &wait_ids);
+        result = acquire();
       }
     } while (!result.ok() && !timed_out);
+
+    if (queued) {
+      if (waiter.granted) {
+        stripe->waiter_cvs.push_back(std::move(waiter.cv));
+      } else {
+        RemoveKeyLockWaiter(stripe, key, &waiter);
+      }
+    }
+    RecordTimeToHistogram(stats_, KEY_LOCK_WAIT_MICROS,
+                          env->NowMicros() - wait_start);
+  }
+
+  if (fast) {
+    // Upgrading our own lock-free shared lock, which keys holds now
+    if (result.ok() && fast->UnLock(txn->GetID(), key_hash) &&
+        max_num_locks_ > 0) {
+      lock_map->lock_cnt--;
+    }
+    fast->Busy(key_hash).fetch_sub(1);
   }
 
   stripe->stripe_mutex->UnLock();
@@ -588,8 +927,8 @@ Status PointLockManager::AcquireLocked(LockMap* lock_map, LockMapStripe* stripe,
       lock_info.expiration_time =
           std::max(lock_info.expiration_time, txn_lock_info.expiration_time);
     }
-  } else {  // Lock not held.
-  // do nothing
+  } else if (stripe->fast_shared && result.ok()) {  // Lock not held, inserted
+    stripe->fast_shared->Busy(FastSharedLocks::Hash(key)).fetch_add(1);
   }
 
   return result;
@@ -609,8 +948,19 @@ void PointLockManager::UnLockKey(PessimisticTransaction* txn,
     auto txn_it = std::find(txns.begin(), txns.end(), txn_id);
     // Found the key we locked.  unlock it.
     if (txn_it != txns.end()) {
+      LockInfo& lock_info = stripe_iter->second;
+      if (lock_info.waiters_head) {
+        // The key stays locked by the waiters it is handed over to
+        *txn_it = std::move(txns.back());
+        txns.pop_back();
+        lock_info.HandOver();
+        return;
+      }
       if (txns.num_stack_items() == 1) {
         stripe->keys.erase(stripe_iter);
+        if (stripe->fast_shared) {
+          stripe->fast_shared->Busy(FastSharedLocks::Hash(key)).fetch_sub(1);
+        }
       } else {
         *txn_it = std::move(txns.back());
         txns.pop_back();
@@ -624,9 +974,11 @@ void PointLockManager::UnLockKey(PessimisticTransaction* txn,
     }
   } else {
     // This key is either not locked or locked by someone else.  This should
-    // only happen if the unlocking transaction has expired.
-    assert(txn->GetExpirationTime() > 0 &&
-           txn->GetExpirationTime() < env->NowMicros());
+    // only happen if the unlocking transaction has expired, or if it only
+    // held a lock-free shared lock.
+    assert(stripe->fast_shared ||
+           (txn->GetExpirationTime() > 0 &&
+            txn->GetExpirationTime() < env->NowMicros()));
   }
 }
 
@@ -643,13 +995,29 @@ void PointLockManager::UnLock(PessimisticTransaction* txn,
   size_t stripe_num = lock_map->GetStripe(key);
   assert(lock_map->lock_map_stripes_.size() > stripe_num);
   LockMapStripe* stripe = lock_map->lock_map_stripes_[stripe_num];
+  if (UnLockFastShared(txn->GetID(), lock_map, stripe, key)) {
+    return;
+  }
 
   stripe->stripe_mutex->Lock().PermitUncheckedError();
   UnLockKey(txn, key, stripe, lock_map, env);
+  const bool notify_stripe = stripe->stripe_cv_waiters > 0;
   stripe->stripe_mutex->UnLock();
 
-  // Signal waiting threads to retry locking
-  stripe->stripe_cv->NotifyAll();
+  // Signal threads waiting for the lock limit to retry locking
+  if (notify_stripe) {
+    stripe->stripe_cv->NotifyAll();
+  }
+}
+
+void PointLockManager::RemoveKeyLockWaiter(LockMapStripe* stripe,
+                                           const Slice& key,
+                                           KeyLockWaiter* waiter) {
+  // A key is not unlocked while it has waiters
+  size_t idx = stripe->keys.find_i(key);
+  assert(idx != stripe->keys.end_i());
+  stripe->keys.val(idx).RemoveWaiter(waiter);
+  stripe->waiter_cvs.push_back(std::move(waiter->cv));
 }
 
 void PointLockManager::UnLock(PessimisticTransaction* txn,
@@ -671,6 +1039,10 @@ void PointLockManager::UnLock(PessimisticTransaction* txn,
       if (!keyinfos.is_deleted(idx)) {
         const fstring key = keyinfos.key(idx);
         size_t strip_idx = lock_map->GetStripe(key);
+        if (UnLockFastShared(txn->GetID(), lock_map,
+                             lock_map->lock_map_stripes_[strip_idx], key)) {
+          continue;
+        }
         keys_link[idx] = stripe_heads[strip_idx]; // insert to single
         stripe_heads[strip_idx] = uint32_t(idx);  // list front
       }
@@ -684,8 +1056,11 @@ void PointLockManager::UnLock(PessimisticTransaction* txn,
         const fstring key = keyinfos.key(idx);
         UnLockKey(txn, key, stripe, lock_map, env);
       }
+      const bool notify_stripe = stripe->stripe_cv_waiters > 0;
       stripe->stripe_mutex->UnLock();
-      stripe->stripe_cv->NotifyAll();
+      if (notify_stripe) {
+        stripe->stripe_cv->NotifyAll();
+      }
     }
   }
 }
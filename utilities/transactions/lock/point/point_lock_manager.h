@@ -26,6 +26,7 @@
 namespace ROCKSDB_NAMESPACE {
 
 class ColumnFamilyHandle;
+struct KeyLockWaiter;
 struct LockInfo;
 struct LockMap;
 struct LockMapStripe;
@@ -168,6 +169,9 @@ class PointLockManager : public LockManager {
   // Limit on number of keys locked per column family
   const int64_t max_num_locks_;
 
+  // See TransactionDBOptions::lock_free_shared_locks
+  const bool lock_free_shared_locks_;
+
   // The following lock order must be satisfied in order to avoid deadlocking
   // ourselves.
   //   - lock_map_mutex_
@@ -197,6 +201,9 @@ class PointLockManager : public LockManager {
   // Must be held when modifying wait_txn_map_ and rev_wait_txn_map_.
   std::mutex wait_txn_map_mutex_;
 
+  // For KEY_LOCK_WAIT_MICROS, may be nullptr
+  Statistics* const stats_;
+
   // Maps from waitee -> number of waiters.
   HashMap<TransactionID, int> rev_wait_txn_map_;
   // Maps from waiter -> waitee.
@@ -223,6 +230,20 @@ class PointLockManager : public LockManager {
   void UnLockKey(PessimisticTransaction* txn, const LockString& key,
                  LockMapStripe* stripe, LockMap* lock_map, Env* env);
 
+  // Lock-free shared locks, TryLockFastShared() REQUIRES stripe->fast_shared
+  bool TryLockFastShared(TransactionID txn_id, LockMap* lock_map,
+                         LockMapStripe* stripe, const Slice& key);
+  bool UnLockFastShared(TransactionID txn_id, LockMap* lock_map,
+                        LockMapStripe* stripe, const LockString& key);
+
+  // Wake up the waiters on stripe_cv
+  void NotifyStripeWaiters(LockMapStripe* stripe);
+
+  // Remove a waiter which was not granted the lock from the key.
+  // REQUIRED:  Stripe mutex must be held.
+  void RemoveKeyLockWaiter(LockMapStripe* stripe, const Slice& key,
+                           KeyLockWaiter* waiter);
+
   bool IncrementWaiters(const PessimisticTransaction* txn,
                         const autovector<TransactionID>& wait_ids,
                         const Slice& key, const uint32_t& cf_id,
@@ -0,0 +1,141 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#ifndef ROCKSDB_LITE
+
+#ifndef GFLAGS
+#include <cstdio>
+int main() {
+  fprintf(stderr, "Please install gflags to run rocksdb tools\n");
+  return 1;
+}
+#else
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/db.h"
+#include "rocksdb/env.h"
+#include "rocksdb/system_clock.h"
+#include "rocksdb/utilities/transaction_db.h"
+#include "util/gflags_compat.h"
+#include "util/stop_watch.h"
+#include "utilities/transactions/lock/point/point_lock_manager.h"
+#include "utilities/transactions/pessimistic_transaction_db.h"
+
+using GFLAGS_NAMESPACE::ParseCommandLineFlags;
+
+DEFINE_int32(threads, 8, "number of transactions locking concurrently");
+
+DEFINE_int32(iterations, 100000, "lock/unlock pairs per thread");
+
+DEFINE_int32(num_keys, 1,
+             "number of keys the threads lock in turn, 1 is a single hot key "
+             "like a counter row");
+
+DEFINE_bool(exclusive, true, "take exclusive locks, else shared ones");
+
+DEFINE_bool(lock_free_shared_locks, false,
+            "TransactionDBOptions::lock_free_shared_locks");
+
+DEFINE_string(db, "",
+              "directory of the TransactionDB the transactions come from, "
+              "default is a directory under Env::GetTestDirectory()");
+
+int main(int argc, char** argv) {
+  ParseCommandLineFlags(&argc, &argv, true);
+  using namespace ROCKSDB_NAMESPACE;
+
+  Env* env = Env::Default();
+  std::string db_path = FLAGS_db;
+  if (db_path.empty()) {
+    Status s = env->GetTestDirectory(&db_path);
+    if (!s.ok()) {
+      std::cerr << s.ToString() << std::endl;
+      return 1;
+    }
+    db_path += "/point_lock_manager_bench";
+  }
+
+  Options options;
+  options.create_if_missing = true;
+  TransactionDBOptions txn_db_options;
+  txn_db_options.lock_free_shared_locks = FLAGS_lock_free_shared_locks;
+  TransactionDB* db = nullptr;
+  Status s = TransactionDB::Open(options, txn_db_options, db_path, &db);
+  if (!s.ok()) {
+    std::cerr << s.ToString() << std::endl;
+    return 1;
+  }
+
+  // A lock manager of its own, the transactions are only used as lock owners
+  PointLockManager locker(static_cast<PessimisticTransactionDB*>(db),
+                          txn_db_options);
+  locker.AddColumnFamily(db->DefaultColumnFamily());
+  const ColumnFamilyId cf_id = db->DefaultColumnFamily()->GetID();
+
+  std::vector<std::string> keys;
+  for (int i = 0; i < FLAGS_num_keys; i++) {
+    keys.push_back("key" + std::to_string(i));
+  }
+
+  TransactionOptions txn_options;
+  txn_options.lock_timeout = 10000000;
+  std::vector<PessimisticTransaction*> txns;
+  for (int i = 0; i < FLAGS_threads; i++) {
+    txns.push_back(static_cast<PessimisticTransaction*>(
+        db->BeginTransaction(WriteOptions(), txn_options)));
+  }
+
+  std::atomic<uint64_t> failures{0};
+  std::vector<port::Thread> threads;
+  StopWatchNano timer(SystemClock::Default().get(), true /* auto_start */);
+  for (int i = 0; i < FLAGS_threads; i++) {
+    threads.emplace_back([&, i]() {
+      PessimisticTransaction* txn = txns[i];
+      for (int j = 0; j < FLAGS_iterations; j++) {
+        const std::string& key = keys[(i + j) % keys.size()];
+        if (locker.TryLock(txn, cf_id, key, env, FLAGS_exclusive).ok()) {
+          locker.UnLock(txn, cf_id, key, env);
+        } else {
+          failures++;
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  const uint64_t elapsed_nanos = timer.ElapsedNanos();
+
+  const uint64_t ops = uint64_t(FLAGS_threads) * FLAGS_iterations;
+  std::cout << "threads: " << FLAGS_threads << ", keys: " << FLAGS_num_keys
+            << ", " << (FLAGS_exclusive ? "exclusive" : "shared") << "\n"
+            << ops << " lock/unlock in " << elapsed_nanos / 1000 << " us, "
+            << elapsed_nanos / double(ops) << " ns/op, " << failures.load()
+            << " failed\n";
+
+  for (auto txn : txns) {
+    delete txn;
+  }
+  locker.RemoveColumnFamily(db->DefaultColumnFamily());
+  delete db;
+  DestroyDB(db_path, options).PermitUncheckedError();
+  return failures.load() == 0 ? 0 : 1;
+}
+
+#endif  // GFLAGS
+#else
+#include <cstdio>
+int main() {
+  fprintf(stderr, "Transactions are not supported in ROCKSDB_LITE\n");
+  return 1;
+}
+#endif  // ROCKSDB_LITE
@@ -158,6 +158,202 @@ TEST_F(PointLockManagerTest, DeadlockDepthExceeded) {
   delete txn1;
 }
 
+TEST_F(PointLockManagerTest, HandOverToWaiters) {
+  // Tests that a released lock is handed over to its waiters in FIFO order,
+  // with all the leading shared waiters granted together.
+  MockColumnFamilyHandle cf(1);
+  locker_->AddColumnFamily(&cf);
+  TransactionOptions txn_opt;
+  txn_opt.lock_timeout = 1000000;
+  auto txn1 = NewTxn(txn_opt);
+  auto txn2 = NewTxn(txn_opt);
+  auto txn3 = NewTxn(txn_opt);
+  auto txn4 = NewTxn(txn_opt);
+
+  ASSERT_OK(locker_->TryLock(txn1, 1, "k", env_, true));
+  port::Thread t2 = BlockUntilWaitingTxn(wait_sync_point_name_, [&]() {
+    ASSERT_OK(locker_->TryLock(txn2, 1, "k", env_, true));
+  });
+  port::Thread t3 = BlockUntilWaitingTxn(wait_sync_point_name_, [&]() {
+    ASSERT_OK(locker_->TryLock(txn3, 1, "k", env_, false));
+  });
+  port::Thread t4 = BlockUntilWaitingTxn(wait_sync_point_name_, [&]() {
+    ASSERT_OK(locker_->TryLock(txn4, 1, "k", env_, false));
+  });
+
+  locker_->UnLock(txn1, 1, "k", env_);
+  t2.join();
+  auto status = locker_->GetPointLockStatus();
+  ASSERT_EQ(status.size(), 1u);
+  ASSERT_TRUE(status.begin()->second.exclusive);
+  ASSERT_EQ(status.begin()->second.ids,
+            std::vector<TransactionID>{txn2->GetID()});
+
+  locker_->UnLock(txn2, 1, "k", env_);
+  t3.join();
+  t4.join();
+  status = locker_->GetPointLockStatus();
+  ASSERT_EQ(status.size(), 1u);
+  ASSERT_FALSE(status.begin()->second.exclusive);
+  ASSERT_EQ(status.begin()->second.ids.size(), 2u);
+
+  locker_->UnLock(txn3, 1, "k", env_);
+  locker_->UnLock(txn4, 1, "k", env_);
+  ASSERT_EQ(locker_->GetPointLockStatus().size(), 0u);
+
+  delete txn4;
+  delete txn3;
+  delete txn2;
+  delete txn1;
+}
+
+TEST_F(PointLockManagerTest, DeadlockAfterHandOver) {
+  // Tests that the waiters left in the queue of a handed over lock wait for
+  // its new holder: txn3 ->(k) txn2 ->(j) txn3 is detected although txn3
+  // started to wait on k while txn1 held it.
+  MockColumnFamilyHandle cf(1);
+  locker_->AddColumnFamily(&cf);
+  TransactionOptions txn_opt;
+  txn_opt.deadlock_detect = true;
+  txn_opt.lock_timeout = 1000000;
+  auto txn1 = NewTxn(txn_opt);
+  auto txn2 = NewTxn(txn_opt);
+  auto txn3 = NewTxn(txn_opt);
+
+  ASSERT_OK(locker_->TryLock(txn1, 1, "k", env_, true));
+  ASSERT_OK(locker_->TryLock(txn3, 1, "j", env_, true));
+  port::Thread t2 = BlockUntilWaitingTxn(wait_sync_point_name_, [&]() {
+    ASSERT_OK(locker_->TryLock(txn2, 1, "k", env_, true));
+  });
+  port::Thread t3 = BlockUntilWaitingTxn(wait_sync_point_name_, [&]() {
+    ASSERT_OK(locker_->TryLock(txn3, 1, "k", env_, true));
+  });
+
+  // k is handed over to txn2, txn3 waits again, now on txn2
+  std::atomic<int> waits(0);
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      wait_sync_point_name_, [&](void* /*arg*/) { waits++; });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+  locker_->UnLock(txn1, 1, "k", env_);
+  t2.join();
+  while (waits.load() == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  auto s = locker_->TryLock(txn2, 1, "j", env_, true);
+  ASSERT_TRUE(s.IsBusy());
+  ASSERT_EQ(s.subcode(), Status::SubCode::kDeadlock);
+  std::vector<DeadlockPath> deadlock_paths = locker_->GetDeadlockInfoBuffer();
+  ASSERT_EQ(deadlock_paths.size(), 1u);
+  ASSERT_FALSE(deadlock_paths[0].limit_exceeded);
+
+  locker_->UnLock(txn2, 1, "k", env_);
+  t3.join();
+  locker_->UnLock(txn3, 1, "k", env_);
+  locker_->UnLock(txn3, 1, "j", env_);
+  ASSERT_EQ(locker_->GetPointLockStatus().size(), 0u);
+
+  delete txn3;
+  delete txn2;
+  delete txn1;
+}
+
+TEST_F(PointLockManagerTest, ContendedKey) {
+  // Many transactions repeatedly locking one hot key, like a counter row
+  MockColumnFamilyHandle cf(1);
+  locker_->AddColumnFamily(&cf);
+  TransactionOptions txn_opt;
+  txn_opt.lock_timeout = 10000000;
+  constexpr int kThreads = 8;
+  constexpr int kIters = 1000;
+  uint64_t counter = 0;
+  std::vector<PessimisticTransaction*> txns;
+  std::vector<port::Thread> threads;
+  for (int i = 0; i < kThreads; i++) {
+    txns.push_back(NewTxn(txn_opt));
+    threads.emplace_back([&, txn = txns.back()]() {
+      for (int j = 0; j < kIters; j++) {
+        ASSERT_OK(locker_->TryLock(txn, 1, "hot", env_, true));
+        counter++;
+        locker_->UnLock(txn, 1, "hot", env_);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  ASSERT_EQ(counter, uint64_t{kThreads * kIters});
+  ASSERT_EQ(locker_->GetPointLockStatus().size(), 0u);
+  for (auto txn : txns) {
+    delete txn;
+  }
+}
+
+TEST_F(PointLockManagerTest, LockFreeSharedLocks) {
+  TransactionDBOptions txn_db_opt;
+  txn_db_opt.lock_free_shared_locks = true;
+  txn_db_opt.max_num_locks = 2;
+  locker_.reset(new PointLockManager(nullptr, txn_db_opt));
+  MockColumnFamilyHandle cf(1);
+  locker_->AddColumnFamily(&cf);
+  TransactionOptions txn_opt;
+  txn_opt.deadlock_detect = true;
+  txn_opt.lock_timeout = 1000000;
+  auto txn1 = NewTxn(txn_opt);
+  auto txn2 = NewTxn(txn_opt);
+  auto txn3 = NewTxn(txn_opt);
+  txn_opt.lock_timeout = 0;
+  auto txn4 = NewTxn(txn_opt);
+
+  // Shared locks of an unconflicted key stay out of the lock table, but are
+  // counted by max_num_locks
+  ASSERT_OK(locker_->TryLock(txn1, 1, "k", env_, false));
+  ASSERT_OK(locker_->TryLock(txn2, 1, "k", env_, false));
+  ASSERT_EQ(locker_->GetPointLockStatus().size(), 0u);
+  auto s = locker_->TryLock(txn4, 1, "k2", env_, false);
+  ASSERT_TRUE(s.IsBusy());
+  ASSERT_EQ(s.subcode(), Status::SubCode::kLockLimit);
+
+  // An exclusive lock waits for them
+  port::Thread t3 = BlockUntilWaitingTxn(wait_sync_point_name_, [&]() {
+    ASSERT_OK(locker_->TryLock(txn3, 1, "k", env_, true));
+  });
+  locker_->UnLock(txn1, 1, "k", env_);
+  locker_->UnLock(txn2, 1, "k", env_);
+  t3.join();
+  auto status = locker_->GetPointLockStatus();
+  ASSERT_EQ(status.size(), 1u);
+  ASSERT_TRUE(status.begin()->second.exclusive);
+  ASSERT_EQ(status.begin()->second.ids,
+            std::vector<TransactionID>{txn3->GetID()});
+  locker_->UnLock(txn3, 1, "k", env_);
+
+  // Deadlocks involving them are detected:
+  // txn1 ->(b) txn2 ->(a) txn1
+  ASSERT_OK(locker_->TryLock(txn1, 1, "a", env_, false));
+  ASSERT_OK(locker_->TryLock(txn2, 1, "b", env_, true));
+  port::Thread t2 = BlockUntilWaitingTxn(wait_sync_point_name_, [&]() {
+    ASSERT_OK(locker_->TryLock(txn2, 1, "a", env_, true));
+  });
+  s = locker_->TryLock(txn1, 1, "b", env_, true);
+  ASSERT_TRUE(s.IsBusy());
+  ASSERT_EQ(s.subcode(), Status::SubCode::kDeadlock);
+  ASSERT_EQ(locker_->GetDeadlockInfoBuffer().size(), 1u);
+
+  locker_->UnLock(txn1, 1, "a", env_);
+  t2.join();
+  locker_->UnLock(txn2, 1, "a", env_);
+  locker_->UnLock(txn2, 1, "b", env_);
+  ASSERT_EQ(locker_->GetPointLockStatus().size(), 0u);
+
+  delete txn4;
+  delete txn3;
+  delete txn2;
+  delete txn1;
+}
+
 INSTANTIATE_TEST_CASE_P(PointLockManager, AnyLockManagerTest,
                         ::testing::Values(nullptr));
 
@@ -67,6 +67,8 @@ Status OptimisticTransaction::Commit() {
       return CommitWithParallelValidate();
     case OccValidationPolicy::kValidateSerial:
       return CommitWithSerialValidate();
+    case OccValidationPolicy::kValidateGroupCommit:
+      return CommitWithGroupValidate();
     default:
       assert(0);
   }
@@ -91,6 +93,29 @@ Status OptimisticTransaction::CommitWithSerialValidate() {
   return s;
 }
 
+Status OptimisticTransaction::CommitWithGroupValidate() {
+  DBImpl* db_impl = static_cast_with_check<DBImpl>(db_->GetRootDB());
+  const auto& db_options = db_impl->immutable_db_options();
+  if (db_options.enable_pipelined_write || db_options.unordered_write) {
+    // The WAL leader of these modes validates while the previous group may
+    // still be inserting into the memtable
+    return CommitWithSerialValidate();
+  }
+
+  // Conflicting txns of the group fail their callbacks and are left out of
+  // the group's WAL write and memtable insert
+  OptimisticTransactionCallback callback(this, true /* group_validate */);
+
+  Status s = db_impl->WriteWithCallback(
+      write_options_, GetWriteBatch()->GetWriteBatch(), &callback);
+
+  if (s.ok()) {
+    Clear();
+  }
+
+  return s;
+}
+
 Status OptimisticTransaction::CommitWithParallelValidate() {
   auto txn_db_impl = static_cast_with_check<OptimisticTransactionDBImpl,
                                             OptimisticTransactionDB>(txn_db_);
@@ -185,6 +210,28 @@ Status OptimisticTransaction::CheckTransactionForConflicts(DB* db) {
                                                 true /* cache_only */);
 }
 
+Status OptimisticTransaction::CheckTransactionForConflicts(
+    DB* db, const WriteGroupKeys& group_keys) {
+  // The txns before this one in the group are not in the memtable yet, but
+  // they get smaller sequence numbers, so each of their keys conflicts
+  std::unique_ptr<LockTracker::ColumnFamilyIterator> cf_it(
+      tracked_locks_->GetColumnFamilyIterator());
+  assert(cf_it != nullptr);
+  while (cf_it->HasNext()) {
+    ColumnFamilyId cf = cf_it->Next();
+    std::unique_ptr<LockTracker::KeyIterator> key_it(
+        tracked_locks_->GetKeyIterator(cf));
+    assert(key_it != nullptr);
+    while (key_it->HasNext()) {
+      const auto& key = key_it->Next();
+      if (group_keys.Contains(cf, Slice(key.data(), key.size()))) {
+        return Status::Busy("Write Conflict");
+      }
+    }
+  }
+  return CheckTransactionForConflicts(db);
+}
+
 Status OptimisticTransaction::SetName(const TransactionName& /* unused */) {
   return Status::InvalidArgument("Optimistic transactions cannot be named.");
 }
@@ -68,6 +68,10 @@ class OptimisticTransaction : public TransactionBaseImpl {
   // Should only be called on writer thread.
   Status CheckTransactionForConflicts(DB* db);
 
+  // CheckTransactionForConflicts(), also against the keys written by the
+  // transactions committed before this one in the same write group.
+  Status CheckTransactionForConflicts(DB* db, const WriteGroupKeys& group_keys);
+
   void Clear() override;
 
   void UnlockGetForUpdate(ColumnFamilyHandle* /* unused */,
@@ -78,22 +82,32 @@ class OptimisticTransaction : public TransactionBaseImpl {
   Status CommitWithSerialValidate();
 
   Status CommitWithParallelValidate();
+
+  Status CommitWithGroupValidate();
 };
 
 // Used at commit time to trigger transaction validation
 class OptimisticTransactionCallback : public WriteCallback {
  public:
-  explicit OptimisticTransactionCallback(OptimisticTransaction* txn)
-      : txn_(txn) {}
+  explicit OptimisticTransactionCallback(OptimisticTransaction* txn,
+                                         bool group_validate = false)
+      : txn_(txn), group_validate_(group_validate) {}
 
   Status Callback(DB* db) override {
     return txn_->CheckTransactionForConflicts(db);
   }
 
-  bool AllowWriteBatching() override { return false; }
+  Status Callback(DB* db, const WriteGroupKeys& group_keys) override {
+    return txn_->CheckTransactionForConflicts(db, group_keys);
+  }
+
+  bool AllowWriteBatching() override { return group_validate_; }
+
+  bool NeedWriteGroupKeys() override { return group_validate_; }
 
  private:
   OptimisticTransaction* txn_;
+  const bool group_validate_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
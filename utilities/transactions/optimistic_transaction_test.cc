@@ -225,6 +225,46 @@ TEST_P(OptimisticTransactionTest, WriteConflict4) {
   delete txn;
 }
 
+TEST_P(OptimisticTransactionTest, ManyKeysConflictTest) {
+  WriteOptions write_options;
+  ReadOptions read_options;
+  std::string value;
+
+  // Tracked keys are validated in one sorted batch, the conflicting key is
+  // in the middle of the batch and the other keys are only in the memtable
+  // history
+  for (int i = 0; i < 100; i++) {
+    ASSERT_OK(txn_db->Put(write_options, "key" + std::to_string(i), "v0"));
+  }
+  ASSERT_OK(txn_db->Flush(FlushOptions()));
+
+  for (int round = 0; round < 2; round++) {
+    Transaction* txn = txn_db->BeginTransaction(write_options);
+    ASSERT_NE(txn, nullptr);
+    for (int i = 99; i >= 0; i--) {
+      Status s = txn->GetForUpdate(read_options, "key" + std::to_string(i),
+                                   &value);
+      ASSERT_OK(s);
+    }
+    ASSERT_OK(txn->Put("key0", "v1"));
+    if (round == 1) {
+      ASSERT_OK(txn_db->Put(write_options, "key42", "v2"));
+    }
+    Status s = txn->Commit();
+    if (round == 0) {
+      ASSERT_OK(s);
+    } else {
+      ASSERT_TRUE(s.IsBusy());
+    }
+    delete txn;
+  }
+
+  ASSERT_OK(txn_db->Get(read_options, "key0", &value));
+  ASSERT_EQ(value, "v1");
+  ASSERT_OK(txn_db->Get(read_options, "key42", &value));
+  ASSERT_EQ(value, "v2");
+}
+
 TEST_P(OptimisticTransactionTest, ReadConflictTest) {
   WriteOptions write_options;
   ReadOptions read_options, snapshot_read_options;
@@ -1422,6 +1462,63 @@ TEST_P(OptimisticTransactionTest, OptimisticTransactionStressTest) {
   ASSERT_OK(s);
 }
 
+TEST_P(OptimisticTransactionTest, GroupCommitConflict) {
+  if (GetParam() != OccValidationPolicy::kValidateGroupCommit) {
+    return;
+  }
+  // txn2 conflicts with txn0 which precedes it in the same write group.
+  // txn3 writes d like txn2, which is not a conflict as txn2 failed.
+  const std::vector<std::vector<std::string>> keys = {
+      {"a"}, {"b"}, {"a", "d"}, {"d"}};
+  const size_t kTxns = keys.size();
+  std::vector<std::unique_ptr<Transaction>> txns;
+  for (size_t i = 0; i < kTxns; i++) {
+    txns.emplace_back(txn_db->BeginTransaction(WriteOptions()));
+    for (const auto& key : keys[i]) {
+      ASSERT_OK(txns[i]->Put(key, "v" + std::to_string(i)));
+    }
+  }
+
+  // The commits are linked one by one, the leader waits for all of them
+  std::atomic<size_t> linked(0);
+  SyncPoint::GetInstance()->SetCallBack("WriteThread::JoinBatchGroup:Wait",
+                                        [&](void*) { linked++; });
+  SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::WriteImpl:BeforeLeaderEnters", [&](void*) {
+        while (linked.load() < kTxns) {
+          std::this_thread::yield();
+        }
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  std::vector<Status> statuses(kTxns);
+  std::vector<port::Thread> threads;
+  for (size_t i = 0; i < kTxns; i++) {
+    threads.emplace_back([&, i]() { statuses[i] = txns[i]->Commit(); });
+    while (linked.load() < i + 1) {
+      std::this_thread::yield();
+    }
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  ASSERT_OK(statuses[0]);
+  ASSERT_OK(statuses[1]);
+  ASSERT_TRUE(statuses[2].IsBusy());
+  ASSERT_OK(statuses[3]);
+
+  std::string value;
+  ASSERT_OK(txn_db->Get(ReadOptions(), "a", &value));
+  ASSERT_EQ(value, "v0");
+  ASSERT_OK(txn_db->Get(ReadOptions(), "b", &value));
+  ASSERT_EQ(value, "v1");
+  ASSERT_OK(txn_db->Get(ReadOptions(), "d", &value));
+  ASSERT_EQ(value, "v3");
+}
+
 TEST_P(OptimisticTransactionTest, SequenceNumberAfterRecoverTest) {
   WriteOptions write_options;
   OptimisticTransactionOptions transaction_options;
@@ -1468,7 +1565,8 @@ TEST_P(OptimisticTransactionTest, TimestampedSnapshotSetCommitTs) {
 INSTANTIATE_TEST_CASE_P(
     InstanceOccGroup, OptimisticTransactionTest,
     testing::Values(OccValidationPolicy::kValidateSerial,
-                    OccValidationPolicy::kValidateParallel));
+                    OccValidationPolicy::kValidateParallel,
+                    OccValidationPolicy::kValidateGroupCommit));
 
 }  // namespace ROCKSDB_NAMESPACE
 
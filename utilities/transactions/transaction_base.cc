@@ -67,9 +67,9 @@ TransactionBaseImpl::TransactionBaseImpl(
       cmp_(GetColumnFamilyUserComparator(db->DefaultColumnFamily())),
       lock_tracker_factory_(lock_tracker_factory),
       start_time_(dbimpl_->GetSystemClock()->NowMicros()),
-      write_batch_(*dbimpl_->mutable_db_options_.wbwi_factory->
-            NewWriteBatchWithIndex(cmp_, true,
-                    write_options.protection_bytes_per_key)),
+      wbwi_factory_(dbimpl_->mutable_db_options_.wbwi_factory),
+      write_batch_(*wbwi_factory_->NewWriteBatchWithIndex(
+          cmp_, true, write_options.protection_bytes_per_key)),
       tracked_locks_(lock_tracker_factory_.Create()),
       commit_time_batch_(0 /* reserved_bytes */, 0 /* max_bytes */,
                          write_options.protection_bytes_per_key,
@@ -85,7 +85,8 @@ TransactionBaseImpl::TransactionBaseImpl(
 TransactionBaseImpl::~TransactionBaseImpl() {
   // Release snapshot if snapshot is set
   SetSnapshotInternal(nullptr);
-  delete &write_batch_; // weired for minimize code change
+  // weired for minimize code change
+  wbwi_factory_->ReleaseWriteBatchWithIndex(&write_batch_);
 }
 
 void TransactionBaseImpl::Clear() {
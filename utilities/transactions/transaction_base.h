@@ -337,6 +337,9 @@ class TransactionBaseImpl : public Transaction {
         : new_locks_(lock_tracker_factory.Create()) {}
   };
 
+  // Created write_batch_, which is released to it
+  std::shared_ptr<WBWIFactory> wbwi_factory_;
+
   // Records writes pending in this transaction
   // topling spec: should use union{ptr,ref}, but ref can not be in union
   WriteBatchWithIndex* write_batch_pre_ = nullptr;
@@ -7,6 +7,7 @@
 
 #include "utilities/transactions/transaction_util.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <string>
 #include <vector>
@@ -46,26 +47,13 @@ Status TransactionUtil::CheckKeyForConflicts(
   return result;
 }
 
-Status TransactionUtil::CheckKey(DBImpl* db_impl, SuperVersion* sv,
-                                 SequenceNumber earliest_seq,
-                                 SequenceNumber snap_seq,
-                                 const LockString& key0,
-                                 const std::string* read_ts,
-                                 bool cache_only, ReadCallback* snap_checker,
-                                 SequenceNumber min_uncommitted) {
-#if !defined(TOPLINGDB_WITH_TIMESTAMP)
-  read_ts = nullptr; // let compiler optimize out null check
-#endif
-
-  // When `min_uncommitted` is provided, keys are not always committed
-  // in sequence number order, and `snap_checker` is used to check whether
-  // specific sequence number is in the database is visible to the transaction.
-  // So `snap_checker` must be provided.
-  assert(min_uncommitted == kMaxSequenceNumber || snap_checker != nullptr);
-
-  const Slice key(key0.data(), key0.size());
+Status TransactionUtil::CheckMemTableHistory(SequenceNumber earliest_seq,
+                                             SequenceNumber snap_seq,
+                                             bool cache_only,
+                                             SequenceNumber min_uncommitted,
+                                             bool* need_to_read_sst) {
   Status result;
-  bool need_to_read_sst = false;
+  *need_to_read_sst = false;
 
   // Since it would be too slow to check the SST files, we will only use
   // the memtables to check whether there have been any recent writes
@@ -77,7 +65,7 @@ Status TransactionUtil::CheckKey(DBImpl* db_impl, SuperVersion* sv,
     // for recent writes.  This error shouldn't happen often in practice as
     // the Memtable should have a valid earliest sequence number except in some
     // corner cases (such as error cases during recovery).
-    need_to_read_sst = true;
+    *need_to_read_sst = true;
 
     if (cache_only) {
       result = Status::TryAgain(
@@ -88,7 +76,7 @@ Status TransactionUtil::CheckKey(DBImpl* db_impl, SuperVersion* sv,
   } else if (snap_seq < earliest_seq || min_uncommitted <= earliest_seq) {
     // Use <= for min_uncommitted since earliest_seq is actually the largest sec
     // before this memtable was created
-    need_to_read_sst = true;
+    *need_to_read_sst = true;
 
     if (cache_only) {
       // The age of this memtable is too new to use to check for recent
@@ -108,6 +96,31 @@ Status TransactionUtil::CheckKey(DBImpl* db_impl, SuperVersion* sv,
     }
   }
 
+  return result;
+}
+
+Status TransactionUtil::CheckKey(DBImpl* db_impl, SuperVersion* sv,
+                                 SequenceNumber earliest_seq,
+                                 SequenceNumber snap_seq,
+                                 const LockString& key0,
+                                 const std::string* read_ts,
+                                 bool cache_only, ReadCallback* snap_checker,
+                                 SequenceNumber min_uncommitted) {
+#if !defined(TOPLINGDB_WITH_TIMESTAMP)
+  read_ts = nullptr; // let compiler optimize out null check
+#endif
+
+  // When `min_uncommitted` is provided, keys are not always committed
+  // in sequence number order, and `snap_checker` is used to check whether
+  // specific sequence number is in the database is visible to the transaction.
+  // So `snap_checker` must be provided.
+  assert(min_uncommitted == kMaxSequenceNumber || snap_checker != nullptr);
+
+  const Slice key(key0.data(), key0.size());
+  bool need_to_read_sst = false;
+  Status result = CheckMemTableHistory(earliest_seq, snap_seq, cache_only,
+                                       min_uncommitted, &need_to_read_sst);
+
   if (result.ok()) {
     SequenceNumber seq = kMaxSequenceNumber;
     std::string timestamp;
@@ -180,18 +193,23 @@ Status TransactionUtil::CheckKeysForConflicts(DBImpl* db_impl,
     std::unique_ptr<LockTracker::KeyIterator> key_it(
         tracker.GetKeyIterator(cf));
     assert(key_it != nullptr);
-    while (key_it->HasNext()) {
-      const auto& key = key_it->Next();
-      PointLockStatus status = tracker.GetPointLockStatus(cf, key);
-      const SequenceNumber key_seq = status.seq;
-
-      // TODO: support timestamp-based conflict checking.
-      // CheckKeysForConflicts() is currently used only by optimistic
-      // transactions.
-      result = CheckKey(db_impl, sv, earliest_seq, key_seq, key,
-                        /*read_ts=*/nullptr, cache_only);
-      if (!result.ok()) {
-        break;
+    if (sv->cfd->user_comparator()->timestamp_size() == 0) {
+      result = CheckKeysForConflictsInBatch(db_impl, sv, earliest_seq, tracker,
+                                            cf, key_it.get(), cache_only);
+    } else {
+      while (key_it->HasNext()) {
+        const auto& key = key_it->Next();
+        PointLockStatus status = tracker.GetPointLockStatus(cf, key);
+        const SequenceNumber key_seq = status.seq;
+
+        // TODO: support timestamp-based conflict checking.
+        // CheckKeysForConflicts() is currently used only by optimistic
+        // transactions.
+        result = CheckKey(db_impl, sv, earliest_seq, key_seq, key,
+                          /*read_ts=*/nullptr, cache_only);
+        if (!result.ok()) {
+          break;
+        }
       }
     }
 
@@ -205,6 +223,75 @@ Status TransactionUtil::CheckKeysForConflicts(DBImpl* db_impl,
   return result;
 }
 
+Status TransactionUtil::CheckKeysForConflictsInBatch(
+    DBImpl* db_impl, SuperVersion* sv, SequenceNumber earliest_seq,
+    const LockTracker& tracker, ColumnFamilyId cf,
+    LockTracker::KeyIterator* key_it, bool cache_only) {
+  std::vector<Slice> keys;
+  std::vector<SequenceNumber> snap_seqs;
+  while (key_it->HasNext()) {
+    const auto& key = key_it->Next();
+    // Tracked keys are owned by the tracker, so the slices stay valid
+    keys.emplace_back(key.data(), key.size());
+    snap_seqs.push_back(tracker.GetPointLockStatus(cf, key).seq);
+  }
+  const size_t num_keys = keys.size();
+
+  // Keys which the memtable history can not vouch for fail fast when
+  // cache_only, the others are split by whether they must read SST files,
+  // then each group is probed in user key order
+  std::vector<size_t> mem_idx, sst_idx;
+  for (size_t i = 0; i < num_keys; i++) {
+    bool need_to_read_sst = false;
+    Status s = CheckMemTableHistory(earliest_seq, snap_seqs[i], cache_only,
+                                    kMaxSequenceNumber, &need_to_read_sst);
+    if (!s.ok()) {
+      return s;
+    }
+    (need_to_read_sst ? sst_idx : mem_idx).push_back(i);
+  }
+  const Comparator* ucmp = sv->cfd->user_comparator();
+  auto by_key = [&](size_t x, size_t y) {
+    return ucmp->Compare(keys[x], keys[y]) < 0;
+  };
+
+  std::vector<Slice> batch_keys;
+  std::vector<SequenceNumber> lower_bounds, seqs;
+  std::unique_ptr<bool[]> found;
+  std::vector<Status> statuses;
+  for (auto* idx : {&mem_idx, &sst_idx}) {
+    const size_t num = idx->size();
+    if (num == 0) {
+      continue;
+    }
+    std::sort(idx->begin(), idx->end(), by_key);
+    batch_keys.resize(num);
+    lower_bounds.resize(num);
+    for (size_t j = 0; j < num; j++) {
+      batch_keys[j] = keys[(*idx)[j]];
+      lower_bounds[j] = snap_seqs[(*idx)[j]];
+    }
+    seqs.resize(num);
+    statuses.resize(num);
+    found.reset(new bool[num]);
+    db_impl->GetLatestSequenceForKeys(
+        sv, num, batch_keys.data(), idx == &mem_idx /* cache_only */,
+        lower_bounds.data(), seqs.data(), found.get(), statuses.data(),
+        ReadOptions().async_queue_depth);
+    for (size_t j = 0; j < num; j++) {
+      const Status& s = statuses[j];
+      if (!(s.ok() || s.IsNotFound() || s.IsMergeInProgress())) {
+        return s;
+      }
+      if (found[j] && lower_bounds[j] < seqs[j]) {
+        return Status::Busy("Write Conflict");
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 #endif  // ROCKSDB_LITE
@@ -50,6 +50,9 @@ class TransactionUtil {
   // will verify there have been no writes to the key in the db since that
   // sequence number.
   //
+  // Keys of a column family are sorted and resolved by one batched pass over
+  // the memtables (and SST files if needed) instead of one probe per key.
+  //
   // Returns OK on success, BUSY if there is a conflicting write, or other error
   // status for any unexpected errors.
   //
@@ -62,6 +65,21 @@ class TransactionUtil {
                                       bool cache_only);
 
  private:
+  // Checks whether the memtable history which starts after `earliest_seq` is
+  // long enough to detect writes after `snap_seq`. If it is not, sets
+  // *need_to_read_sst, and returns TryAgain when cache_only.
+  static Status CheckMemTableHistory(SequenceNumber earliest_seq,
+                                     SequenceNumber snap_seq, bool cache_only,
+                                     SequenceNumber min_uncommitted,
+                                     bool* need_to_read_sst);
+
+  // CheckKeysForConflicts() for all tracked keys of `cf`, whose user
+  // comparator must not have timestamp.
+  static Status CheckKeysForConflictsInBatch(
+      DBImpl* db_impl, SuperVersion* sv, SequenceNumber earliest_seq,
+      const LockTracker& tracker, ColumnFamilyId cf,
+      LockTracker::KeyIterator* key_it, bool cache_only);
+
   // If `snap_checker` == nullptr, writes are always commited in sequence number
   // order. All sequence number <= `snap_seq` will not conflict with any
   // write, and all keys > `snap_seq` of `key` will trigger conflict.
@@ -15,10 +15,13 @@
 #include "db/merge_helper.h"
 #include "memory/arena.h"
 #include "memtable/skiplist.h"
+#include "monitoring/statistics.h"
 #include "options/db_options.h"
 #include "rocksdb/comparator.h"
 #include "rocksdb/iterator.h"
 #include "util/cast_util.h"
+#include "util/core_local.h"
+#include "util/mutexlock.h"
 #include "util/string_util.h"
 #include "utilities/write_batch_with_index/write_batch_with_index_internal.h"
 
@@ -74,7 +77,8 @@ struct WriteBatchWithIndex::Rep {
 
   // Clear all updates buffered in this batch.
   void Clear();
-  void ClearIndex();
+  // Keeps up to max_retained_bytes of the arena for the next entries
+  void ClearIndex(size_t max_retained_bytes = 0);
 
   // Rebuild index by reading all records from the batch.
   // Returns non-ok status on corruption.
@@ -174,10 +178,9 @@ void WriteBatchWithIndex::Rep::Clear() {
   ClearIndex();
 }
 
-void WriteBatchWithIndex::Rep::ClearIndex() {
+void WriteBatchWithIndex::Rep::ClearIndex(size_t max_retained_bytes) {
   skip_list.~WriteBatchEntrySkipList();
-  arena.~Arena();
-  new (&arena) Arena();
+  arena.Reset(max_retained_bytes);
   new (&skip_list) WriteBatchEntrySkipList(comparator, &arena);
   last_entry_offset = 0;
   last_sub_batch_offset = 0;
@@ -430,6 +433,23 @@ Status WriteBatchWithIndex::PutLogData(const Slice& blob) {
 
 void WriteBatchWithIndex::Clear() { rep->Clear(); }
 
+bool WriteBatchWithIndex::Recycle(size_t max_retained_bytes) {
+  if (!rep) {
+    return false;  // a derived class not supporting it
+  }
+  rep->write_batch.Clear();
+  // the next taker may not set a limit, see SetMaxBytes()
+  rep->write_batch.SetMaxBytes(0);
+  rep->comparator.ClearComparatorsForCF();
+  rep->ClearIndex(max_retained_bytes);
+  return true;
+}
+
+bool WriteBatchWithIndex::IsOverwriteKey() const {
+  assert(rep);
+  return rep->overwrite_key;
+}
+
 Status WriteBatchWithIndex::GetFromBatch(ColumnFamilyHandle* column_family,
                                          const DBOptions& options,
                                          const Slice& key, std::string* value) {
@@ -781,6 +801,9 @@ const Comparator* WriteBatchWithIndexInternal::GetUserComparator(
 WBWIFactory::~WBWIFactory() {
   // do nothing
 }
+void WBWIFactory::ReleaseWriteBatchWithIndex(WriteBatchWithIndex* wbwi) {
+  delete wbwi;
+}
 class SkipListWBWIFactory : public WBWIFactory {
 public:
   const char* Name() const noexcept final { return "SkipList"; }
@@ -795,5 +818,85 @@ std::shared_ptr<WBWIFactory> SingleSkipListWBWIFactory() {
   return fac;
 }
 
+class PooledWBWIFactory : public WBWIFactory {
+public:
+  explicit PooledWBWIFactory(const PooledWBWIFactoryOptions& opts)
+      : opts_(opts) {
+    if (!opts_.base) {
+      opts_.base = SingleSkipListWBWIFactory();
+    }
+  }
+  ~PooledWBWIFactory() override {
+    for (size_t i = 0; i < pools_.Size(); i++) {
+      for (auto& e : pools_.AccessAtCore(i)->batches) {
+        opts_.base->ReleaseWriteBatchWithIndex(e.wbwi);
+      }
+    }
+  }
+  const char* Name() const noexcept final { return "Pooled"; }
+  WriteBatchWithIndex* NewWriteBatchWithIndex(
+      const Comparator* default_comparator, bool overwrite_key,
+      size_t prot) final {
+    Pool* pool = pools_.Access();
+    {
+      std::lock_guard<SpinMutex> lock(pool->mutex);
+      auto& batches = pool->batches;
+      for (size_t i = batches.size(); i-- > 0;) {
+        if (batches[i].comparator == default_comparator &&
+            batches[i].overwrite_key == overwrite_key &&
+            batches[i].protection_bytes_per_key == prot) {
+          WriteBatchWithIndex* wbwi = batches[i].wbwi;
+          batches[i] = batches.back();
+          batches.pop_back();
+          RecordTick(opts_.statistics.get(), WBWI_POOL_HIT);
+          return wbwi;
+        }
+      }
+    }
+    RecordTick(opts_.statistics.get(), WBWI_POOL_MISS);
+    return opts_.base->NewWriteBatchWithIndex(default_comparator,
+                                              overwrite_key, prot);
+  }
+  void ReleaseWriteBatchWithIndex(WriteBatchWithIndex* wbwi) final {
+    if (!wbwi->Recycle(opts_.max_retained_bytes)) {
+      opts_.base->ReleaseWriteBatchWithIndex(wbwi);
+      return;
+    }
+    Entry e;
+    e.wbwi = wbwi;
+    e.comparator = wbwi->GetUserComparator(0);
+    e.overwrite_key = wbwi->IsOverwriteKey();
+    e.protection_bytes_per_key =
+        wbwi->GetWriteBatch()->GetProtectionBytesPerKey();
+    Pool* pool = pools_.Access();
+    {
+      std::lock_guard<SpinMutex> lock(pool->mutex);
+      if (pool->batches.size() < opts_.max_pooled_per_core) {
+        pool->batches.push_back(e);
+        return;
+      }
+    }
+    opts_.base->ReleaseWriteBatchWithIndex(wbwi);
+  }
+
+private:
+  struct Entry {
+    WriteBatchWithIndex* wbwi;
+    const Comparator* comparator;
+    bool overwrite_key;
+    size_t protection_bytes_per_key;
+  };
+  struct alignas(CACHE_LINE_SIZE) Pool {
+    SpinMutex mutex;
+    std::vector<Entry> batches;
+  };
+  PooledWBWIFactoryOptions opts_;
+  CoreLocalArray<Pool> pools_;
+};
+std::shared_ptr<WBWIFactory> NewPooledWBWIFactory(
+    const PooledWBWIFactoryOptions& opts) {
+  return std::make_shared<PooledWBWIFactory>(opts);
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 #endif  // !ROCKSDB_LITE
@@ -174,6 +174,8 @@ class WriteBatchEntryComparator {
     cf_comparators_[column_family_id] = comparator;
   }
 
+  void ClearComparatorsForCF() { cf_comparators_.clear(); }
+
   const Comparator* default_comparator() { return default_comparator_; }
 
   const Comparator* GetComparator(
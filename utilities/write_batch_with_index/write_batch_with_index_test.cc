@@ -2416,6 +2416,102 @@ TEST_P(WriteBatchWithIndexTest, IndexNoTs) {
   }
 }
 
+TEST_F(WBWIOverwriteTest, PooledFactory) {
+  bool recyclable;
+  {
+    std::unique_ptr<WriteBatchWithIndex> probe(
+        g_fac->NewWriteBatchWithIndex(BytewiseComparator(), true));
+    recyclable = probe->Recycle(0);
+  }
+  PooledWBWIFactoryOptions pool_opts;
+  pool_opts.base = g_fac;
+  pool_opts.statistics = CreateDBStatistics();
+  auto fac = NewPooledWBWIFactory(pool_opts);
+  ColumnFamilyHandleImplDummy cf1(1, ReverseBytewiseComparator_p);
+
+  WriteBatchWithIndex* wbwi = fac->NewWriteBatchWithIndex(
+      BytewiseComparator(), true);
+  for (int i = 0; i < 1000; i++) {
+    ASSERT_OK(wbwi->Put("k" + std::to_string(i), "v"));
+  }
+  ASSERT_OK(wbwi->Put(&cf1, "a", "v"));
+  // like the max_write_batch_size of a PessimisticTransaction
+  wbwi->SetMaxBytes(1 << 10);
+  fac->ReleaseWriteBatchWithIndex(wbwi);
+  if (!recyclable) {
+    // Released to the base factory instead of the pool
+    WriteBatchWithIndex* other = fac->NewWriteBatchWithIndex(
+        BytewiseComparator(), true);
+    ASSERT_EQ(other->GetWriteBatch()->Count(), 0u);
+    ASSERT_EQ(pool_opts.statistics->getTickerCount(WBWI_POOL_HIT), 0u);
+    ASSERT_EQ(pool_opts.statistics->getTickerCount(WBWI_POOL_MISS), 2u);
+    fac->ReleaseWriteBatchWithIndex(other);
+    return;
+  }
+
+  // Only reused with the same arguments
+  WriteBatchWithIndex* other = fac->NewWriteBatchWithIndex(
+      BytewiseComparator(), false);
+  ASSERT_NE(other, wbwi);
+  WriteBatchWithIndex* reused = fac->NewWriteBatchWithIndex(
+      BytewiseComparator(), true);
+  ASSERT_EQ(reused, wbwi);
+  ASSERT_EQ(pool_opts.statistics->getTickerCount(WBWI_POOL_HIT), 1u);
+  ASSERT_EQ(pool_opts.statistics->getTickerCount(WBWI_POOL_MISS), 2u);
+
+  // It is empty and forgot the comparator of cf1
+  ASSERT_EQ(reused->GetWriteBatch()->Count(), 0u);
+  ASSERT_EQ(reused->GetUserComparator(1), BytewiseComparator());
+  std::string value;
+  ASSERT_TRUE(reused->GetFromBatch(options_, "k1", &value).IsNotFound());
+  ASSERT_OK(reused->Put("k1", "v1"));
+  ASSERT_OK(reused->GetFromBatch(options_, "k1", &value));
+  ASSERT_EQ(value, "v1");
+  // and the size limit of its previous user
+  ASSERT_OK(reused->Put("k2", std::string(4 << 10, 'v')));
+
+  fac->ReleaseWriteBatchWithIndex(reused);
+  fac->ReleaseWriteBatchWithIndex(other);
+}
+
+TEST_F(WBWIOverwriteTest, PooledFactoryDerivedWBWI) {
+  // A derived WBWI with an index of its own, which does not support Recycle()
+  class OwnIndexWBWI : public WriteBatchWithIndex {
+   public:
+    explicit OwnIndexWBWI(int* num_deleted)
+        : WriteBatchWithIndex(Slice()), num_deleted_(num_deleted) {}
+    ~OwnIndexWBWI() override { (*num_deleted_)++; }
+
+   private:
+    int* num_deleted_;
+  };
+  class OwnIndexWBWIFactory : public WBWIFactory {
+   public:
+    const char* Name() const noexcept override { return "OwnIndex"; }
+    WriteBatchWithIndex* NewWriteBatchWithIndex(const Comparator*, bool,
+                                                size_t) override {
+      return new OwnIndexWBWI(&num_deleted);
+    }
+    int num_deleted = 0;
+  };
+  auto base = std::make_shared<OwnIndexWBWIFactory>();
+  PooledWBWIFactoryOptions pool_opts;
+  pool_opts.base = base;
+  pool_opts.statistics = CreateDBStatistics();
+  auto fac = NewPooledWBWIFactory(pool_opts);
+
+  WriteBatchWithIndex* wbwi = fac->NewWriteBatchWithIndex();
+  ASSERT_FALSE(wbwi->Recycle(pool_opts.max_retained_bytes));
+  fac->ReleaseWriteBatchWithIndex(wbwi);
+  ASSERT_EQ(base->num_deleted, 1);
+
+  wbwi = fac->NewWriteBatchWithIndex();
+  fac->ReleaseWriteBatchWithIndex(wbwi);
+  ASSERT_EQ(base->num_deleted, 2);
+  ASSERT_EQ(pool_opts.statistics->getTickerCount(WBWI_POOL_HIT), 0u);
+  ASSERT_EQ(pool_opts.statistics->getTickerCount(WBWI_POOL_MISS), 2u);
+}
+
 INSTANTIATE_TEST_CASE_P(WBWI, WriteBatchWithIndexTest, testing::Bool());
 }  // namespace ROCKSDB_NAMESPACE
 